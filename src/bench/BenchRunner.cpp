@@ -0,0 +1,170 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "BenchRunner.h"
+
+#include <numeric>
+#include <random>
+
+namespace GpgFrontend::Bench {
+
+namespace {
+
+constexpr qint64 kPayloadFileChunk = 16 * 1024 * 1024;
+
+}  // namespace
+
+BenchRunner::BenchRunner(int iterations)
+    : iterations_(std::max(1, iterations)) {}
+
+auto BenchRunner::Measure(const QString& group, const QString& name,
+                          const QJsonObject& params, qint64 bytes,
+                          const Runnable& runnable, int iterations) -> bool {
+  if (iterations <= 0) iterations = iterations_;
+
+  LOG_I() << "running benchmark:" << group << name << params;
+
+  QJsonObject result;
+  result["group"] = group;
+  result["name"] = name;
+  result["params"] = params;
+
+  // the warmup run fills the caches of gpgme, the agent and the file system
+  auto succeed = runnable();
+
+  QList<double> samples;
+  QElapsedTimer timer;
+  for (int i = 0; succeed && i < iterations; i++) {
+    timer.start();
+    succeed = runnable();
+    samples.append(static_cast<double>(timer.nsecsElapsed()) / 1e6);
+  }
+
+  result["succeed"] = succeed;
+  if (!succeed) {
+    LOG_W() << "benchmark failed:" << group << name << params;
+    failures_++;
+    results_.append(result);
+    return false;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  const auto mean =
+      std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+  const auto median = samples.size() % 2 == 1
+                          ? samples[samples.size() / 2]
+                          : (samples[(samples.size() / 2) - 1] +
+                             samples[samples.size() / 2]) /
+                                2;
+
+  QJsonArray samples_array;
+  for (const auto sample : samples) samples_array.append(sample);
+
+  result["iterations"] = iterations;
+  result["min_ms"] = samples.front();
+  result["max_ms"] = samples.back();
+  result["mean_ms"] = mean;
+  result["median_ms"] = median;
+  result["samples_ms"] = samples_array;
+
+  if (bytes > 0) {
+    result["bytes"] = bytes;
+    result["median_mib_per_s"] =
+        (static_cast<double>(bytes) / (1024.0 * 1024.0)) / (median / 1000.0);
+  }
+
+  LOG_I() << "benchmark result:" << group << name << "median:" << median
+          << "ms";
+  results_.append(result);
+  return true;
+}
+
+auto BenchRunner::Results() const -> QJsonArray { return results_; }
+
+auto BenchRunner::Failures() const -> int { return failures_; }
+
+auto GeneratePayload(qint64 size, quint32 seed) -> QByteArray {
+  QByteArray payload(size, Qt::Uninitialized);
+
+  std::mt19937 generator(seed);
+  auto* data = payload.data();
+  qint64 i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto value = static_cast<quint32>(generator());
+    memcpy(data + i, &value, 4);
+  }
+  for (; i < size; i++) data[i] = static_cast<char>(generator());
+
+  return payload;
+}
+
+auto WritePayloadFile(const QString& path, qint64 size) -> bool {
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+  const auto chunk = GeneratePayload(std::min(size, kPayloadFileChunk));
+  for (qint64 written = 0; written < size;) {
+    const auto length = std::min<qint64>(chunk.size(), size - written);
+    if (file.write(chunk.constData(), length) != length) return false;
+    written += length;
+  }
+  return true;
+}
+
+auto PayloadSizes(qint64 max, qint64 min) -> QList<qint64> {
+  QList<qint64> sizes;
+  for (qint64 size = min; size <= max; size *= 16) sizes.append(size);
+  if (sizes.isEmpty() || sizes.back() != max) sizes.append(max);
+  return sizes;
+}
+
+auto KeyCounts(int max) -> QList<int> {
+  QList<int> counts;
+  for (int count = 1000; count <= max; count *= 10) counts.append(count);
+  if (counts.isEmpty() || counts.back() != max) counts.append(max);
+  return counts;
+}
+
+auto WaitForOpera(const std::function<void(const GpgOperationCallback&)>& start)
+    -> GpgError {
+  QEventLoop looper;
+  auto done = false;
+  GpgError opera_err = GPG_ERR_NO_ERROR;
+
+  // the callback of a task arrives at the thread which posted it
+  start([&](GpgError err, const DataObjectPtr&) {
+    opera_err = err;
+    done = true;
+    looper.quit();
+  });
+
+  if (!done) looper.exec();
+  return opera_err;
+}
+
+}  // namespace GpgFrontend::Bench
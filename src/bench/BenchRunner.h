@@ -0,0 +1,162 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include "bench/GpgFrontendBench.h"
+#include "core/model/GpgKey.h"
+#include "core/typedef/GpgTypedef.h"
+
+namespace GpgFrontend::Bench {
+
+/**
+ * @brief the state shared by all benchmark cases
+ *
+ */
+struct BenchEnvironment {
+  GpgFrontendBenchContext args;  ///<
+  int channel;                   ///< gpg context holding the bench key
+  int keyring_channel;           ///< gpg context of the synthetic keyrings
+  QString work_dir;              ///< scratch directory of file benchmarks
+  GpgKey key;                    ///< ed25519/cv25519 key without passphrase
+};
+
+/**
+ * @brief times benchmark cases and collects their results as json
+ *
+ */
+class BenchRunner {
+ public:
+  using Runnable = std::function<bool()>;
+
+  /**
+   * @brief Construct a new Bench Runner object
+   *
+   * @param iterations measured runs of each case by default
+   */
+  explicit BenchRunner(int iterations);
+
+  /**
+   * @brief run the runnable once as a warmup, then time it for the given
+   * iterations (the default ones if zero) and record the result.
+   *
+   * @param group e.g. basic_opera
+   * @param name e.g. encrypt
+   * @param params parameters of the case, like the payload size
+   * @param bytes processed by each run, enables the throughput, may be zero
+   * @param runnable returns false on failure
+   * @return false if any of the runs failed
+   */
+  auto Measure(const QString& group, const QString& name,
+               const QJsonObject& params, qint64 bytes,
+               const Runnable& runnable, int iterations = 0) -> bool;
+
+  /**
+   * @brief
+   *
+   * @return QJsonArray
+   */
+  [[nodiscard]] auto Results() const -> QJsonArray;
+
+  /**
+   * @brief
+   *
+   * @return int number of the failed cases
+   */
+  [[nodiscard]] auto Failures() const -> int;
+
+ private:
+  int iterations_;
+  QJsonArray results_;
+  int failures_ = 0;
+};
+
+/**
+ * @brief deterministic incompressible payload, the same seed always yields
+ * the same bytes so the runs are comparable.
+ *
+ * @param size
+ * @param seed
+ * @return QByteArray
+ */
+auto GeneratePayload(qint64 size, quint32 seed = 0x47464252) -> QByteArray;
+
+/**
+ * @brief write a file of GeneratePayload() chunks, so multi-GB files never
+ * have to fit in memory.
+ *
+ * @param path
+ * @param size
+ * @return true on success
+ */
+auto WritePayloadFile(const QString& path, qint64 size) -> bool;
+
+/**
+ * @brief 1 KiB, 16 KiB, 256 KiB ... up to max, or min, 16 min ... if given
+ *
+ * @param max
+ * @param min
+ * @return QList<qint64>
+ */
+auto PayloadSizes(qint64 max, qint64 min = 1024) -> QList<qint64>;
+
+/**
+ * @brief 1k, 10k, 100k ... up to max
+ *
+ * @param max
+ * @return QList<int>
+ */
+auto KeyCounts(int max) -> QList<int>;
+
+/**
+ * @brief start an asynchronous operation and spin an event loop until its
+ * callback arrives.
+ *
+ * @param start
+ * @return GpgError
+ */
+auto WaitForOpera(const std::function<void(const GpgOperationCallback&)>& start)
+    -> GpgError;
+
+// the benchmark cases, run in this order
+
+void BenchBasicOpera(BenchRunner&, const BenchEnvironment&);
+
+void BenchFileOpera(BenchRunner&, const BenchEnvironment&);
+
+void BenchFileDigest(BenchRunner&, const BenchEnvironment&);
+
+void BenchDataExchanger(BenchRunner&, const BenchEnvironment&);
+
+void BenchDataObjectCipher(BenchRunner&, const BenchEnvironment&);
+
+void BenchKeyCache(BenchRunner&, const BenchEnvironment&);
+
+void BenchKeyTableProxyModel(BenchRunner&, const BenchEnvironment&);
+
+}  // namespace GpgFrontend::Bench
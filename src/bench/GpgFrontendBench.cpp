@@ -0,0 +1,183 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "GpgFrontendBench.h"
+
+#include "bench/BenchRunner.h"
+#include "core/GpgConstants.h"
+#include "core/function/basic/ChannelObject.h"
+#include "core/function/gpg/GpgContext.h"
+#include "core/function/gpg/GpgKeyGetter.h"
+#include "core/function/gpg/GpgKeyOpera.h"
+#include "core/model/GpgGenerateKeyResult.h"
+#include "core/model/GpgKeyGenerateInfo.h"
+#include "core/module/ModuleManager.h"
+#include "core/typedef/GpgTypedef.h"
+#include "core/utils/BuildInfoUtils.h"
+#include "core/utils/GpgUtils.h"
+
+Q_LOGGING_CATEGORY(bench, "bench")
+
+namespace GpgFrontend::Bench {
+
+constexpr int kBenchKeyringChannel = kGpgFrontendDefaultChannel + 1;
+
+auto ConfigureGpgContext(int channel, const QString& db_path) -> bool {
+  GpgContext::CreateInstance(channel, [=]() -> ChannelObjectPtr {
+    GpgContextInitArgs args;
+    args.test_mode = true;
+    args.offline_mode = true;
+    args.db_path = db_path;
+
+    return ConvertToChannelObjectPtr<>(
+        SecureCreateUniqueObject<GpgContext>(args, channel));
+  });
+
+  return GpgContext::GetInstance(channel).Good();
+}
+
+auto GenerateBenchKey(int channel) -> GpgKey {
+  auto p_info = QSharedPointer<KeyGenerateInfo>::create();
+  p_info->SetName("GpgFrontend Bench");
+  p_info->SetEmail("bench@gpgfrontend.bktus.com");
+  auto [p_found, p_algo] = KeyGenerateInfo::SearchPrimaryKeyAlgo("ed25519");
+  p_info->SetAlgo(p_algo);
+  p_info->SetNonExpired(true);
+  p_info->SetNonPassPhrase(true);
+
+  auto s_info = QSharedPointer<KeyGenerateInfo>::create(true);
+  auto [s_found, s_algo] = KeyGenerateInfo::SearchSubKeyAlgo("cv25519");
+  s_info->SetAlgo(s_algo);
+  s_info->SetNonExpired(true);
+  s_info->SetNonPassPhrase(true);
+
+  if (!p_found || !s_found) return {};
+
+  auto [err, data_object] =
+      GpgKeyOpera::GetInstance(channel).GenerateKeyWithSubkeySync(p_info,
+                                                                  s_info);
+  if (CheckGpgError(err) != GPG_ERR_NO_ERROR ||
+      !data_object->Check<GpgGenerateKeyResult>()) {
+    return {};
+  }
+
+  auto result = ExtractParams<GpgGenerateKeyResult>(data_object, 0);
+  GpgKeyGetter::GetInstance(channel).FlushKeyCache();
+  return GpgKeyGetter::GetInstance(channel).GetKey(result.GetFingerprint());
+}
+
+auto BuildReport(const BenchEnvironment& env, const BenchRunner& runner)
+    -> QJsonObject {
+  QJsonObject environment;
+  environment["version"] = GetProjectBuildVersion();
+  environment["git_commit"] = GetProjectBuildGitCommitHash();
+  environment["qt_version"] = GetProjectQtVersion();
+  environment["gpgme_version"] = GetProjectGpgMEVersion();
+  environment["gnupg_version"] = Module::RetrieveRTValueTypedOrDefault<>(
+      "core", "gpgme.ctx.gnupg_version", QString{});
+  environment["os"] = QSysInfo::prettyProductName();
+  environment["kernel"] = QSysInfo::kernelVersion();
+  environment["cpu_arch"] = QSysInfo::currentCpuArchitecture();
+  environment["cpu_threads"] = QThread::idealThreadCount();
+
+  QJsonObject config;
+  config["iterations"] = env.args.iterations;
+  config["max_payload_size"] = env.args.max_payload_size;
+  config["max_keys"] = env.args.max_keys;
+  config["max_digest_size"] = env.args.max_digest_size;
+  config["max_gpg_data_size"] = env.args.max_gpg_data_size;
+
+  QJsonObject report;
+  report["timestamp"] =
+      QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+  report["environment"] = environment;
+  report["config"] = config;
+  report["results"] = runner.Results();
+  return report;
+}
+
+auto WriteReport(const QString& path, const QJsonObject& report) -> bool {
+  const auto json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+  if (path.isEmpty() || path == "-") {
+    QTextStream(stdout) << json;
+    return true;
+  }
+
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    LOG_W() << "cannot open benchmark report file:" << path;
+    return false;
+  }
+  return file.write(json) == json.size();
+}
+
+auto ExecuteAllBenchmarks(GpgFrontendBenchContext args) -> int {
+  // every run starts from empty keyrings, which are removed afterwards
+  QTemporaryDir gnupg_home;
+  QTemporaryDir keyring_home;
+  QTemporaryDir work_dir;
+  if (!gnupg_home.isValid() || !keyring_home.isValid() ||
+      !work_dir.isValid()) {
+    LOG_W() << "cannot create temporary directories for benchmarks";
+    return -1;
+  }
+
+  if (!ConfigureGpgContext(kGpgFrontendDefaultChannel, gnupg_home.path()) ||
+      !ConfigureGpgContext(kBenchKeyringChannel, keyring_home.path())) {
+    LOG_W() << "cannot set up gpg contexts for benchmarks";
+    return -1;
+  }
+
+  BenchEnvironment env;
+  env.args = args;
+  env.channel = kGpgFrontendDefaultChannel;
+  env.keyring_channel = kBenchKeyringChannel;
+  env.work_dir = work_dir.path();
+  env.key = GenerateBenchKey(env.channel);
+  if (!env.key.IsGood()) {
+    LOG_W() << "cannot generate the key for benchmarks";
+    return -1;
+  }
+
+  BenchRunner runner(args.iterations);
+  BenchBasicOpera(runner, env);
+  BenchFileOpera(runner, env);
+  BenchFileDigest(runner, env);
+  BenchDataExchanger(runner, env);
+  BenchDataObjectCipher(runner, env);
+  BenchKeyCache(runner, env);
+  BenchKeyTableProxyModel(runner, env);
+
+  if (!WriteReport(args.output_path, BuildReport(env, runner))) return -1;
+
+  LOG_I() << "benchmarks finished, failures:" << runner.Failures();
+  return runner.Failures() == 0 ? 0 : 1;
+}
+
+}  // namespace GpgFrontend::Bench
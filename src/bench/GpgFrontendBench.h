@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+// project base header
+#include "GpgFrontend.h"
+
+// symbol exports header
+#include "bench/GpgFrontendBenchExport.h"
+
+// private declare area of bench
+#ifdef GF_BENCH_PRIVATE
+
+// declare logging category
+Q_DECLARE_LOGGING_CATEGORY(bench)
+
+#define LOG_D() qCDebug(bench)
+#define LOG_I() qCInfo(bench)
+#define LOG_W() qCWarning(bench)
+#define LOG_E() qCCritical(bench)
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+#define LOG_F(...) qCFatal(bench)
+#else
+#define LOG_F(...) qFatal()
+#endif
+
+#define FLOG_D(...) qCDebug(bench, __VA_ARGS__)
+#define FLOG_I(...) qCInfo(bench, __VA_ARGS__)
+#define FLOG_W(...) qCWarning(bench, __VA_ARGS__)
+#define FLOG_E(...) qCCritical(bench, __VA_ARGS__)
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+#define FLOG_F(...) qCFatal(bench, __VA_ARGS__)
+#else
+#define FLOG_F(...) qFatal(__VA_ARGS__)
+#endif
+
+#endif
+
+namespace GpgFrontend::Bench {
+
+struct GpgFrontendBenchContext {
+  QString output_path;                         ///< json report, "-" for stdout
+  qint64 max_payload_size = 16 * 1024 * 1024;  ///< largest payload in bytes
+  int max_keys = 1000;                         ///< largest synthetic keyring
+  int iterations = 5;                          ///< measured runs of each case
+  qint64 max_digest_size = 1LL << 31;          ///< 2 GiB file to hash
+  qint64 max_gpg_data_size = 1LL << 30;        ///< largest gpg data file
+};
+
+/**
+ * @brief run all benchmarks in a throwaway GNUPGHOME and write the results
+ * as json.
+ *
+ * @param args
+ * @return int 0 if all benchmarks succeeded
+ */
+auto GPGFRONTEND_BENCH_EXPORT ExecuteAllBenchmarks(GpgFrontendBenchContext args)
+    -> int;
+
+}  // namespace GpgFrontend::Bench
@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "bench/BenchRunner.h"
+#include "core/function/gpg/GpgBasicOperator.h"
+#include "core/model/GpgDecryptResult.h"
+#include "core/model/GpgEncryptResult.h"
+#include "core/model/GpgSignResult.h"
+#include "core/model/GpgVerifyResult.h"
+#include "core/utils/GpgUtils.h"
+
+namespace GpgFrontend::Bench {
+
+void BenchBasicOpera(BenchRunner& runner, const BenchEnvironment& env) {
+  auto& opera = GpgBasicOperator::GetInstance(env.channel);
+  const KeyArgsList keys{env.key};
+
+  for (const auto size : PayloadSizes(env.args.max_payload_size)) {
+    const auto in_buffer = GFBuffer(GeneratePayload(size));
+    const QJsonObject params{{"size", size}};
+
+    GFBuffer encrypted;
+    runner.Measure("basic_opera", "encrypt", params, size, [&]() {
+      auto [err, data_object] = opera.EncryptSync(keys, in_buffer, false);
+      if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+      encrypted = ExtractParams<GFBuffer>(data_object, 1);
+      return true;
+    });
+
+    runner.Measure("basic_opera", "decrypt", params, size, [&]() {
+      auto [err, data_object] = opera.DecryptSync(encrypted);
+      return CheckGpgError(err) == GPG_ERR_NO_ERROR &&
+             static_cast<qint64>(
+                 ExtractParams<GFBuffer>(data_object, 1).Size()) == size;
+    });
+
+    GFBuffer signature;
+    runner.Measure("basic_opera", "sign_detach", params, size, [&]() {
+      auto [err, data_object] =
+          opera.SignSync(keys, in_buffer, GPGME_SIG_MODE_DETACH, false);
+      if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+      signature = ExtractParams<GFBuffer>(data_object, 1);
+      return true;
+    });
+
+    runner.Measure("basic_opera", "verify_detach", params, size, [&]() {
+      auto [err, data_object] = opera.VerifySync(in_buffer, signature);
+      return CheckGpgError(err) == GPG_ERR_NO_ERROR;
+    });
+
+    GFBuffer encrypted_signed;
+    runner.Measure("basic_opera", "encrypt_sign", params, size, [&]() {
+      auto [err, data_object] =
+          opera.EncryptSignSync(keys, keys, in_buffer, false);
+      if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+      encrypted_signed = ExtractParams<GFBuffer>(data_object, 2);
+      return true;
+    });
+
+    runner.Measure("basic_opera", "decrypt_verify", params, size, [&]() {
+      auto [err, data_object] = opera.DecryptVerifySync(encrypted_signed);
+      return CheckGpgError(err) == GPG_ERR_NO_ERROR;
+    });
+  }
+}
+
+}  // namespace GpgFrontend::Bench
@@ -0,0 +1,176 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <queue>
+#include <thread>
+
+#include "bench/BenchRunner.h"
+#include "core/model/GFDataExchanger.h"
+
+namespace GpgFrontend::Bench {
+
+namespace {
+
+/**
+ * @brief the byte-at-a-time queue GFDataExchanger used before the ring
+ * buffer, kept here only as the baseline of the comparison.
+ *
+ */
+class ByteQueueExchanger {
+ public:
+  explicit ByteQueueExchanger(size_t size) : queue_max_size_(size) {}
+
+  auto Write(const std::byte* buffer, size_t size) -> ssize_t {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < size; i++) {
+      if (queue_.size() == queue_max_size_) not_empty_.notify_all();
+      not_full_.wait(lock,
+                     [=] { return queue_.size() < queue_max_size_ || close_; });
+      if (close_) return -1;
+      queue_.push(buffer[i]);
+    }
+    not_empty_.notify_all();
+    return static_cast<ssize_t>(size);
+  }
+
+  auto Read(std::byte* buffer, size_t size) -> ssize_t {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (close_ && queue_.empty()) return 0;
+
+    size_t i = 0;
+    for (; i < size; ++i) {
+      if (queue_.empty()) not_full_.notify_all();
+      not_empty_.wait(lock, [=] { return !queue_.empty() || close_; });
+      if (queue_.empty()) break;
+      buffer[i] = queue_.front();
+      queue_.pop();
+    }
+    not_full_.notify_all();
+    return static_cast<ssize_t>(i);
+  }
+
+  void CloseWrite() {
+    std::unique_lock<std::mutex> const lock(mutex_);
+    close_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  std::condition_variable not_full_, not_empty_;
+  std::queue<std::byte> queue_;
+  std::mutex mutex_;
+  const size_t queue_max_size_;
+  bool close_ = false;
+};
+
+template <typename Exchanger>
+auto PumpCopying(Exchanger& ex, qint64 total, size_t chunk_size) -> bool {
+  std::thread producer([&]() {
+    std::vector<std::byte> chunk(chunk_size, std::byte{0x47});
+    for (qint64 written = 0; written < total;) {
+      const auto size = static_cast<size_t>(
+          std::min<qint64>(static_cast<qint64>(chunk_size), total - written));
+      if (ex.Write(chunk.data(), size) < 0) break;
+      written += static_cast<qint64>(size);
+    }
+    ex.CloseWrite();
+  });
+
+  std::vector<std::byte> chunk(chunk_size);
+  qint64 received = 0;
+  ssize_t len;
+  while ((len = ex.Read(chunk.data(), chunk.size())) > 0) received += len;
+
+  producer.join();
+  return received == total;
+}
+
+auto PumpZeroCopy(qint64 total, size_t chunk_size) -> bool {
+  auto ex = CreateStandardGFDataExchanger();
+
+  std::thread producer([=]() {
+    for (qint64 written = 0; written < total;) {
+      const auto size = static_cast<size_t>(
+          std::min<qint64>(static_cast<qint64>(chunk_size), total - written));
+      auto region = ex->ReserveWrite(size);
+      if (region.size == 0) break;
+      memset(region.data, 0x47, region.size);
+      ex->CommitWrite(region.size);
+      written += static_cast<qint64>(region.size);
+    }
+    ex->CloseWrite();
+  });
+
+  qint64 received = 0;
+  for (;;) {
+    auto region = ex->BorrowReadRegion(chunk_size);
+    if (region.size == 0) break;
+    received += static_cast<qint64>(region.size);
+    ex->ReleaseReadRegion(region.size);
+  }
+
+  producer.join();
+  return received == total;
+}
+
+}  // namespace
+
+void BenchDataExchanger(BenchRunner& runner, const BenchEnvironment& env) {
+  // several rounds of the ring buffer, so the wrap around is covered
+  const auto total =
+      std::max<qint64>(env.args.max_payload_size * 4, kDataExchangerSize * 2);
+
+  for (const size_t chunk_size : {4 * 1024, 64 * 1024, 1024 * 1024}) {
+    const QJsonObject params{{"total", total},
+                             {"chunk_size", static_cast<qint64>(chunk_size)}};
+
+    runner.Measure("data_exchanger", "read_write", params, total, [&]() {
+      auto ex = CreateStandardGFDataExchanger();
+      return PumpCopying(*ex, total, chunk_size);
+    });
+
+    runner.Measure("data_exchanger", "borrow_reserve", params, total,
+                   [&]() { return PumpZeroCopy(total, chunk_size); });
+  }
+
+  // the byte queue moves one byte per lock round trip, keep it to one
+  // payload and one chunk size
+  const auto baseline_total = env.args.max_payload_size;
+  const size_t baseline_chunk_size = 64 * 1024;
+  runner.Measure(
+      "data_exchanger", "byte_queue_read_write",
+      QJsonObject{{"total", baseline_total},
+                  {"chunk_size", static_cast<qint64>(baseline_chunk_size)}},
+      baseline_total, [&]() {
+        ByteQueueExchanger ex(kDataExchangerSize);
+        return PumpCopying(ex, baseline_total, baseline_chunk_size);
+      });
+}
+
+}  // namespace GpgFrontend::Bench
@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "bench/BenchRunner.h"
+#include "core/function/DataObjectCipher.h"
+
+namespace GpgFrontend::Bench {
+
+namespace {
+
+// every run handles a single object, so the samples are per object latency
+constexpr int kBenchObjectRuns = 200;
+
+const QList<qint64> kBenchObjectSizes{256, 4 * 1024, 64 * 1024};
+
+void BenchCipher(BenchRunner& runner, const QString& name,
+                 const DataObjectCipher& cipher) {
+  const auto aad = QByteArray("bench data object");
+
+  for (const auto size : kBenchObjectSizes) {
+    // data objects are json, text also never looks like the iso padding
+    const auto plaintext = GeneratePayload(size).toBase64().left(size);
+    const auto encrypted = cipher.Encrypt(plaintext, aad);
+
+    const QJsonObject params{{"cipher", name}, {"size", size}};
+
+    runner.Measure(
+        "data_object_cipher", "encrypt", params, size,
+        [&]() { return !cipher.Encrypt(plaintext, aad).isEmpty(); },
+        kBenchObjectRuns);
+
+    runner.Measure(
+        "data_object_cipher", "decrypt", params, size,
+        [&]() {
+          const auto decrypted = cipher.Decrypt(encrypted, aad);
+          return decrypted && *decrypted == plaintext;
+        },
+        kBenchObjectRuns);
+  }
+}
+
+}  // namespace
+
+void BenchDataObjectCipher(BenchRunner& runner, const BenchEnvironment&) {
+  const auto key = QCryptographicHash::hash(GeneratePayload(32),
+                                            QCryptographicHash::Sha256);
+
+  BenchCipher(runner, "aes_256_gcm", AesGcmDataObjectCipher(key));
+  BenchCipher(runner, "legacy_aes_256_ecb", LegacyAesEcbDataObjectCipher(key));
+}
+
+}  // namespace GpgFrontend::Bench
@@ -0,0 +1,89 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "bench/BenchRunner.h"
+#include "core/utils/IOUtils.h"
+
+namespace GpgFrontend::Bench {
+
+namespace {
+
+const QContainer<QCryptographicHash::Algorithm> kBenchDigestAlgorithms{
+    QCryptographicHash::Md5, QCryptographicHash::Sha1,
+    QCryptographicHash::Sha256};
+
+}  // namespace
+
+void BenchFileDigest(BenchRunner& runner, const BenchEnvironment& env) {
+  const auto size = env.args.max_digest_size;
+  const auto path = QDir(env.work_dir).filePath("digest");
+  if (!WritePayloadFile(path, size)) {
+    LOG_W() << "cannot write benchmark file:" << path;
+    QFile::remove(path);
+    return;
+  }
+
+  const auto passes = static_cast<qint64>(kBenchDigestAlgorithms.size());
+
+  // one read of the file feeds md5, sha1 and sha256 at once
+  runner.Measure(
+      "file_digest", "one_pass",
+      {{"size", size}, {"digests", passes}, {"bytes_read", size}}, size,
+      [&]() {
+        qint64 read = 0;
+        const auto digests = CalculateFileDigests(
+            path, kBenchDigestAlgorithms,
+            [&](qint64 bytes, qint64) { read = bytes; });
+        return digests.size() == kBenchDigestAlgorithms.size() &&
+               read == size;
+      },
+      1);
+
+  // the former CalculateHash(), which read the file once for each digest
+  runner.Measure(
+      "file_digest", "pass_per_digest",
+      {{"size", size}, {"digests", passes}, {"bytes_read", size * passes}},
+      size,
+      [&]() {
+        qint64 read = 0;
+        for (const auto algorithm : kBenchDigestAlgorithms) {
+          qint64 pass_read = 0;
+          const auto digests = CalculateFileDigests(
+              path, {algorithm},
+              [&](qint64 bytes, qint64) { pass_read = bytes; });
+          if (digests.size() != 1) return false;
+          read += pass_read;
+        }
+        return read == size * passes;
+      },
+      1);
+
+  QFile::remove(path);
+}
+
+}  // namespace GpgFrontend::Bench
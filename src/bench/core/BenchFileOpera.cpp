@@ -0,0 +1,287 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "bench/BenchRunner.h"
+#include "core/function/gpg/GpgFileOpera.h"
+#include "core/model/GpgData.h"
+#include "core/thread/TaskRunnerGetter.h"
+#include "core/utils/GpgUtils.h"
+
+namespace GpgFrontend::Bench {
+
+namespace {
+
+constexpr int kBenchDirectoryFiles = 64;
+constexpr int kBenchBatchFiles = 32;
+constexpr qint64 kBenchBatchFileSize = 64 * 1024;
+constexpr size_t kBenchGpgDataChunk = 64 * 1024;
+constexpr qint64 kBenchGpgDataMinSize = 1024 * 1024;
+
+/**
+ * @brief files from this size on are timed once, like the digest one
+ *
+ */
+constexpr qint64 kBenchGpgDataLargeSize = 256 * 1024 * 1024;
+
+auto WriteBenchFile(const QString& path, const QByteArray& content) -> bool {
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+  return file.write(content) == content.size();
+}
+
+auto GpgDataModeName(GpgDataFileMode mode) -> QString {
+  switch (mode) {
+    case GpgDataFileMode::kStream:
+      return "stream";
+    case GpgDataFileMode::kMapped:
+      return "mapped";
+    case GpgDataFileMode::kBuffered:
+      return "buffered";
+  }
+  return {};
+}
+
+void BenchFiles(BenchRunner& runner, const BenchEnvironment& env) {
+  auto& opera = GpgFileOpera::GetInstance(env.channel);
+  const KeyArgsList keys{env.key};
+  const auto dir = QDir(env.work_dir);
+
+  for (const auto size : PayloadSizes(env.args.max_payload_size)) {
+    const auto plain_path = dir.filePath(QString("plain_%1").arg(size));
+    const auto cipher_path = dir.filePath(QString("plain_%1.gpg").arg(size));
+    const auto decrypted_path = dir.filePath(QString("plain_%1.out").arg(size));
+    const auto sig_path = dir.filePath(QString("plain_%1.sig").arg(size));
+    if (!WriteBenchFile(plain_path, GeneratePayload(size))) {
+      LOG_W() << "cannot write benchmark file:" << plain_path;
+      continue;
+    }
+
+    const QJsonObject params{{"size", size}};
+
+    runner.Measure("file_opera", "encrypt_file", params, size, [&]() {
+      auto [err, data_object] =
+          opera.EncryptFileSync(keys, plain_path, false, cipher_path);
+      return CheckGpgError(err) == GPG_ERR_NO_ERROR;
+    });
+
+    runner.Measure("file_opera", "decrypt_file", params, size, [&]() {
+      auto [err, data_object] =
+          opera.DecryptFileSync(cipher_path, decrypted_path);
+      return CheckGpgError(err) == GPG_ERR_NO_ERROR &&
+             QFileInfo(decrypted_path).size() == size;
+    });
+
+    runner.Measure("file_opera", "sign_file", params, size, [&]() {
+      auto [err, data_object] =
+          opera.SignFileSync(keys, plain_path, false, sig_path);
+      return CheckGpgError(err) == GPG_ERR_NO_ERROR;
+    });
+
+    runner.Measure("file_opera", "verify_file", params, size, [&]() {
+      auto [err, data_object] = opera.VerifyFileSync(plain_path, sig_path);
+      return CheckGpgError(err) == GPG_ERR_NO_ERROR;
+    });
+
+    for (const auto& path :
+         {plain_path, cipher_path, decrypted_path, sig_path}) {
+      QFile::remove(path);
+    }
+  }
+}
+
+void BenchDirectory(BenchRunner& runner, const BenchEnvironment& env) {
+  auto& opera = GpgFileOpera::GetInstance(env.channel);
+  const KeyArgsList keys{env.key};
+
+  auto dir = QDir(env.work_dir);
+  const auto in_path = dir.filePath("directory");
+  const auto archive_path = dir.filePath("directory.tar.gpg");
+  const auto out_path = dir.filePath("directory_out");
+  dir.mkpath(in_path);
+  dir.mkpath(out_path);
+
+  const auto file_size = std::max<qint64>(
+      1024, env.args.max_payload_size / kBenchDirectoryFiles);
+  for (int i = 0; i < kBenchDirectoryFiles; i++) {
+    WriteBenchFile(QDir(in_path).filePath(QString("file_%1").arg(i)),
+                   GeneratePayload(file_size, i));
+  }
+
+  const auto total = file_size * kBenchDirectoryFiles;
+  const QJsonObject params{{"files", kBenchDirectoryFiles},
+                           {"file_size", file_size}};
+
+  runner.Measure("file_opera", "encrypt_directory", params, total, [&]() {
+    return CheckGpgError(WaitForOpera([&](const GpgOperationCallback& cb) {
+             opera.EncryptDirectory(keys, in_path, false, archive_path, cb);
+           })) == GPG_ERR_NO_ERROR;
+  });
+
+  runner.Measure("file_opera", "decrypt_archive", params, total, [&]() {
+    return CheckGpgError(WaitForOpera([&](const GpgOperationCallback& cb) {
+             opera.DecryptArchive(archive_path, out_path, cb);
+           })) == GPG_ERR_NO_ERROR;
+  });
+
+  QDir(in_path).removeRecursively();
+  QDir(out_path).removeRecursively();
+  QFile::remove(archive_path);
+}
+
+/**
+ * @brief 1, 2, 4 ... up to the ideal thread count
+ *
+ */
+auto GpgWorkerCounts() -> QList<int> {
+  const auto max = std::max(1, QThread::idealThreadCount());
+
+  QList<int> counts;
+  for (int count = 1; count <= max; count *= 2) counts.append(count);
+  if (counts.back() != max) counts.append(max);
+  return counts;
+}
+
+void BenchFileBatch(BenchRunner& runner, const BenchEnvironment& env) {
+  auto& opera = GpgFileOpera::GetInstance(env.channel);
+  const KeyArgsList keys{env.key};
+
+  auto dir = QDir(env.work_dir);
+  const auto batch_path = dir.filePath("batch");
+  dir.mkpath(batch_path);
+
+  QStringList in_paths;
+  for (int i = 0; i < kBenchBatchFiles; i++) {
+    const auto path = QDir(batch_path).filePath(QString("file_%1").arg(i));
+    WriteBenchFile(path, GeneratePayload(kBenchBatchFileSize, i));
+    in_paths.append(path);
+  }
+
+  auto& getter = Thread::TaskRunnerGetter::GetInstance();
+  const auto restore_count = qScopeGuard(
+      [&getter, count = getter.GetGpgWorkerCount()]() {
+        getter.SetGpgWorkerCount(count);
+      });
+
+  const auto total = kBenchBatchFileSize * kBenchBatchFiles;
+  for (const auto count : GpgWorkerCounts()) {
+    getter.SetGpgWorkerCount(count);
+
+    const QJsonObject params{{"files", kBenchBatchFiles},
+                             {"file_size", kBenchBatchFileSize},
+                             {"gpg_workers", count}};
+
+    // all files are posted at once and spread over the gpg workers
+    runner.Measure("file_opera", "encrypt_file_batch", params, total, [&]() {
+      QEventLoop looper;
+      int remaining = kBenchBatchFiles;
+      int failed = 0;
+
+      for (const auto& in_path : in_paths) {
+        opera.EncryptFile(keys, in_path, false, in_path + ".gpg",
+                          [&](GpgError err, const DataObjectPtr&) {
+                            if (CheckGpgError(err) != GPG_ERR_NO_ERROR) {
+                              failed++;
+                            }
+                            if (--remaining == 0) looper.quit();
+                          });
+      }
+      if (remaining > 0) looper.exec();
+      return failed == 0;
+    });
+  }
+
+  QDir(batch_path).removeRecursively();
+}
+
+void BenchGpgDataModes(BenchRunner& runner, const BenchEnvironment& env) {
+  const auto in_path = QDir(env.work_dir).filePath("gpg_data_in");
+  const auto out_path = QDir(env.work_dir).filePath("gpg_data_out");
+
+  // only the backends are timed here, gpgme drives them in the same chunks
+  std::vector<char> chunk(kBenchGpgDataChunk);
+  for (const auto size :
+       PayloadSizes(env.args.max_gpg_data_size, kBenchGpgDataMinSize)) {
+    if (!WritePayloadFile(in_path, size)) {
+      LOG_W() << "cannot write benchmark file:" << in_path;
+      break;
+    }
+
+    const auto iterations = size >= kBenchGpgDataLargeSize ? 1 : 0;
+    for (const auto mode :
+         {GpgDataFileMode::kStream, GpgDataFileMode::kMapped,
+          GpgDataFileMode::kBuffered}) {
+      const QJsonObject params{{"size", size},
+                               {"mode", GpgDataModeName(mode)}};
+
+      runner.Measure(
+          "gpg_data", "read_file", params, size,
+          [&]() {
+            GpgData data(in_path, true, mode);
+            qint64 total = 0;
+            ssize_t len;
+            while ((len = gpgme_data_read(data, chunk.data(),
+                                          chunk.size())) > 0) {
+              total += len;
+            }
+            return len == 0 && total == size;
+          },
+          iterations);
+
+      runner.Measure(
+          "gpg_data", "write_file", params, size,
+          [&]() {
+            GpgData data(out_path, false, mode, size);
+            for (qint64 written = 0; written < size;) {
+              const auto len = gpgme_data_write(
+                  data, chunk.data(),
+                  std::min<qint64>(static_cast<qint64>(chunk.size()),
+                                   size - written));
+              if (len <= 0) return false;
+              written += len;
+            }
+            return CheckGpgError(data.Flush()) == GPG_ERR_NO_ERROR;
+          },
+          iterations);
+
+      QFile::remove(out_path);
+    }
+  }
+
+  QFile::remove(in_path);
+}
+
+}  // namespace
+
+void BenchFileOpera(BenchRunner& runner, const BenchEnvironment& env) {
+  BenchFiles(runner, env);
+  BenchDirectory(runner, env);
+  BenchFileBatch(runner, env);
+  BenchGpgDataModes(runner, env);
+}
+
+}  // namespace GpgFrontend::Bench
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "bench/BenchRunner.h"
+#include "core/function/gpg/GpgContext.h"
+#include "core/function/gpg/GpgKeyGetter.h"
+#include "core/model/GpgKeyTableModel.h"
+#include "core/utils/GpgUtils.h"
+
+namespace GpgFrontend::Bench {
+
+namespace {
+
+constexpr int kSyntheticKeysPerBatch = 500;
+
+/**
+ * @brief gpg generates all keys of a parameter block in one process, which
+ * is much faster than one gpgme_op_createkey() per key.
+ *
+ */
+auto GenerateSyntheticKeys(int channel, int from, int to) -> bool {
+  auto* ctx = GpgContext::GetInstance(channel).DefaultContext();
+
+  for (int begin = from; begin < to; begin += kSyntheticKeysPerBatch) {
+    const auto end = std::min(to, begin + kSyntheticKeysPerBatch);
+
+    QString params = "<GnupgKeyParms format=\"internal\">\n";
+    for (int i = begin; i < end; i++) {
+      params += QString(
+                    "Key-Type: EdDSA\n"
+                    "Key-Curve: ed25519\n"
+                    "Key-Usage: sign\n"
+                    "Name-Real: Synthetic Key %1\n"
+                    "Name-Email: synthetic-%1@gpgfrontend.bktus.com\n"
+                    "Expire-Date: 0\n"
+                    "%no-protection\n"
+                    "%commit\n")
+                    .arg(i);
+    }
+    params += "</GnupgKeyParms>\n";
+
+    auto err = CheckGpgError(
+        gpgme_op_genkey(ctx, params.toUtf8().constData(), nullptr, nullptr));
+    if (err != GPG_ERR_NO_ERROR) return false;
+
+    LOG_I() << "synthetic keys generated:" << end << "/" << to;
+  }
+  return true;
+}
+
+}  // namespace
+
+void BenchKeyCache(BenchRunner& runner, const BenchEnvironment& env) {
+  auto& getter = GpgKeyGetter::GetInstance(env.keyring_channel);
+
+  // the keyring grows from one count to the next one
+  int generated = 0;
+  for (const auto count : KeyCounts(env.args.max_keys)) {
+    if (!GenerateSyntheticKeys(env.keyring_channel, generated, count)) {
+      LOG_W() << "cannot generate synthetic keyring of" << count << "keys";
+      return;
+    }
+    generated = count;
+
+    // a listing of a large keyring takes a while, fewer runs are enough
+    const auto iterations = count >= 10000 ? 1 : 0;
+    const QJsonObject params{{"keys", count}};
+
+    runner.Measure(
+        "key_cache", "flush_key_cache", params, 0,
+        [&]() { return getter.FlushKeyCache(); }, iterations);
+
+    if (getter.FetchKey().size() != count) {
+      LOG_W() << "unexpected size of synthetic keyring, expected:" << count;
+    }
+
+    runner.Measure(
+        "key_cache", "key_table_model", params, 0,
+        [&]() {
+          auto model = getter.GetGpgKeyTableModel();
+          return model->rowCount({}) == count;
+        },
+        iterations);
+  }
+}
+
+}  // namespace GpgFrontend::Bench
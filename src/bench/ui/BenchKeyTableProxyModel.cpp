@@ -0,0 +1,101 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "bench/BenchRunner.h"
+#include "core/GpgConstants.h"
+#include "core/model/GpgKeyTableModel.h"
+#include "ui/model/GpgKeyTableProxyModel.h"
+
+namespace GpgFrontend::Bench {
+
+namespace {
+
+constexpr int kSyntheticRows = 100000;
+
+auto SyntheticKeyTableRows(int count) -> QContainer<GpgKeyTableRow> {
+  QContainer<GpgKeyTableRow> rows;
+  rows.reserve(count);
+
+  const auto create_time = QDateTime::fromSecsSinceEpoch(1700000000);
+  for (int i = 0; i < count; i++) {
+    GpgKeyTableRow row;
+    row.fpr = QString("%1").arg(i, 40, 16, QChar('0')).toUpper();
+    row.id = row.fpr.right(16);
+    row.type = "pub";
+    row.name = QString("Synthetic Key %1").arg(i);
+    row.email = QString("synthetic-%1@gpgfrontend.bktus.com").arg(i);
+    row.usage = "CS";
+    row.owner_trust = "Unknown";
+    row.create_time = create_time;
+    row.algo = "ED25519";
+    row.subkeys_count = 1;
+    row.uids = {QString("%1 <%2>").arg(row.name, row.email)};
+    rows.append(row);
+  }
+  return rows;
+}
+
+}  // namespace
+
+void BenchKeyTableProxyModel(BenchRunner& runner, const BenchEnvironment&) {
+  // the rows don't need a keyring, so the large counts stay cheap
+  for (const auto count : KeyCounts(kSyntheticRows)) {
+    auto model = QSharedPointer<GpgKeyTableModel>::create(
+        kGpgFrontendDefaultChannel, SyntheticKeyTableRows(count));
+    UI::GpgKeyTableProxyModel proxy(
+        model,
+        GpgKeyTableDisplayMode::kPUBLIC_KEY |
+            GpgKeyTableDisplayMode::kPRIVATE_KEY,
+        GpgKeyTableColumn::kALL, [](const GpgKey&) { return true; }, nullptr);
+
+    const QJsonObject params{{"rows", count}};
+
+    // the keywords never contain the last ones, every run scans all rows
+    int serial = 0;
+    runner.Measure("key_table_proxy_model", "search_full", params, 0, [&]() {
+      proxy.SetSearchKeywords(QString("key %1").arg(serial++ % count));
+      return proxy.rowCount() > 0;
+    });
+
+    // a user typing the keywords narrows the last matches down
+    const QString keywords = "synthetic-42";
+    runner.Measure("key_table_proxy_model", "search_typing", params, 0, [&]() {
+      for (int i = 1; i <= keywords.size(); i++) {
+        proxy.SetSearchKeywords(keywords.left(i));
+      }
+      return proxy.rowCount() > 0;
+    });
+
+    runner.Measure("key_table_proxy_model", "search_clear", params, 0, [&]() {
+      proxy.SetSearchKeywords({});
+      return proxy.rowCount() == count;
+    });
+  }
+}
+
+}  // namespace GpgFrontend::Bench
@@ -44,6 +44,7 @@
 // GpgFrontend
 
 #include "GpgFrontendContext.h"
+#include "bench/GpgFrontendBench.h"
 #include "test/GpgFrontendTest.h"
 
 namespace GpgFrontend {
@@ -238,4 +239,61 @@ auto RunTest(const GFCxtWPtr& p_ctx) -> int {
   return 0;
 }
 
-}  // namespace GpgFrontend
\ No newline at end of file
+auto RunBench(const GFCxtWPtr& p_ctx, const QCommandLineParser& parser)
+    -> int {
+  GpgFrontend::GFCxtSPtr const ctx = p_ctx.lock();
+  if (ctx == nullptr) {
+    qWarning("cannot get gpgfrontend context for benchmark running");
+    return -1;
+  }
+
+  GpgFrontend::Bench::GpgFrontendBenchContext bench_args;
+  bench_args.output_path = parser.value("b");
+  if (parser.isSet("bench-max-size")) {
+    bench_args.max_payload_size = parser.value("bench-max-size").toLongLong();
+  }
+  if (parser.isSet("bench-max-keys")) {
+    bench_args.max_keys = parser.value("bench-max-keys").toInt();
+  }
+  if (parser.isSet("bench-digest-size")) {
+    bench_args.max_digest_size =
+        parser.value("bench-digest-size").toLongLong();
+  }
+  if (parser.isSet("bench-gpg-data-size")) {
+    bench_args.max_gpg_data_size =
+        parser.value("bench-gpg-data-size").toLongLong();
+  }
+  if (parser.isSet("bench-iterations")) {
+    bench_args.iterations = parser.value("bench-iterations").toInt();
+  }
+
+  if (bench_args.max_payload_size <= 0 || bench_args.max_keys <= 0 ||
+      bench_args.max_digest_size <= 0 || bench_args.max_gpg_data_size <= 0 ||
+      bench_args.iterations <= 0) {
+    qWarning("invalid benchmark options");
+    return -1;
+  }
+
+  QEventLoop looper;
+  int rtn = 0;
+
+  auto* task = new GpgFrontend::Thread::Task(
+      [=, &rtn](const DataObjectPtr&) -> int {
+        rtn = GpgFrontend::Bench::ExecuteAllBenchmarks(bench_args);
+        return 0;
+      },
+      "benchmark", TransferParams());
+
+  QObject::connect(task, &GpgFrontend::Thread::Task::SignalTaskEnd, &looper,
+                   &QEventLoop::quit);
+
+  GpgFrontend::Thread::TaskRunnerGetter::GetInstance()
+      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Default)
+      ->PostTask(task);
+
+  ctx->rtn = kNonRestartCode;
+  looper.exec();
+  return rtn;
+}
+
+}  // namespace GpgFrontend
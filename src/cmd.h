@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <qcommandlineparser.h>
+
 #include "GpgFrontendContext.h"
 
 namespace GpgFrontend {
@@ -40,6 +42,8 @@ auto ParseLogLevel(const QString& level) -> int;
 
 auto RunTest(const GFCxtWPtr&) -> int;
 
+auto RunBench(const GFCxtWPtr&, const QCommandLineParser&) -> int;
+
 auto PrintEnvInfo() -> int;
 
 }  // namespace GpgFrontend
\ No newline at end of file
@@ -39,6 +39,9 @@ constexpr int kCrashCode = ~0;          ///< application crash
 constexpr int kGpgFrontendDefaultChannel = 0;   ///<
 constexpr int kGpgFrontendNonAsciiChannel = 2;  ///<
 
+// GPG WORKERS
+constexpr int kGpgContextPoolMaxSize = 16;  ///< max count of gpg workers
+
 // HEADER
 constexpr const char* PGP_CRYPT_BEGIN = "-----BEGIN PGP MESSAGE-----";  ///<
 constexpr const char* PGP_CRYPT_END = "-----END PGP MESSAGE-----";      ///<
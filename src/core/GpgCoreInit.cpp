@@ -36,6 +36,7 @@
 #include "core/function/gpg/GpgAdvancedOperator.h"
 #include "core/function/gpg/GpgContext.h"
 #include "core/function/gpg/GpgKeyGetter.h"
+#include "core/function/gpg/GpgKeyTableSnapshot.h"
 #include "core/module/ModuleManager.h"
 #include "core/thread/Task.h"
 #include "core/thread/TaskRunnerGetter.h"
@@ -461,7 +462,55 @@ auto InitBasicPath() -> bool {
   return true;
 }
 
+/**
+ * @brief expose the duration of a startup phase in the rt value table
+ *
+ * @param phase
+ * @param timer
+ */
+void UpsertStartupTiming(const QString& phase, const QElapsedTimer& timer) {
+  const auto elapsed = timer.elapsed();
+  LOG_D() << "startup phase:" << phase << "took" << elapsed << "ms";
+  Module::UpsertRTValue("core", QString("env.timing.%1").arg(phase), elapsed);
+}
+
+/**
+ * @brief load a secondary key database at its channel
+ *
+ * @param channel
+ * @param args
+ * @return true if success
+ */
+auto InitGpgKeyDatabase(int channel, const GpgContextInitArgs& args) -> bool {
+  LOG_D() << "new gpgme context, channel" << channel << ", key db name"
+          << args.db_name << "key db path" << args.db_path;
+
+  // CreateInstance() locks all the channels while the factory runs, so build
+  // the context before to let the channels load concurrently
+  auto ctx = SecureCreateUniqueObject<GpgContext>(args, channel);
+  if (!ctx->Good()) {
+    FLOG_E() << "gpgme context init failed, index:" << channel;
+    return false;
+  }
+
+  GpgContext::CreateInstance(channel, [&]() -> ChannelObjectPtr {
+    return ConvertToChannelObjectPtr<>(std::move(ctx));
+  });
+
+  if (!GpgKeyGetter::GetInstance(channel).FlushKeyCache()) {
+    FLOG_E() << "gpgme context init key cache failed, index:" << channel;
+    return false;
+  }
+  return true;
+}
+
 auto InitGpgFrontendCore(CoreInitArgs args) -> int {
+  QElapsedTimer startup_timer;
+  startup_timer.start();
+
+  QElapsedTimer phase_timer;
+  phase_timer.start();
+
   // initialize gpgme
   if (!InitGpgME()) {
     LOG_E() << "Oops, GpgME init failed!"
@@ -473,6 +522,8 @@ auto InitGpgFrontendCore(CoreInitArgs args) -> int {
   }
 
   Module::UpsertRTValue("core", "env.state.gpgme", 1);
+  UpsertStartupTiming("gpgme", phase_timer);
+  phase_timer.restart();
 
   // decide gpgconf, gnupg and default home path
   if (!InitBasicPath()) {
@@ -480,6 +531,7 @@ auto InitGpgFrontendCore(CoreInitArgs args) -> int {
             << "GpgFrontend cannot start under this situation!";
     return -1;
   }
+  UpsertStartupTiming("basic_path", phase_timer);
 
   auto default_gpgconf_path = Module::RetrieveRTValueTypedOrDefault<>(
       "core", "gpgme.ctx.gpgconf_path", QString{});
@@ -506,6 +558,16 @@ auto InitGpgFrontendCore(CoreInitArgs args) -> int {
   auto restart_all_gnupg_components_on_start =
       settings.value("gnupg/restart_gpg_agent_on_start", false).toBool();
 
+  // every gpg worker leases its own gpgme contexts of each channel
+  auto context_pool_size =
+      std::clamp(settings
+                     .value("gnupg/context_pool_size",
+                            std::min(QThread::idealThreadCount(), 4))
+                     .toInt(),
+                 1, kGpgContextPoolMaxSize);
+  Thread::TaskRunnerGetter::GetInstance().SetGpgWorkerCount(context_pool_size);
+  Module::UpsertRTValue("core", "gpgme.ctx.pool_size", context_pool_size);
+
   // unit test mode
   if (args.unit_test_mode) {
     Module::UpsertRTValue("core", "env.state.basic", 1);
@@ -516,6 +578,7 @@ auto InitGpgFrontendCore(CoreInitArgs args) -> int {
   }
 
   auto key_dbs = GetKeyDatabaseInfoBySettings();
+  phase_timer.restart();
 
   // load default context
   auto& default_ctx = GpgFrontend::GpgContext::CreateInstance(
@@ -546,78 +609,100 @@ auto InitGpgFrontendCore(CoreInitArgs args) -> int {
   }
 
   Module::UpsertRTValue("core", "env.state.ctx", 1);
+  UpsertStartupTiming("default_ctx", phase_timer);
+  phase_timer.restart();
+
+  auto& key_table_snapshot =
+      GpgKeyTableSnapshot::GetInstance(kGpgFrontendDefaultChannel);
+  if (key_table_snapshot.Load()) {
+    // the key list shows the snapshot, the keyring is listed meanwhile
+    Thread::TaskRunnerGetter::GetInstance()
+        .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_GPG)
+        ->PostTask(new Thread::Task(
+            [=](const DataObjectPtr&) -> int {
+              QElapsedTimer timer;
+              timer.start();
+
+              const auto ret = GpgKeyGetter::GetInstance(
+                                   kGpgFrontendDefaultChannel)
+                                   .FlushKeyCache();
+              if (!ret) LOG_W() << "listing the default key database failed";
+              UpsertStartupTiming("default_key_db", timer);
+
+              GpgKeyTableSnapshot::GetInstance(kGpgFrontendDefaultChannel)
+                  .Release();
+              emit CoreSignalStation::GetInstance()->SignalKeyCacheReconciled(
+                  kGpgFrontendDefaultChannel);
+              return ret ? 0 : -1;
+            },
+            "core_default_key_db_reconcile_task"));
+
+    UpsertStartupTiming("default_key_table_snapshot", phase_timer);
+  } else {
+    if (!GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
+             .FlushKeyCache()) {
+      FLOG_E() << "Init GpgME Default Key Database failed!"
+               << "GpgFrontend cannot start under this situation!";
+      Module::UpsertRTValue("core", "env.state.ctx", -1);
+      CoreSignalStation::GetInstance()->SignalBadGnupgEnv(
+          QCoreApplication::tr("Gpg Default Key Database Initiation Failed"));
+      return -1;
+    };
 
-  if (!GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel).FlushKeyCache()) {
-    FLOG_E() << "Init GpgME Default Key Database failed!"
-             << "GpgFrontend cannot start under this situation!";
-    Module::UpsertRTValue("core", "env.state.ctx", -1);
-    CoreSignalStation::GetInstance()->SignalBadGnupgEnv(
-        QCoreApplication::tr("Gpg Default Key Database Initiation Failed"));
-    return -1;
-  };
+    UpsertStartupTiming("default_key_db", phase_timer);
+  }
 
+  // the default key database is ready, the ui needn't wait for the others
   Module::UpsertRTValue("core", "env.state.basic", 1);
   CoreSignalStation::GetInstance()->SignalGoodGnupgEnv();
+  UpsertStartupTiming("basic", startup_timer);
   LOG_I() << "Basic ENV Checking Finished";
 
-  auto* task = new Thread::Task(
-      [=](const DataObjectPtr&) -> int {
-        int channel_index = kGpgFrontendDefaultChannel + 1;
-        for (int i = 1; i < key_dbs.size(); i++) {
-          const auto& key_db = key_dbs[i];
-
-          // init ctx, also checking the basic env
-          auto& ctx = GpgFrontend::GpgContext::CreateInstance(
-              channel_index, [=]() -> ChannelObjectPtr {
-                GpgFrontend::GpgContextInitArgs args;
-
-                // set key database path
-                if (!key_db.path.isEmpty()) {
-                  args.db_name = key_db.name;
-                  args.db_path = key_db.path;
-                }
-
-                args.offline_mode = forbid_all_gnupg_connection;
-                args.auto_import_missing_key = auto_import_missing_key;
-                args.use_pinentry = use_pinentry_as_password_input_dialog;
-
-                LOG_D() << "new gpgme context, channel" << channel_index
-                        << ", key db name" << args.db_name << "key db path"
-                        << args.db_path << "";
-
-                return ConvertToChannelObjectPtr<>(
-                    SecureCreateUniqueObject<GpgContext>(args, channel_index));
-              });
-
-          if (!ctx.Good()) {
-            FLOG_E() << "gpgme context init failed, index:" << channel_index;
-            continue;
-          }
+  auto all_key_dbs_loaded = [=]() {
+    UpsertStartupTiming("key_dbs", startup_timer);
+    Module::UpsertRTValue("core", "env.state.key_dbs", 1);
+    LOG_I() << "All Key Database(s) Initialize Finished";
+    emit CoreSignalStation::GetInstance()->SignalKeyDatabasesLoaded();
+  };
 
-          if (!GpgKeyGetter::GetInstance(ctx.GetChannel()).FlushKeyCache()) {
-            FLOG_E() << "gpgme context init key cache failed, index:"
-                     << channel_index;
-            continue;
-          }
+  const auto secondary_key_dbs = static_cast<int>(key_dbs.size()) - 1;
+  auto remaining_key_dbs =
+      SecureCreateSharedObject<std::atomic_int>(secondary_key_dbs);
+  if (secondary_key_dbs <= 0) all_key_dbs_loaded();
 
-          channel_index++;
-        }
+  // every secondary key database loads on a worker of its own with its own
+  // context, it may take a few seconds or minutes
+  for (int i = 1; i < key_dbs.size(); i++) {
+    const auto channel = kGpgFrontendDefaultChannel + i;
 
-        Module::UpsertRTValue("core", "env.state.key_dbs", 1);
+    GpgFrontend::GpgContextInitArgs ctx_args;
 
-        return 0;
-      },
-      "core_key_dbs_init_task");
+    // set key database path
+    const auto& key_db = key_dbs[i];
+    if (!key_db.path.isEmpty()) {
+      ctx_args.db_name = key_db.name;
+      ctx_args.db_path = key_db.path;
+    }
 
-  QObject::connect(task, &Thread::Task::SignalTaskEnd, []() {
-    LOG_I() << "All Key Database(s) Initialize Finished";
-  });
+    ctx_args.offline_mode = forbid_all_gnupg_connection;
+    ctx_args.auto_import_missing_key = auto_import_missing_key;
+    ctx_args.use_pinentry = use_pinentry_as_password_input_dialog;
 
-  // start the thread to check ctx and gnupg state
-  // it may take a few seconds or minutes
-  GpgFrontend::Thread::TaskRunnerGetter::GetInstance()
-      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Default)
-      ->PostTask(task);
+    GpgFrontend::Thread::TaskRunnerGetter::GetInstance()
+        .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Default)
+        ->PostTask(new Thread::Task(
+            [=](const DataObjectPtr&) -> int {
+              QElapsedTimer timer;
+              timer.start();
+
+              const auto ret = InitGpgKeyDatabase(channel, ctx_args);
+              UpsertStartupTiming(QString("key_db.%1").arg(channel), timer);
+
+              if (--(*remaining_key_dbs) == 0) all_key_dbs_loaded();
+              return ret ? 0 : -1;
+            },
+            QString("core_key_db_init_task_%1").arg(channel)));
+  }
 
   if (!args.unit_test_mode && restart_all_gnupg_components_on_start) {
     GpgAdvancedOperator::RestartGpgComponents(nullptr);
@@ -626,46 +711,51 @@ auto InitGpgFrontendCore(CoreInitArgs args) -> int {
 }
 
 void StartMonitorCoreInitializationStatus() {
-  auto* task = new Thread::Task(
-      [=](const DataObjectPtr&) -> int {
-        int core_init_state = Module::RetrieveRTValueTypedOrDefault<>(
+  struct MonitorState {
+    std::atomic_bool done = false;
+    std::atomic<Thread::TaskScheduleID> schedule_id = -1;
+    std::atomic_bool modules_registered = false;
+  };
+
+  auto runner = GpgFrontend::Thread::TaskRunnerGetter::GetInstance()
+                    .GetTaskRunner(
+                        Thread::TaskRunnerGetter::kTaskRunnerType_Default);
+  auto state = SecureCreateSharedObject<MonitorState>();
+
+  // checks may overlap, only the first one finishing the monitor goes on
+  auto finish = [runner, state]() -> bool {
+    if (state->done.exchange(true)) return false;
+    runner->CancelScheduleTask(state->schedule_id);
+    return true;
+  };
+
+  // check the state of ctx and gnupg periodically instead of waiting for it,
+  // it may take a few seconds or minutes
+  state->schedule_id = runner->PostPeriodicTask(
+      "waiting_core_init_task",
+      [state, finish](const DataObjectPtr&) -> int {
+        if (state->done) return 0;
+
+        const int core_init_state = Module::RetrieveRTValueTypedOrDefault<>(
             "core", "env.state.basic", 0);
-        for (;;) {
-          if (core_init_state != 0) break;
-          core_init_state = Module::RetrieveRTValueTypedOrDefault<>(
-              "core", "env.state.basic", 0);
+        if (core_init_state == 0) return 0;
 
-          LOG_D() << "monitor: core env is still initializing, waiting...";
-          QThread::msleep(100);
+        if (core_init_state < 0) {
+          if (finish()) LOG_W() << "monitor: core env initialization failed.";
+          return -1;
         }
 
-        if (core_init_state < 0) return -1;
-
         // waiting for module first
-        bool module_init_done =
-            Module::ModuleManager::GetInstance().IsAllModulesRegistered();
-        for (;;) {
-          if (module_init_done) break;
-          module_init_done =
-              Module::ModuleManager::GetInstance().IsAllModulesRegistered();
-
-          LOG_D() << "monitor: some modules are still going to be registered, "
-                     "waiting...";
-          QThread::msleep(15);
+        if (!state->modules_registered) {
+          if (!Module::ModuleManager::GetInstance().IsAllModulesRegistered()) {
+            return 0;
+          }
+          LOG_D() << "monitor: good, all module are registered.";
+          state->modules_registered = true;
         }
-        LOG_D() << "monitor: good, all module are registered.";
 
-        int key_db_init_state = Module::RetrieveRTValueTypedOrDefault<>(
-            "core", "env.state.key_dbs", 0);
-        for (;;) {
-          if (key_db_init_state != 0) break;
-          key_db_init_state = Module::RetrieveRTValueTypedOrDefault<>(
-              "core", "env.state.key_dbs", 0);
-
-          LOG_D() << "monitor: key dbs are still initializing, waiting...";
-          QThread::msleep(15);
-        }
-        LOG_D() << "monitor: good, all key db are loaded.";
+        // secondary key databases keep loading after this point
+        if (!finish()) return 0;
 
         LOG_D()
             << "monitor: core is fully initialized, sending signal to ui...";
@@ -673,17 +763,10 @@ void StartMonitorCoreInitializationStatus() {
         CoreSignalStation::GetInstance()->SignalCoreFullyLoaded();
         return 0;
       },
-      "waiting_core_init_task");
+      std::chrono::milliseconds(15));
 
-  QObject::connect(task, &Thread::Task::SignalTaskEnd, [=]() {
-    LOG_D() << "monitor: monitor task ended, call back to main thead.";
-  });
-
-  // start the thread to check ctx and gnupg state
-  // it may take a few seconds or minutes
-  GpgFrontend::Thread::TaskRunnerGetter::GetInstance()
-      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_External_Process)
-      ->PostTask(task);
+  // the first check may have finished before the id is known
+  if (state->done) runner->CancelScheduleTask(state->schedule_id);
 }
 
 }  // namespace GpgFrontend
\ No newline at end of file
@@ -32,6 +32,7 @@
 #include <archive_entry.h>
 #include <sys/fcntl.h>
 
+#include "core/thread/TaskTracer.h"
 #include "core/utils/AsyncUtils.h"
 
 namespace GpgFrontend {
@@ -59,17 +60,32 @@ auto CopyData(struct archive *ar, struct archive *aw) -> int {
   }
 }
 
+constexpr qint64 kArchiveFileReadSize = 64 * 1024;
+
 struct ArchiveReadClientData {
   GFDataExchanger *ex;
-  std::array<std::byte, 1024> buf;
-  const std::byte *p_buf = buf.data();
+  size_t borrowed = 0;
 };
 
 auto ArchiveReadCallback(struct archive *, void *client_data,
                          const void **buffer) -> ssize_t {
   auto *rdata = static_cast<ArchiveReadClientData *>(client_data);
-  *buffer = reinterpret_cast<const void *>(rdata->p_buf);
-  return rdata->ex->Read(rdata->buf.data(), rdata->buf.size());
+
+  // libarchive is done with the previous block once it asks for the next one
+  rdata->ex->ReleaseReadRegion(rdata->borrowed);
+
+  auto region = rdata->ex->BorrowReadRegion(rdata->ex->Capacity());
+  rdata->borrowed = region.size;
+
+  *buffer = reinterpret_cast<const void *>(region.data);
+  return static_cast<ssize_t>(region.size);
+}
+
+auto ArchiveCloseReadCallback(struct archive *, void *client_data) -> int {
+  auto *rdata = static_cast<ArchiveReadClientData *>(client_data);
+  rdata->ex->ReleaseReadRegion(rdata->borrowed);
+  rdata->borrowed = 0;
+  return ARCHIVE_OK;
 }
 
 auto ArchiveWriteCallback(struct archive *, void *client_data,
@@ -97,9 +113,15 @@ void ArchiveFileOperator::NewArchive2DataExchanger(
         archive_write_set_format_pax_restricted(archive);
         archive_write_set_format_option(archive, "pax", "hdrcharset", "BINARY");
 
+        // no blocking: hand every write straight to the exchanger instead of
+        // copying it into libarchive's block buffer first
+        archive_write_set_bytes_per_block(archive, 0);
+
         archive_write_open(archive, exchanger.get(), nullptr,
                            ArchiveWriteCallback, ArchiveCloseWriteCallback);
 
+        std::vector<char> buffer(kArchiveFileReadSize);
+
         auto *disk = archive_read_disk_new();
         archive_read_disk_set_standard_lookup(disk);
 
@@ -141,6 +163,7 @@ void ArchiveFileOperator::NewArchive2DataExchanger(
           auto source_path = QString::fromUtf8(archive_entry_pathname(entry));
 #endif
 
+          Thread::TraceSpan span(source_path, "archive");
           QFile file(source_path);
 
           if (file.open(QIODevice::ReadOnly)) {
@@ -175,10 +198,10 @@ void ArchiveFileOperator::NewArchive2DataExchanger(
             }
 
             if (r > ARCHIVE_FAILED) {
-              auto buffer = file.read(1024);
-              while (!buffer.isEmpty()) {
-                archive_write_data(archive, buffer.data(), buffer.size());
-                buffer = file.read(1024);
+              qint64 size;
+              while ((size = file.read(buffer.data(), kArchiveFileReadSize)) >
+                     0) {
+                archive_write_data(archive, buffer.data(), size);
               }
             }
           }
@@ -219,7 +242,7 @@ void ArchiveFileOperator::ExtractArchiveFromDataExchanger(
         rdata.ex = ex.get();
 
         r = archive_read_open(archive, &rdata, nullptr, ArchiveReadCallback,
-                              nullptr);
+                              ArchiveCloseReadCallback);
 
         if (r != ARCHIVE_OK) {
           FLOG_W("archive_read_open(), ret: %d, reason: %s", r,
@@ -256,6 +279,7 @@ void ArchiveFileOperator::ExtractArchiveFromDataExchanger(
           archive_entry_set_pathname(entry, target_path_name.toUtf8());
 #endif
 
+          Thread::TraceSpan span(path_name, "archive");
           r = archive_write_header(ext, entry);
           if (r != ARCHIVE_OK) {
             FLOG_W("archive_write_header(), ret: %d, reason: %s", r,
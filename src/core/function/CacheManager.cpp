@@ -29,18 +29,32 @@
 #include "CacheManager.h"
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <shared_mutex>
 
 #include "core/function/DataObjectOperator.h"
+#include "core/thread/TaskRunnerGetter.h"
 #include "core/utils/MemoryUtils.h"
 
 namespace GpgFrontend {
 
+namespace {
+
+/**
+ * @brief the journal is compacted into the data objects after so many
+ * records
+ *
+ */
+constexpr qsizetype kMaxDurableCacheJournalRecords = 256;
+
+}  // namespace
+
 template <typename Key, typename Value>
 class ThreadSafeMap {
  public:
   using MapType = std::map<Key, Value>;
-  using IteratorType = typename MapType::iterator;
 
   void insert(const Key& key, const Value& value) {
     std::unique_lock lock(mutex_);
@@ -61,14 +75,16 @@ class ThreadSafeMap {
     return map_->count(key) > 0;
   }
 
-  auto begin() -> IteratorType { return map_mirror_->begin(); }
-
-  auto end() -> IteratorType { return map_mirror_->end(); }
-
-  auto mirror() -> ThreadSafeMap& {
+  /**
+   * @brief call the function with every entry under the read lock, without a
+   * copy of the map. The function must not call back into the map.
+   *
+   * @param function
+   */
+  template <typename Function>
+  void for_each(Function&& function) const {
     std::shared_lock lock(mutex_);
-    *map_mirror_ = *map_;
-    return *this;
+    for (const auto& [key, value] : *map_) function(key, value);
   }
 
   auto remove(QString key) -> bool {
@@ -82,8 +98,6 @@ class ThreadSafeMap {
   }
 
  private:
-  std::unique_ptr<MapType, SecureObjectDeleter<MapType>> map_mirror_ =
-      std::move(SecureCreateUniqueObject<MapType>());
   std::unique_ptr<MapType, SecureObjectDeleter<MapType>> map_ =
       std::move(SecureCreateUniqueObject<MapType>());
   mutable std::shared_mutex mutex_;
@@ -92,47 +106,68 @@ class ThreadSafeMap {
 class CacheManager::Impl : public QObject {
   Q_OBJECT
  public:
-  Impl() : flush_timer_(new QTimer(this)) {
-    connect(flush_timer_, &QTimer::timeout, this,
-            &Impl::slot_flush_cache_storage);
-    flush_timer_->start(15000);
-
+  Impl()
+      : flush_runner_(Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
+            Thread::TaskRunnerGetter::kTaskRunnerType_IO)) {
     // load data from storage
     load_all_cache_storage();
+
+    task_guard_->impl = this;
+
+    flush_task_id_ = flush_runner_->PostPeriodicTask(
+        "flush_cache_storage",
+        [guard = task_guard_](const DataObjectPtr&) -> int {
+          std::lock_guard<std::mutex> lock(guard->lock);
+          if (guard->impl != nullptr) guard->impl->FlushCacheStorage();
+          return 0;
+        },
+        std::chrono::seconds(15));
+
+    // turns the timing wheel of the runtime cache
+    expire_task_id_ = flush_runner_->PostPeriodicTask(
+        "expire_runtime_cache",
+        [guard = task_guard_](const DataObjectPtr&) -> int {
+          std::lock_guard<std::mutex> lock(guard->lock);
+          if (guard->impl != nullptr) {
+            guard->impl->runtime_cache_storage_.Expire();
+          }
+          return 0;
+        },
+        std::chrono::seconds(1));
   }
 
-  void SaveDurableCache(QString key, const QJsonDocument& value, bool flush) {
-    auto data_object_key = get_data_object_key(key);
-    durable_cache_storage_.insert(key, value);
+  ~Impl() override {
+    flush_runner_->CancelScheduleTask(flush_task_id_);
+    flush_runner_->CancelScheduleTask(expire_task_id_);
 
-    if (!key_storage_.contains(key)) {
-      key_storage_.push_back(key);
+    // waits for a periodic task running on the io runner right now
+    std::lock_guard<std::mutex> lock(task_guard_->lock);
+    task_guard_->impl = nullptr;
+  }
+
+  void SaveDurableCache(const QString& key, const QJsonDocument& value,
+                        bool flush) {
+    // e.g. a cache object which was only read
+    if (durable_cache_storage_.get(key) != value) {
+      durable_cache_storage_.insert(key, value);
+      mark_dirty(key);
     }
 
-    durable_cache_modified_ = true;
     if (flush) slot_flush_cache_storage();
   }
 
   auto LoadDurableCache(const QString& key) -> QJsonDocument {
-    auto data_object_key = get_data_object_key(key);
-
-    if (!durable_cache_storage_.exists(key)) {
-      durable_cache_storage_.insert(key, load_cache_storage(key, {}));
-      durable_cache_modified_ = true;
-    }
-
-    auto cache = durable_cache_storage_.get(key);
-    if (cache.has_value()) return cache.value();
-    return {};
+    return LoadDurableCache(key, {});
   }
 
   auto LoadDurableCache(const QString& key,
                         QJsonDocument default_value) -> QJsonDocument {
-    auto data_object_key = get_data_object_key(key);
     if (!durable_cache_storage_.exists(key)) {
+      // the data object of a reset key is stale until the flush removes it
+      if (is_reset_key(key)) return default_value;
+
       durable_cache_storage_.insert(
           key, load_cache_storage(key, std::move(default_value)));
-      durable_cache_modified_ = true;
     }
 
     auto cache = durable_cache_storage_.get(key);
@@ -141,48 +176,50 @@ class CacheManager::Impl : public QObject {
   }
 
   auto ResetDurableCache(const QString& key) -> bool {
-    auto data_object_key = get_data_object_key(key);
-    durable_cache_modified_ = true;
-    return durable_cache_storage_.remove(key);
+    // a dirty key missing in the storage is removed at the flush
+    const auto removed = durable_cache_storage_.remove(key);
+    mark_dirty(key);
+
+    std::lock_guard<std::mutex> lock(dirty_lock_);
+    for (auto it = key_storage_.begin(); it != key_storage_.end(); ++it) {
+      if (it->toString() != key) continue;
+      key_storage_.erase(it);
+      key_storage_modified_ = true;
+      break;
+    }
+    return removed;
+  }
+
+  void SetDurableCacheJournal(const QString& key, bool enable) {
+    std::lock_guard<std::mutex> lock(dirty_lock_);
+    if (enable) {
+      journal_keys_.insert(key);
+    } else if (journal_keys_.erase(key) > 0) {
+      // the records of it in the journal must not override it later
+      journal_compact_needed_ = true;
+    }
   }
 
   void FlushCacheStorage() { this->slot_flush_cache_storage(); }
 
   void SaveCache(const QString& key, QString value, qint64 ttl) {
     LOG_D() << "save cache, key: " << key << "ttl: " << ttl;
-    runtime_cache_storage_.insert(
-        key, new CacheObject(
-                 std::move(value),
-                 ttl < 0 ? -1 : QDateTime::currentSecsSinceEpoch() + ttl));
+    runtime_cache_storage_.Insert(key, std::move(value), ttl);
   }
 
   auto LoadCache(const QString& key) -> QString {
-    if (!runtime_cache_storage_.contains(key)) return {};
-    LOG_D() << "hit cache, key: " << key;
-
-    auto* value = runtime_cache_storage_.object(key);
-    if (value == nullptr) {
-      LOG_E() << "hit cache but got nullptr by value, key" << key;
-      return {};
-    }
-
-    if (value->ttl < 0) {
-      return value->value;
-    }
+    return runtime_cache_storage_.Get(key).value_or(QString());
+  }
 
-    // deal with expiration
-    auto current_timestamp = QDateTime::currentSecsSinceEpoch();
-    if (current_timestamp > value->ttl) {
-      LOG_D() << "hit cache but expired, key: " << key
-              << "expiration timestamp:" << value->ttl;
-      ResetCache(key);
-      return {};
-    }
+  void ResetCache(const QString& key) { runtime_cache_storage_.Remove(key); }
 
-    return value->value;
+  auto GetCacheStats() const -> RuntimeCacheStats {
+    return runtime_cache_storage_.GetStats();
   }
 
-  void ResetCache(const QString& key) { runtime_cache_storage_.remove(key); }
+  void SetCacheByteBudget(qint64 byte_budget) {
+    runtime_cache_storage_.SetByteBudget(byte_budget);
+  }
 
  private slots:
 
@@ -191,19 +228,58 @@ class CacheManager::Impl : public QObject {
    *
    */
   void slot_flush_cache_storage() {
-    if (!durable_cache_modified_) return;
+    // also called by the periodic flush task on the io runner
+    std::lock_guard<std::mutex> lock(flush_lock_);
+
+    std::set<QString> dirty_keys;
+    std::set<QString> journal_keys;
+    QJsonArray key_storage;
+    bool key_storage_modified = false;
+    bool journal_compact_needed = false;
+    {
+      std::lock_guard<std::mutex> dirty_lock(dirty_lock_);
+      dirty_keys.swap(dirty_keys_);
+      journal_keys = journal_keys_;
+      key_storage_modified = std::exchange(key_storage_modified_, false);
+      if (key_storage_modified) key_storage = key_storage_;
+      journal_compact_needed = std::exchange(journal_compact_needed_, false);
+    }
 
-    FLOG_D("update durable cache to disk...");
+    if (dirty_keys.empty() && !key_storage_modified &&
+        !journal_compact_needed) {
+      return;
+    }
 
-    for (const auto& cache : durable_cache_storage_.mirror()) {
-      auto key = get_data_object_key(cache.first);
-      GpgFrontend::DataObjectOperator::GetInstance().SaveDataObj(
-          key, QJsonDocument(cache.second));
+    LOG_D() << "update durable cache to disk, dirty keys:" << dirty_keys.size();
+
+    // only the keys changed since the last flush are written
+    QContainer<QJsonDocument> journal_records;
+    for (const auto& key : dirty_keys) {
+      auto value = durable_cache_storage_.get(key);
+      if (journal_keys.count(key) > 0) {
+        journal_records.push_back(get_journal_record(key, value));
+        journal_file_keys_.insert(key);
+      } else {
+        write_cache_storage(key, value);
+        if (!value.has_value()) forget_reset_key(key);
+      }
     }
-    GpgFrontend::DataObjectOperator::GetInstance().SaveDataObj(
-        drk_key_, QJsonDocument(key_storage_));
 
-    durable_cache_modified_ = false;
+    if (!journal_records.isEmpty()) {
+      GpgFrontend::DataObjectOperator::GetInstance().AppendDataObjJournal(
+          journal_key_, journal_records);
+      journal_file_records_ += journal_records.size();
+    }
+
+    if (journal_compact_needed ||
+        journal_file_records_ > kMaxDurableCacheJournalRecords) {
+      compact_journal();
+    }
+
+    if (key_storage_modified) {
+      GpgFrontend::DataObjectOperator::GetInstance().SaveDataObj(
+          drk_key_, QJsonDocument(key_storage));
+    }
   }
 
  private:
@@ -258,29 +334,187 @@ class CacheManager::Impl : public QObject {
     }
 
     key_storage_ = registered_key_list;
+
+    load_journal();
   }
 
   /**
-   * @brief
+   * @brief replay the records of the journal over the data objects
+   *
+   */
+  void load_journal() {
+    auto records =
+        GpgFrontend::DataObjectOperator::GetInstance().GetDataObjJournal(
+            journal_key_);
+
+    for (const auto& record : records) {
+      const auto object = record.object();
+      const auto key = object["key"].toString();
+      if (key.isEmpty()) continue;
+
+      if (object["removed"].toBool()) {
+        durable_cache_storage_.remove(key);
+      } else {
+        const auto value = object["value"];
+        durable_cache_storage_.insert(
+            key, value.isArray()    ? QJsonDocument(value.toArray())
+                 : value.isObject() ? QJsonDocument(value.toObject())
+                                    : QJsonDocument());
+      }
+      journal_file_keys_.insert(key);
+    }
+
+    // start with an empty journal, this also removes the stale data objects
+    // of the keys removed in the journal
+    if (!records.isEmpty()) compact_journal();
+  }
+
+  /**
+   * @brief write the keys in the journal to their data objects and remove
+   * the journal
+   *
+   */
+  void compact_journal() {
+    FLOG_D("compact the journal of durable cache");
+
+    // copy only the values in the journal out of the storage
+    std::map<QString, QJsonDocument> values;
+    durable_cache_storage_.for_each(
+        [&](const QString& key, const QJsonDocument& value) {
+          if (journal_file_keys_.count(key) > 0) values[key] = value;
+        });
+
+    for (const auto& key : journal_file_keys_) {
+      auto it = values.find(key);
+      if (it != values.end()) {
+        write_cache_storage(key, it->second);
+      } else {
+        write_cache_storage(key, std::nullopt);
+        forget_reset_key(key);
+      }
+    }
+
+    GpgFrontend::DataObjectOperator::GetInstance().RemoveDataObjJournal(
+        journal_key_);
+    journal_file_keys_.clear();
+    journal_file_records_ = 0;
+  }
+
+  /**
+   * @brief write the data object of the key, or remove it if there is no
+   * value
    *
    * @param key
+   * @param value
    */
-  void register_cache_key(const QString& key) {}
+  static void write_cache_storage(const QString& key,
+                                  const std::optional<QJsonDocument>& value) {
+    auto data_object_key = get_data_object_key(key);
+    if (value.has_value()) {
+      GpgFrontend::DataObjectOperator::GetInstance().SaveDataObj(
+          data_object_key, value.value());
+    } else {
+      GpgFrontend::DataObjectOperator::GetInstance().RemoveDataObj(
+          data_object_key);
+    }
+  }
 
-  struct CacheObject {
-    QString value;
-    qint64 ttl;
+  /**
+   * @brief Get the journal record object
+   *
+   * @param key
+   * @param value nothing if the key was removed
+   * @return QJsonDocument
+   */
+  static auto get_journal_record(const QString& key,
+                                 const std::optional<QJsonDocument>& value)
+      -> QJsonDocument {
+    QJsonObject record;
+    record["key"] = key;
+    if (!value.has_value()) {
+      record["removed"] = true;
+    } else if (value->isArray()) {
+      record["value"] = value->array();
+    } else if (value->isObject()) {
+      record["value"] = value->object();
+    }
+    return QJsonDocument(record);
+  }
+
+  /**
+   * @brief mark the key to be written at the next flush
+   *
+   * @param key
+   */
+  void mark_dirty(const QString& key) {
+    std::lock_guard<std::mutex> lock(dirty_lock_);
+    dirty_keys_.insert(key);
 
-    CacheObject(QString value, qint64 ttl)
-        : value(std::move(value)), ttl(ttl) {}
+    if (!durable_cache_storage_.exists(key)) {
+      reset_keys_.insert(key);
+      return;
+    }
+
+    reset_keys_.erase(key);
+    if (!key_storage_.contains(key)) {
+      key_storage_.push_back(key);
+      key_storage_modified_ = true;
+    }
+  }
+
+  /**
+   * @brief if the key was reset and its data object may still be on disk
+   *
+   * @param key
+   * @return true
+   * @return false
+   */
+  auto is_reset_key(const QString& key) -> bool {
+    std::lock_guard<std::mutex> lock(dirty_lock_);
+    return reset_keys_.count(key) > 0;
+  }
+
+  /**
+   * @brief called once the removal of the key has reached its data object
+   *
+   * @param key
+   */
+  void forget_reset_key(const QString& key) {
+    std::lock_guard<std::mutex> lock(dirty_lock_);
+    reset_keys_.erase(key);
+  }
+
+  /**
+   * @brief how the periodic tasks on the io runner reach the impl, the
+   * destructor detaches it under the lock.
+   *
+   */
+  struct TaskGuard {
+    std::mutex lock;
+    Impl* impl = nullptr;
   };
 
-  QCache<QString, CacheObject> runtime_cache_storage_;
+  std::shared_ptr<TaskGuard> task_guard_ = std::make_shared<TaskGuard>();
+  RuntimeCache runtime_cache_storage_;
   ThreadSafeMap<QString, QJsonDocument> durable_cache_storage_;
-  QJsonArray key_storage_;
-  QTimer* flush_timer_;
+  Thread::TaskRunnerPtr flush_runner_;
+  Thread::TaskScheduleID flush_task_id_ = -1;
+  Thread::TaskScheduleID expire_task_id_ = -1;
+  std::mutex flush_lock_;  ///< one flush at a time
   const QString drk_key_ = "__cache_manage_data_register_key_list";
-  std::atomic<bool> durable_cache_modified_{};
+  const QString journal_key_ = "__cache_manage_data_journal";
+
+  std::mutex dirty_lock_;  ///< guards the members below
+  QJsonArray key_storage_;
+  bool key_storage_modified_ = false;
+  std::set<QString> dirty_keys_;    ///< changed since the last flush
+  std::set<QString> journal_keys_;  ///< written to the journal
+  std::set<QString> reset_keys_;    ///< removed, but maybe still on disk
+  bool journal_compact_needed_ = false;
+
+  // only touched by the flush or the load
+  std::set<QString> journal_file_keys_;  ///< keys having records in it
+  qsizetype journal_file_records_ = 0;
 };
 
 CacheManager::CacheManager(int channel)
@@ -307,6 +541,20 @@ auto CacheManager::ResetDurableCache(const QString& key) -> bool {
   return p_->ResetDurableCache(key);
 }
 
+auto CacheManager::GetCacheStats() const -> RuntimeCacheStats {
+  return p_->GetCacheStats();
+}
+
+void CacheManager::SetCacheByteBudget(qint64 byte_budget) {
+  p_->SetCacheByteBudget(byte_budget);
+}
+
+void CacheManager::FlushDurableCache() { p_->FlushCacheStorage(); }
+
+void CacheManager::SetDurableCacheJournal(const QString& key, bool enable) {
+  p_->SetDurableCacheJournal(key, enable);
+}
+
 void CacheManager::SaveCache(const QString& key, QString value, qint64 ttl) {
   p_->SaveCache(key, std::move(value), ttl);
 }
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include "core/function/RuntimeCache.h"
 #include "core/function/basic/GpgFunctionObject.h"
 
 namespace GpgFrontend {
@@ -50,10 +51,12 @@ class GPGFRONTEND_CORE_EXPORT CacheManager
   ~CacheManager() override;
 
   /**
-   * @brief
+   * @brief save the value to the runtime cache, which is safe to use from
+   * any thread. It may be evicted when the cache is over its byte budget.
    *
    * @param key
    * @param value
+   * @param ttl seconds, no expiration if negative
    */
   void SaveCache(const QString& key, QString value, qint64 ttl = -1);
 
@@ -101,6 +104,20 @@ class GPGFRONTEND_CORE_EXPORT CacheManager
    */
   void ResetCache(const QString& key);
 
+  /**
+   * @brief Get the counters of the runtime cache
+   *
+   * @return RuntimeCacheStats
+   */
+  [[nodiscard]] auto GetCacheStats() const -> RuntimeCacheStats;
+
+  /**
+   * @brief Set the byte budget of the runtime cache
+   *
+   * @param byte_budget
+   */
+  void SetCacheByteBudget(qint64 byte_budget);
+
   /**
    * @brief
    *
@@ -110,6 +127,21 @@ class GPGFRONTEND_CORE_EXPORT CacheManager
    */
   auto ResetDurableCache(const QString& key) -> bool;
 
+  /**
+   * @brief write the changes of the durable cache to an append-only journal
+   * instead of the data object of it, for the frequently updated ones
+   *
+   * @param key
+   * @param enable
+   */
+  void SetDurableCacheJournal(const QString& key, bool enable = true);
+
+  /**
+   * @brief write the durable cache changed since the last flush to disk
+   *
+   */
+  void FlushDurableCache();
+
  private:
   class Impl;
   SecureUniquePtr<Impl> p_;
@@ -75,6 +75,20 @@ class GPGFRONTEND_CORE_EXPORT CoreSignalStation : public QObject {
    *
    */
   void SignalCoreFullyLoaded();
+
+  /**
+   * @brief all the secondary key databases are loaded, they keep loading
+   * after the core is fully loaded
+   *
+   */
+  void SignalKeyDatabasesLoaded();
+
+  /**
+   * @brief the keys of the channel are listed after its key list was shown
+   * from the key table snapshot
+   *
+   */
+  void SignalKeyCacheReconciled(int channel);
 };
 
 }  // namespace GpgFrontend
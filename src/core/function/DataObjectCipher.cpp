@@ -0,0 +1,158 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "DataObjectCipher.h"
+
+#include <openssl/rand.h>
+#include <qt-aes/qaesencryption.h>
+
+#include "core/utils/aes/aes_ssl.h"
+
+namespace GpgFrontend {
+
+namespace {
+
+constexpr char kDataObjectMagic[] = {'G', 'F', 'D', 'O'};
+constexpr qsizetype kDataObjectMagicSize = sizeof(kDataObjectMagic);
+constexpr qsizetype kDataObjectHeaderSize = kDataObjectMagicSize + 1;
+
+constexpr quint8 kAesGcmVersion = 1;
+constexpr qsizetype kAesGcmNonceSize = 12;
+constexpr qsizetype kAesGcmTagSize = 16;
+constexpr qsizetype kAesGcmKeySize = 32;
+
+auto DataObjectHeader(quint8 version) -> QByteArray {
+  QByteArray header(kDataObjectMagic, kDataObjectMagicSize);
+  header.append(static_cast<char>(version));
+  return header;
+}
+
+}  // namespace
+
+auto DataObjectCipher::GetFormatVersion(const QByteArray& data) -> quint8 {
+  if (data.size() < kDataObjectHeaderSize ||
+      !data.startsWith(QByteArray(kDataObjectMagic, kDataObjectMagicSize))) {
+    return 0;
+  }
+  return static_cast<quint8>(data[kDataObjectMagicSize]);
+}
+
+AesGcmDataObjectCipher::AesGcmDataObjectCipher(QByteArray key)
+    : key_(std::move(key)) {}
+
+auto AesGcmDataObjectCipher::Version() const -> quint8 {
+  return kAesGcmVersion;
+}
+
+auto AesGcmDataObjectCipher::Encrypt(const QByteArray& plaintext,
+                                     const QByteArray& aad) const
+    -> QByteArray {
+  if (key_.size() != kAesGcmKeySize) return {};
+
+  const auto header = DataObjectHeader(kAesGcmVersion);
+  QByteArray data(kDataObjectHeaderSize + kAesGcmNonceSize + plaintext.size() +
+                      kAesGcmTagSize,
+                  Qt::Uninitialized);
+  std::copy(header.cbegin(), header.cend(), data.begin());
+
+  auto* nonce = reinterpret_cast<uint8_t*>(data.data()) + kDataObjectHeaderSize;
+  auto* ciphertext = nonce + kAesGcmNonceSize;
+  auto* tag = ciphertext + plaintext.size();
+
+  if (RAND_bytes(nonce, kAesGcmNonceSize) != 1) return {};
+
+  // the header is authenticated as well, no one can change the version
+  const auto full_aad = header + aad;
+  if (RawAPI::aes_256_gcm_encrypt(
+          reinterpret_cast<const uint8_t*>(key_.constData()), nonce,
+          kAesGcmNonceSize,
+          reinterpret_cast<const uint8_t*>(full_aad.constData()),
+          static_cast<int>(full_aad.size()),
+          reinterpret_cast<const uint8_t*>(plaintext.constData()),
+          static_cast<int>(plaintext.size()), ciphertext, tag) != 0) {
+    return {};
+  }
+  return data;
+}
+
+auto AesGcmDataObjectCipher::Decrypt(const QByteArray& data,
+                                     const QByteArray& aad) const
+    -> std::optional<QByteArray> {
+  if (key_.size() != kAesGcmKeySize ||
+      GetFormatVersion(data) != kAesGcmVersion ||
+      data.size() < kDataObjectHeaderSize + kAesGcmNonceSize + kAesGcmTagSize) {
+    return {};
+  }
+
+  const auto* nonce = reinterpret_cast<const uint8_t*>(data.constData()) +
+                      kDataObjectHeaderSize;
+  const auto* ciphertext = nonce + kAesGcmNonceSize;
+  const auto ciphertext_size = data.size() - kDataObjectHeaderSize -
+                               kAesGcmNonceSize - kAesGcmTagSize;
+  const auto* tag = ciphertext + ciphertext_size;
+
+  const auto full_aad = data.left(kDataObjectHeaderSize) + aad;
+  QByteArray plaintext(ciphertext_size, Qt::Uninitialized);
+  if (RawAPI::aes_256_gcm_decrypt(
+          reinterpret_cast<const uint8_t*>(key_.constData()), nonce,
+          kAesGcmNonceSize,
+          reinterpret_cast<const uint8_t*>(full_aad.constData()),
+          static_cast<int>(full_aad.size()), ciphertext,
+          static_cast<int>(ciphertext_size),
+          reinterpret_cast<uint8_t*>(plaintext.data()), tag) != 0) {
+    return {};
+  }
+  return plaintext;
+}
+
+LegacyAesEcbDataObjectCipher::LegacyAesEcbDataObjectCipher(QByteArray key)
+    : key_(std::move(key)) {}
+
+auto LegacyAesEcbDataObjectCipher::Version() const -> quint8 { return 0; }
+
+auto LegacyAesEcbDataObjectCipher::Encrypt(const QByteArray& plaintext,
+                                           const QByteArray& /*aad*/) const
+    -> QByteArray {
+  return QAESEncryption(QAESEncryption::AES_256, QAESEncryption::ECB,
+                        QAESEncryption::Padding::ISO)
+      .encode(plaintext, key_);
+}
+
+auto LegacyAesEcbDataObjectCipher::Decrypt(const QByteArray& data,
+                                           const QByteArray& /*aad*/) const
+    -> std::optional<QByteArray> {
+  try {
+    QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
+                              QAESEncryption::Padding::ISO);
+    return encryption.removePadding(encryption.decode(data, key_));
+  } catch (...) {
+    return {};
+  }
+}
+
+}  // namespace GpgFrontend
@@ -0,0 +1,144 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <optional>
+
+#include "core/GpgFrontendCoreExport.h"
+
+namespace GpgFrontend {
+
+/**
+ * @brief The cipher of the data objects on disk. Every object starts with a
+ * header naming the format version of the cipher, except the legacy ones.
+ *
+ */
+class GPGFRONTEND_CORE_EXPORT DataObjectCipher {
+ public:
+  /**
+   * @brief Destroy the Data Object Cipher object
+   *
+   */
+  virtual ~DataObjectCipher() = default;
+
+  /**
+   * @brief the format version in the header, 0 if there is no header
+   *
+   * @return quint8
+   */
+  [[nodiscard]] virtual auto Version() const -> quint8 = 0;
+
+  /**
+   * @brief encrypt the object, the result includes the header
+   *
+   * @param plaintext
+   * @param aad data authenticated along, e.g. the name of the object
+   * @return QByteArray empty on failure
+   */
+  [[nodiscard]] virtual auto Encrypt(const QByteArray& plaintext,
+                                     const QByteArray& aad) const
+      -> QByteArray = 0;
+
+  /**
+   * @brief decrypt the object written by Encrypt()
+   *
+   * @param data
+   * @param aad
+   * @return std::optional<QByteArray> nothing if it cannot be decrypted
+   */
+  [[nodiscard]] virtual auto Decrypt(const QByteArray& data,
+                                     const QByteArray& aad) const
+      -> std::optional<QByteArray> = 0;
+
+  /**
+   * @brief Get the format version in the header of the data, 0 if the data
+   * has no header
+   *
+   * @param data
+   * @return quint8
+   */
+  static auto GetFormatVersion(const QByteArray& data) -> quint8;
+};
+
+/**
+ * @brief AES-256-GCM by OpenSSL EVP, which uses AES-NI where available.
+ * Objects are the header, a random nonce, the ciphertext and the tag.
+ *
+ */
+class GPGFRONTEND_CORE_EXPORT AesGcmDataObjectCipher : public DataObjectCipher {
+ public:
+  /**
+   * @brief Construct a new Aes Gcm Data Object Cipher object
+   *
+   * @param key 32 bytes
+   */
+  explicit AesGcmDataObjectCipher(QByteArray key);
+
+  [[nodiscard]] auto Version() const -> quint8 override;
+
+  [[nodiscard]] auto Encrypt(const QByteArray& plaintext,
+                             const QByteArray& aad) const
+      -> QByteArray override;
+
+  [[nodiscard]] auto Decrypt(const QByteArray& data, const QByteArray& aad)
+      const -> std::optional<QByteArray> override;
+
+ private:
+  QByteArray key_;
+};
+
+/**
+ * @brief AES-256-ECB by QAESEncryption without header, which the data
+ * objects were written with before. Only kept to read them once.
+ *
+ */
+class GPGFRONTEND_CORE_EXPORT LegacyAesEcbDataObjectCipher
+    : public DataObjectCipher {
+ public:
+  /**
+   * @brief Construct a new Legacy Aes Ecb Data Object Cipher object
+   *
+   * @param key 32 bytes
+   */
+  explicit LegacyAesEcbDataObjectCipher(QByteArray key);
+
+  [[nodiscard]] auto Version() const -> quint8 override;
+
+  [[nodiscard]] auto Encrypt(const QByteArray& plaintext,
+                             const QByteArray& aad) const
+      -> QByteArray override;
+
+  [[nodiscard]] auto Decrypt(const QByteArray& data, const QByteArray& aad)
+      const -> std::optional<QByteArray> override;
+
+ private:
+  QByteArray key_;
+};
+
+}  // namespace GpgFrontend
@@ -28,13 +28,58 @@
 
 #include "DataObjectOperator.h"
 
-#include <qt-aes/qaesencryption.h>
+#include <QtEndian>
+#include <cstdio>
+#include <cstring>
+
+#if !defined(_WIN32) && !defined(WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include "core/function/PassphraseGenerator.h"
+#include "core/thread/TaskRunnerGetter.h"
 #include "core/utils/IOUtils.h"
 
 namespace GpgFrontend {
 
+namespace {
+
+/**
+ * @brief how long the written data objects are collected before a batch
+ *
+ */
+constexpr auto kDataObjectFlushDelay = std::chrono::milliseconds(500);
+
+/**
+ * @brief every record of a journal is the size of it and the encrypted data
+ *
+ */
+constexpr qsizetype kJournalRecordSizeLength = sizeof(quint32);
+
+/**
+ * @brief sync the entries of the directory, which makes the renames in it
+ * durable
+ *
+ * @param path
+ * @return true on success
+ */
+auto SyncDirectory(const QString& path) -> bool {
+#if !defined(_WIN32) && !defined(WIN32)
+  const auto fd = open(QFile::encodeName(path).constData(), O_RDONLY);
+  if (fd < 0) return false;
+
+  const auto ret = fsync(fd);
+  close(fd);
+  return ret == 0;
+#else
+  Q_UNUSED(path);
+  return true;
+#endif
+}
+
+}  // namespace
+
 void DataObjectOperator::init_app_secure_key() {
   WriteFile(app_secure_key_path_,
             PassphraseGenerator::GetInstance().Generate(256).toUtf8());
@@ -43,7 +88,9 @@ void DataObjectOperator::init_app_secure_key() {
 }
 
 DataObjectOperator::DataObjectOperator(int channel)
-    : SingletonFunctionObject<DataObjectOperator>(channel) {
+    : SingletonFunctionObject<DataObjectOperator>(channel),
+      flush_runner_(Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
+          Thread::TaskRunnerGetter::kTaskRunnerType_IO)) {
   if (!QDir(app_secure_path_).exists()) QDir(app_secure_path_).mkpath(".");
   if (!QFileInfo(app_secure_key_path_).exists()) init_app_secure_key();
 
@@ -56,9 +103,33 @@ DataObjectOperator::DataObjectOperator(int channel)
 
   hash_key_ = QCryptographicHash::hash(key, QCryptographicHash::Sha256);
 
+  // the gcm key is derived, so that it never equals the one of ecb
+  cipher_ = SecureCreateSharedObject<AesGcmDataObjectCipher>(
+      QCryptographicHash::hash(hash_key_ + "GpgFrontend Data Object GCM",
+                               QCryptographicHash::Sha256));
+  legacy_cipher_ =
+      SecureCreateSharedObject<LegacyAesEcbDataObjectCipher>(hash_key_);
+
   if (!QDir(app_data_objs_path_).exists()) {
     QDir(app_data_objs_path_).mkpath(".");
   }
+
+  task_guard_->op = this;
+}
+
+DataObjectOperator::~DataObjectOperator() {
+  {
+    std::lock_guard<std::mutex> lock(pending_lock_);
+    if (flush_task_id_ >= 0) flush_runner_->CancelScheduleTask(flush_task_id_);
+  }
+
+  {
+    // waits for a flush task running on the io runner right now
+    std::lock_guard<std::mutex> lock(task_guard_->lock);
+    task_guard_->op = nullptr;
+  }
+
+  FlushDataObjs();
 }
 
 auto DataObjectOperator::SaveDataObj(const QString& key,
@@ -73,82 +144,296 @@ auto DataObjectOperator::SaveDataObj(const QString& key,
             QCryptographicHash::Sha256)
             .toHex();
   } else {
-    hash_obj_key = QCryptographicHash::hash(hash_key_ + key.toUtf8(),
-                                            QCryptographicHash::Sha256)
-                       .toHex();
+    hash_obj_key = get_hash_obj_key(key).toLatin1();
   }
 
-  const auto target_obj_path = app_data_objs_path_ + "/" + hash_obj_key;
-  auto encoded_data =
-      QAESEncryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                     QAESEncryption::Padding::ISO)
-          .encode(value.toJson(), hash_key_);
-
-  // recreate if not exists
-  if (!QDir(app_data_objs_path_).exists()) {
-    QDir(app_data_objs_path_).mkpath(".");
+  std::lock_guard<std::mutex> flush_lock(flush_lock_);
+  {
+    // the pending one is older
+    std::lock_guard<std::mutex> lock(pending_lock_);
+    pending_objs_.remove(hash_obj_key);
   }
 
-  if (!WriteFile(target_obj_path, encoded_data)) {
+  if (!write_data_object(hash_obj_key, value)) {
     LOG_W() << "failed to write data object to disk: " << key;
   }
   return key.isEmpty() ? hash_obj_key : QString();
 }
 
-auto DataObjectOperator::GetDataObject(const QString& key)
-    -> std::optional<QJsonDocument> {
-  try {
-    auto hash_obj_key = QCryptographicHash::hash(hash_key_ + key.toUtf8(),
-                                                 QCryptographicHash::Sha256)
-                            .toHex();
-
-    const auto obj_path = app_data_objs_path_ + "/" + hash_obj_key;
-    if (!QFileInfo(obj_path).exists()) {
-      LOG_W() << "data object not found from disk, key: " << key;
-      return {};
+void DataObjectOperator::SaveDataObjLater(const QString& key,
+                                          const QJsonDocument& value) {
+  const auto hash_obj_key = get_hash_obj_key(key);
+
+  std::lock_guard<std::mutex> lock(pending_lock_);
+  pending_objs_.insert(hash_obj_key, value);
+  if (flush_task_id_ >= 0) return;
+
+  flush_task_id_ = flush_runner_->PostScheduleTask(
+      new Thread::Task(
+          [guard = task_guard_](const DataObjectPtr&) -> int {
+            std::lock_guard<std::mutex> lock(guard->lock);
+            if (guard->op != nullptr) guard->op->FlushDataObjs();
+            return 0;
+          },
+          "flush_data_objects"),
+      kDataObjectFlushDelay);
+}
+
+void DataObjectOperator::FlushDataObjs() {
+  std::lock_guard<std::mutex> flush_lock(flush_lock_);
+
+  // the objects stay visible to the readers until they are on disk
+  QMap<QString, QJsonDocument> objs;
+  {
+    std::lock_guard<std::mutex> lock(pending_lock_);
+    objs = pending_objs_;
+    flush_task_id_ = -1;
+  }
+  if (objs.isEmpty()) return;
+
+  LOG_D() << "write pending data objects to disk, count: " << objs.size();
+
+  // the objects are renamed in place unsynced, one sync of the directory
+  // then makes the whole batch durable
+  for (auto it = objs.cbegin(); it != objs.cend(); ++it) {
+    if (!write_data_object(it.key(), it.value(), false)) {
+      LOG_W() << "failed to write data object to disk: " << it.key();
     }
+  }
 
-    QByteArray encoded_data;
-    if (!ReadFile(obj_path, encoded_data)) {
-      LOG_W() << "failed to read data object from disk, key: " << key;
-      return {};
+  if (!SyncDirectory(app_data_objs_path_)) {
+    LOG_W() << "failed to sync data object directory: " << app_data_objs_path_;
+  }
+
+  std::lock_guard<std::mutex> lock(pending_lock_);
+  for (auto it = objs.cbegin(); it != objs.cend(); ++it) {
+    // saved again while writing, leave it to the next batch
+    if (pending_objs_.value(it.key()) == it.value()) {
+      pending_objs_.remove(it.key());
     }
+  }
+}
+
+auto DataObjectOperator::RemoveDataObj(const QString& key) -> bool {
+  const auto hash_obj_key = get_hash_obj_key(key);
+
+  std::lock_guard<std::mutex> flush_lock(flush_lock_);
+  bool removed = false;
+  {
+    std::lock_guard<std::mutex> lock(pending_lock_);
+    removed = pending_objs_.remove(hash_obj_key) > 0;
+  }
+  return QFile::remove(app_data_objs_path_ + "/" + hash_obj_key) || removed;
+}
+
+auto DataObjectOperator::AppendDataObjJournal(
+    const QString& key, const QContainer<QJsonDocument>& records) -> bool {
+  const auto hash_obj_key = get_hash_obj_key(key);
+  const auto aad = (hash_obj_key + ".journal").toUtf8();
+
+  QByteArray data;
+  for (const auto& record : records) {
+    auto encoded_record = cipher_->Encrypt(record.toJson(), aad);
+    if (encoded_record.isEmpty()) return false;
+
+    const auto size =
+        qToBigEndian(static_cast<quint32>(encoded_record.size()));
+    data.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    data.append(encoded_record);
+  }
+  if (data.isEmpty()) return true;
+
+  // recreate if not exists
+  if (!QDir(app_data_objs_path_).exists()) {
+    QDir(app_data_objs_path_).mkpath(".");
+  }
 
-    QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                              QAESEncryption::Padding::ISO);
+  // one write of all the records
+  QFile file(app_data_objs_path_ + "/" + hash_obj_key + ".journal");
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) return false;
+  const auto written = file.write(data);
+  file.close();
+  return written == data.size();
+}
 
-    auto decoded_data =
-        encryption.removePadding(encryption.decode(encoded_data, hash_key_));
+auto DataObjectOperator::GetDataObjJournal(const QString& key)
+    -> QContainer<QJsonDocument> {
+  const auto hash_obj_key = get_hash_obj_key(key);
+  const auto aad = (hash_obj_key + ".journal").toUtf8();
 
-    return QJsonDocument::fromJson(decoded_data);
-  } catch (...) {
-    LOG_W() << "failed to get data object:" << key << " caught exception.";
+  QByteArray data;
+  const auto journal_path =
+      app_data_objs_path_ + "/" + hash_obj_key + ".journal";
+  if (!QFileInfo(journal_path).exists() || !ReadFile(journal_path, data)) {
     return {};
   }
+
+  QContainer<QJsonDocument> records;
+  qsizetype offset = 0;
+  while (data.size() - offset >= kJournalRecordSizeLength) {
+    quint32 size = 0;
+    std::memcpy(&size, data.constData() + offset, sizeof(size));
+    size = qFromBigEndian(size);
+    offset += kJournalRecordSizeLength;
+
+    if (data.size() - offset < static_cast<qsizetype>(size)) break;
+
+    auto record = cipher_->Decrypt(data.mid(offset, size), aad);
+    if (!record) break;
+
+    records.append(QJsonDocument::fromJson(*record));
+    offset += size;
+  }
+
+  if (offset != data.size()) {
+    LOG_W() << "dropped the torn end of the data object journal: " << key;
+  }
+  return records;
+}
+
+auto DataObjectOperator::RemoveDataObjJournal(const QString& key) -> bool {
+  return QFile::remove(app_data_objs_path_ + "/" + get_hash_obj_key(key) +
+                       ".journal");
+}
+
+auto DataObjectOperator::GetDataObject(const QString& key)
+    -> std::optional<QJsonDocument> {
+  auto hash_obj_key = get_hash_obj_key(key);
+
+  {
+    std::lock_guard<std::mutex> lock(pending_lock_);
+    auto it = pending_objs_.constFind(hash_obj_key);
+    if (it != pending_objs_.cend()) return it.value();
+  }
+
+  const auto obj_path = app_data_objs_path_ + "/" + hash_obj_key;
+  if (!QFileInfo(obj_path).exists()) {
+    LOG_W() << "data object not found from disk, key: " << key;
+    return {};
+  }
+
+  auto value = read_data_object(hash_obj_key);
+  if (!value) LOG_W() << "failed to read data object from disk, key: " << key;
+  return value;
 }
 
 auto DataObjectOperator::GetDataObjectByRef(const QString& _ref)
     -> std::optional<QJsonDocument> {
   if (_ref.size() != 64) return {};
 
-  try {
-    const auto& hash_obj_key = _ref;
-    const auto obj_path = app_data_objs_path_ + "/" + hash_obj_key;
+  const auto& hash_obj_key = _ref;
 
-    if (!QFileInfo(obj_path).exists()) return {};
+  {
+    std::lock_guard<std::mutex> lock(pending_lock_);
+    auto it = pending_objs_.constFind(hash_obj_key);
+    if (it != pending_objs_.cend()) return it.value();
+  }
 
-    QByteArray encoded_data;
-    if (!ReadFile(obj_path, encoded_data)) return {};
+  const auto obj_path = app_data_objs_path_ + "/" + hash_obj_key;
 
-    QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                              QAESEncryption::Padding::ISO);
+  if (!QFileInfo(obj_path).exists()) return {};
+  return read_data_object(hash_obj_key);
+}
 
-    auto decoded_data =
-        encryption.removePadding(encryption.decode(encoded_data, hash_key_));
+auto DataObjectOperator::SealData(const QByteArray& data,
+                                  const QByteArray& aad) -> QByteArray {
+  return cipher_->Encrypt(data, aad);
+}
 
-    return QJsonDocument::fromJson(decoded_data);
-  } catch (...) {
-    return {};
+auto DataObjectOperator::UnsealData(const QByteArray& data,
+                                    const QByteArray& aad)
+    -> std::optional<QByteArray> {
+  return cipher_->Decrypt(data, aad);
+}
+
+auto DataObjectOperator::read_data_object(const QString& hash_obj_key)
+    -> std::optional<QJsonDocument> {
+  const auto obj_path = app_data_objs_path_ + "/" + hash_obj_key;
+
+  QByteArray encoded_data;
+  if (!ReadFile(obj_path, encoded_data)) return {};
+
+  const auto aad = hash_obj_key.toUtf8();
+  if (DataObjectCipher::GetFormatVersion(encoded_data) == cipher_->Version()) {
+    auto decoded_data = cipher_->Decrypt(encoded_data, aad);
+    if (!decoded_data) {
+      LOG_W() << "data object failed authentication: " << hash_obj_key;
+      return {};
+    }
+    return QJsonDocument::fromJson(*decoded_data);
+  }
+
+  auto decoded_data = legacy_cipher_->Decrypt(encoded_data, aad);
+  if (!decoded_data) return {};
+
+  auto value = QJsonDocument::fromJson(*decoded_data);
+  if (value.isNull()) return value;
+
+  // migrate the legacy object once it is read correctly, unless a newer
+  // value was saved since it was read
+  std::lock_guard<std::mutex> flush_lock(flush_lock_);
+  {
+    std::lock_guard<std::mutex> lock(pending_lock_);
+    if (pending_objs_.contains(hash_obj_key)) return value;
+  }
+
+  QByteArray current_data;
+  if (!ReadFile(obj_path, current_data) || current_data != encoded_data) {
+    return value;
+  }
+
+  if (!write_data_object(hash_obj_key, value)) {
+    LOG_W() << "failed to migrate legacy data object: " << hash_obj_key;
+  }
+  return value;
+}
+
+auto DataObjectOperator::write_data_object(const QString& hash_obj_key,
+                                           const QJsonDocument& value,
+                                           bool sync) -> bool {
+  auto encoded_data = cipher_->Encrypt(value.toJson(), hash_obj_key.toUtf8());
+  if (encoded_data.isEmpty()) return false;
+
+  // recreate if not exists
+  if (!QDir(app_data_objs_path_).exists()) {
+    QDir(app_data_objs_path_).mkpath(".");
+  }
+
+  const auto obj_path = app_data_objs_path_ + "/" + hash_obj_key;
+
+#if !defined(_WIN32) && !defined(WIN32)
+  if (!sync) {
+    // the same as QSaveFile, but the caller syncs the directory later
+    const auto tmp_path = obj_path + ".tmp";
+    QFile file(tmp_path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+    const auto written = file.write(encoded_data) == encoded_data.size();
+    file.close();
+    if (!written ||
+        std::rename(QFile::encodeName(tmp_path).constData(),
+                    QFile::encodeName(obj_path).constData()) != 0) {
+      QFile::remove(tmp_path);
+      return false;
+    }
+    return true;
   }
+#else
+  Q_UNUSED(sync);
+#endif
+
+  // QSaveFile writes a temporary file, syncs it and renames it over the old
+  QSaveFile file(obj_path);
+  if (!file.open(QIODevice::WriteOnly)) return false;
+  if (file.write(encoded_data) != encoded_data.size()) {
+    file.cancelWriting();
+  }
+  return file.commit();
+}
+
+auto DataObjectOperator::get_hash_obj_key(const QString& key) -> QString {
+  return QCryptographicHash::hash(hash_key_ + key.toUtf8(),
+                                  QCryptographicHash::Sha256)
+      .toHex();
 }
-}  // namespace GpgFrontend
\ No newline at end of file
+}  // namespace GpgFrontend
@@ -28,10 +28,13 @@
 
 #pragma once
 
+#include <mutex>
 #include <optional>
 
+#include "core/function/DataObjectCipher.h"
 #include "core/function/GlobalSettingStation.h"
 #include "core/function/basic/GpgFunctionObject.h"
+#include "core/thread/TaskRunner.h"
 
 namespace GpgFrontend {
 
@@ -46,12 +49,92 @@ class GPGFRONTEND_CORE_EXPORT DataObjectOperator
   explicit DataObjectOperator(
       int channel = SingletonFunctionObject::GetDefaultChannel());
 
+  /**
+   * @brief Destroy the Data Object Operator object, the pending data objects
+   * are written before
+   *
+   */
+  ~DataObjectOperator() override;
+
   auto SaveDataObj(const QString &_key, const QJsonDocument &value) -> QString;
 
+  /**
+   * @brief save the data object later in a batch with the others, writes of
+   * the same key before the batch are coalesced. It is visible to the readers
+   * at once.
+   *
+   * @param _key
+   * @param value
+   */
+  void SaveDataObjLater(const QString &_key, const QJsonDocument &value);
+
+  /**
+   * @brief write all the pending data objects to disk
+   *
+   */
+  void FlushDataObjs();
+
+  /**
+   * @brief remove the data object, the journal of it is kept
+   *
+   * @param _key
+   * @return true if it existed
+   */
+  auto RemoveDataObj(const QString &_key) -> bool;
+
+  /**
+   * @brief append the records to the journal of the data object. Every
+   * record is encrypted on its own, so the journal is never rewritten.
+   *
+   * @param _key
+   * @param records
+   * @return true
+   * @return false
+   */
+  auto AppendDataObjJournal(const QString &_key,
+                            const QContainer<QJsonDocument> &records) -> bool;
+
+  /**
+   * @brief read the records of the journal in the order of appending. A torn
+   * record at the end and anything after it is dropped.
+   *
+   * @param _key
+   * @return QContainer<QJsonDocument>
+   */
+  auto GetDataObjJournal(const QString &_key) -> QContainer<QJsonDocument>;
+
+  /**
+   * @brief remove the journal of the data object
+   *
+   * @param _key
+   * @return true if it existed
+   */
+  auto RemoveDataObjJournal(const QString &_key) -> bool;
+
   auto GetDataObject(const QString &_key) -> std::optional<QJsonDocument>;
 
   auto GetDataObjectByRef(const QString &_ref) -> std::optional<QJsonDocument>;
 
+  /**
+   * @brief encrypt data kept outside of the data objects with the cipher and
+   * the key of them
+   *
+   * @param data
+   * @param aad data authenticated along, e.g. the name of the file
+   * @return QByteArray empty on failure
+   */
+  auto SealData(const QByteArray &data, const QByteArray &aad) -> QByteArray;
+
+  /**
+   * @brief decrypt data written by SealData()
+   *
+   * @param data
+   * @param aad
+   * @return std::optional<QByteArray> nothing if it cannot be decrypted
+   */
+  auto UnsealData(const QByteArray &data, const QByteArray &aad)
+      -> std::optional<QByteArray>;
+
  private:
   /**
    * @brief init the secure key of application data object
@@ -59,6 +142,49 @@ class GPGFRONTEND_CORE_EXPORT DataObjectOperator
    */
   void init_app_secure_key();
 
+  /**
+   * @brief read and decrypt the data object, the ones written by the legacy
+   * cipher are written again by the current one if nothing newer was saved
+   * meanwhile. Must not be called with flush_lock_ held.
+   *
+   * @param hash_obj_key
+   * @return std::optional<QJsonDocument>
+   */
+  auto read_data_object(const QString &hash_obj_key)
+      -> std::optional<QJsonDocument>;
+
+  /**
+   * @brief encrypt and write the data object, it replaces the old one
+   * atomically
+   *
+   * @param hash_obj_key
+   * @param value
+   * @param sync if false, the caller syncs the directory of the data objects
+   * afterwards, e.g. once for a batch. Windows always syncs.
+   * @return true
+   * @return false
+   */
+  auto write_data_object(const QString &hash_obj_key,
+                         const QJsonDocument &value, bool sync = true) -> bool;
+
+  /**
+   * @brief Get the hash key of the data object
+   *
+   * @param key
+   * @return QString
+   */
+  auto get_hash_obj_key(const QString &key) -> QString;
+
+  /**
+   * @brief how the scheduled flush task reaches the operator, the destructor
+   * detaches it under the lock
+   *
+   */
+  struct TaskGuard {
+    std::mutex lock;
+    DataObjectOperator *op = nullptr;
+  };
+
   GlobalSettingStation &global_setting_station_ =
       GlobalSettingStation::GetInstance();  ///< GlobalSettingStation
   QString app_secure_path_ =
@@ -71,6 +197,15 @@ class GPGFRONTEND_CORE_EXPORT DataObjectOperator
       global_setting_station_.GetAppDataPath() + "/data_objs";
 
   QByteArray hash_key_;  ///< Hash key
+  std::shared_ptr<DataObjectCipher> cipher_;         ///< AES-256-GCM
+  std::shared_ptr<DataObjectCipher> legacy_cipher_;  ///< AES-256-ECB
+
+  std::mutex pending_lock_;  ///< guards the pending objects and the flush task
+  QMap<QString, QJsonDocument> pending_objs_;  ///< hash key to data object
+  std::shared_ptr<Thread::TaskRunner> flush_runner_;  ///< the io runner
+  std::shared_ptr<TaskGuard> task_guard_ = std::make_shared<TaskGuard>();
+  Thread::TaskScheduleID flush_task_id_ = -1;
+  std::mutex flush_lock_;  ///< one writer of the files at a time
 };
 
 }  // namespace GpgFrontend
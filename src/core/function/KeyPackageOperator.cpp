@@ -28,20 +28,288 @@
 
 #include "KeyPackageOperator.h"
 
+#include <openssl/rand.h>
 #include <qglobal.h>
 #include <qt-aes/qaesencryption.h>
 
+#include <QtEndian>
+#include <cstring>
+
 #include "core/function/KeyPackageOperator.h"
 #include "core/function/PassphraseGenerator.h"
 #include "core/function/gpg/GpgKeyImportExporter.h"
+#include "core/model/GpgData.h"
 #include "core/model/GpgImportInformation.h"
 #include "core/typedef/CoreTypedef.h"
 #include "core/utils/AsyncUtils.h"
 #include "core/utils/GpgUtils.h"
 #include "core/utils/IOUtils.h"
+#include "core/utils/aes/aes_ssl.h"
 
 namespace GpgFrontend {
 
+namespace {
+
+/**
+ * @brief The key package is a header and a sequence of chunks:
+ *
+ * header: "GFKP" | version (1) | nonce prefix (8)
+ * chunk:  flags (1) | size (4, big endian) | ciphertext (size) | tag (16)
+ *
+ * Every chunk is sealed by AES-256-GCM with the nonce prefix and the index
+ * of the chunk as iv. The header, the index and the flags are authenticated
+ * along, so chunks cannot be reordered, and a package missing its final
+ * chunk is detected as truncated.
+ */
+constexpr char kKeyPackageMagic[] = {'G', 'F', 'K', 'P'};
+constexpr qsizetype kKeyPackageMagicSize = sizeof(kKeyPackageMagic);
+constexpr quint8 kKeyPackageVersion = 2;
+constexpr qsizetype kKeyPackageNoncePrefixSize = 8;
+constexpr qsizetype kKeyPackageHeaderSize =
+    kKeyPackageMagicSize + 1 + kKeyPackageNoncePrefixSize;
+
+constexpr qsizetype kKeyPackageChunkSize = 64 * 1024;
+constexpr qsizetype kKeyPackageChunkHeaderSize = 1 + sizeof(quint32);
+constexpr qsizetype kKeyPackageTagSize = 16;
+constexpr quint8 kKeyPackageFinalChunk = 0x01;
+
+auto KeyPackageKey(const QByteArray& phrase) -> QByteArray {
+  return QCryptographicHash::hash("GpgFrontend Key Package" + phrase,
+                                  QCryptographicHash::Sha256);
+}
+
+auto KeyPackageIV(const QByteArray& header, quint32 index) -> QByteArray {
+  const auto be_index = qToBigEndian(index);
+  return header.right(kKeyPackageNoncePrefixSize) +
+         QByteArray(reinterpret_cast<const char*>(&be_index),
+                    sizeof(be_index));
+}
+
+auto KeyPackageAAD(const QByteArray& header, quint32 index,
+                   quint8 flags) -> QByteArray {
+  const auto be_index = qToBigEndian(index);
+  return header +
+         QByteArray(reinterpret_cast<const char*>(&be_index),
+                    sizeof(be_index)) +
+         QByteArray(1, static_cast<char>(flags));
+}
+
+/**
+ * @brief seals what is written into chunks of the key package
+ *
+ */
+class KeyPackageWriter {
+ public:
+  KeyPackageWriter(QIODevice* device, QByteArray key)
+      : device_(device), key_(std::move(key)) {
+    buffer_.reserve(kKeyPackageChunkSize);
+  }
+
+  auto WriteHeader() -> bool {
+    QByteArray nonce_prefix(kKeyPackageNoncePrefixSize, Qt::Uninitialized);
+    if (RAND_bytes(reinterpret_cast<uint8_t*>(nonce_prefix.data()),
+                   static_cast<int>(nonce_prefix.size())) != 1) {
+      return false;
+    }
+
+    header_ = QByteArray(kKeyPackageMagic, kKeyPackageMagicSize) +
+              QByteArray(1, static_cast<char>(kKeyPackageVersion)) +
+              nonce_prefix;
+    return device_->write(header_) == header_.size();
+  }
+
+  auto Write(const void* data, size_t size) -> ssize_t {
+    const auto* bytes = static_cast<const char*>(data);
+    auto left = static_cast<qsizetype>(size);
+    while (left > 0) {
+      const auto n = std::min(left, kKeyPackageChunkSize - buffer_.size());
+      buffer_.append(bytes, n);
+      bytes += n;
+      left -= n;
+
+      if (buffer_.size() == kKeyPackageChunkSize && !seal_chunk(0)) {
+        return -1;
+      }
+    }
+    return static_cast<ssize_t>(size);
+  }
+
+  auto Finish() -> bool { return seal_chunk(kKeyPackageFinalChunk); }
+
+ private:
+  QIODevice* device_;
+  QByteArray key_;
+  QByteArray header_;
+  QByteArray buffer_;
+  QByteArray sealed_;
+  quint32 index_ = 0;
+
+  auto seal_chunk(quint8 flags) -> bool {
+    const auto size = buffer_.size();
+    sealed_.resize(kKeyPackageChunkHeaderSize + size + kKeyPackageTagSize);
+
+    const auto be_size = qToBigEndian(static_cast<quint32>(size));
+    sealed_[0] = static_cast<char>(flags);
+    std::memcpy(sealed_.data() + 1, &be_size, sizeof(be_size));
+
+    auto* ciphertext =
+        reinterpret_cast<uint8_t*>(sealed_.data()) + kKeyPackageChunkHeaderSize;
+    const auto iv = KeyPackageIV(header_, index_);
+    const auto aad = KeyPackageAAD(header_, index_, flags);
+    if (RawAPI::aes_256_gcm_encrypt(
+            reinterpret_cast<const uint8_t*>(key_.constData()),
+            reinterpret_cast<const uint8_t*>(iv.constData()),
+            static_cast<int>(iv.size()),
+            reinterpret_cast<const uint8_t*>(aad.constData()),
+            static_cast<int>(aad.size()),
+            reinterpret_cast<const uint8_t*>(buffer_.constData()),
+            static_cast<int>(size), ciphertext, ciphertext + size) != 0) {
+      return false;
+    }
+
+    index_++;
+    buffer_.clear();
+    return device_->write(sealed_) == sealed_.size();
+  }
+};
+
+/**
+ * @brief opens the chunks of the key package one by one as they are read
+ *
+ */
+class KeyPackageReader {
+ public:
+  KeyPackageReader(QIODevice* device, QByteArray key)
+      : device_(device), key_(std::move(key)) {}
+
+  auto ReadHeader() -> bool {
+    header_ = device_->read(kKeyPackageHeaderSize);
+    return IsKeyPackage(header_);
+  }
+
+  /**
+   * @brief authenticate every chunk through the final one, then rewind to
+   * the first chunk for Read().
+   *
+   * @return false if a chunk is forged or the package is truncated
+   */
+  auto Verify() -> bool {
+    const auto start = device_->pos();
+    while (!final_) {
+      if (!open_chunk()) return false;
+    }
+
+    plaintext_.clear();
+    offset_ = 0;
+    index_ = 0;
+    final_ = false;
+    return device_->seek(start);
+  }
+
+  auto Read(void* data, size_t size) -> ssize_t {
+    while (offset_ == plaintext_.size()) {
+      if (final_) return 0;
+      if (!open_chunk()) {
+        errno = EIO;
+        return -1;
+      }
+    }
+
+    const auto n =
+        std::min(static_cast<qsizetype>(size), plaintext_.size() - offset_);
+    std::memcpy(data, plaintext_.constData() + offset_, n);
+    offset_ += n;
+    return static_cast<ssize_t>(n);
+  }
+
+  static auto IsKeyPackage(const QByteArray& header) -> bool {
+    return header.size() == kKeyPackageHeaderSize &&
+           header.startsWith(
+               QByteArray(kKeyPackageMagic, kKeyPackageMagicSize)) &&
+           static_cast<quint8>(header[kKeyPackageMagicSize]) ==
+               kKeyPackageVersion;
+  }
+
+ private:
+  QIODevice* device_;
+  QByteArray key_;
+  QByteArray header_;
+  QByteArray sealed_;
+  QByteArray plaintext_;
+  qsizetype offset_ = 0;
+  quint32 index_ = 0;
+  bool final_ = false;
+
+  auto open_chunk() -> bool {
+    const auto chunk_header = device_->read(kKeyPackageChunkHeaderSize);
+    // truncated before the final chunk
+    if (chunk_header.size() != kKeyPackageChunkHeaderSize) return false;
+
+    const auto flags = static_cast<quint8>(chunk_header[0]);
+    quint32 size = 0;
+    std::memcpy(&size, chunk_header.constData() + 1, sizeof(size));
+    size = qFromBigEndian(size);
+    if (size > kKeyPackageChunkSize) return false;
+
+    sealed_ = device_->read(size + kKeyPackageTagSize);
+    if (sealed_.size() != static_cast<qsizetype>(size) + kKeyPackageTagSize) {
+      return false;
+    }
+
+    plaintext_.resize(size);
+    offset_ = 0;
+
+    const auto* ciphertext = reinterpret_cast<const uint8_t*>(sealed_.data());
+    const auto iv = KeyPackageIV(header_, index_);
+    const auto aad = KeyPackageAAD(header_, index_, flags);
+    if (RawAPI::aes_256_gcm_decrypt(
+            reinterpret_cast<const uint8_t*>(key_.constData()),
+            reinterpret_cast<const uint8_t*>(iv.constData()),
+            static_cast<int>(iv.size()),
+            reinterpret_cast<const uint8_t*>(aad.constData()),
+            static_cast<int>(aad.size()), ciphertext, static_cast<int>(size),
+            reinterpret_cast<uint8_t*>(plaintext_.data()),
+            ciphertext + size) != 0) {
+      LOG_W() << "chunk of the key package failed authentication: " << index_;
+      return false;
+    }
+
+    index_++;
+    final_ = (flags & kKeyPackageFinalChunk) != 0;
+    return true;
+  }
+};
+
+/**
+ * @brief import a key package written by AES-256-ECB without header
+ *
+ * @param encrypted_data
+ * @param phrase
+ * @param channel
+ * @return std::shared_ptr<GpgImportInformation>
+ */
+auto ImportLegacyKeyPackage(const QByteArray& encrypted_data,
+                            const QByteArray& phrase, int channel)
+    -> std::shared_ptr<GpgImportInformation> {
+  auto hash_key = QCryptographicHash::hash(phrase, QCryptographicHash::Sha256);
+
+  QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
+                            QAESEncryption::Padding::ISO);
+
+  auto decoded =
+      encryption.removePadding(encryption.decode(encrypted_data, hash_key));
+  auto key_data = QByteArray::fromBase64(decoded);
+  if (!key_data.startsWith(PGP_PUBLIC_KEY_BEGIN) &&
+      !key_data.startsWith(PGP_PRIVATE_KEY_BEGIN)) {
+    return nullptr;
+  }
+
+  return GpgKeyImportExporter::GetInstance(channel).ImportKey(
+      GFBuffer(key_data));
+}
+
+}  // namespace
+
 auto KeyPackageOperator::GeneratePassphrase(const QString& phrase_path,
                                             QString& phrase) -> bool {
   phrase = PassphraseGenerator::GetInstance().Generate(256);
@@ -55,34 +323,21 @@ void KeyPackageOperator::GenerateKeyPackage(const QString& key_package_path,
                                             const KeyArgsList& keys,
                                             QString& phrase, bool secret,
                                             const OperationCallback& cb) {
-  GpgKeyImportExporter::GetInstance(channel).ExportAllKeys(
-      keys, secret, true, [=](GpgError err, const DataObjectPtr& data_obj) {
+  RunGpgOperaAsync(
+      [=](const DataObjectPtr&) -> GpgError {
+        return WriteKeyPackage(key_package_path, channel, keys, phrase,
+                               secret);
+      },
+      [=](GpgError err, const DataObjectPtr& data_obj) {
         if (CheckGpgError(err) != GPG_ERR_NO_ERROR) {
           LOG_W() << "export keys error, reason: "
                   << DescribeGpgErrCode(err).second;
           cb(-1, data_obj);
           return;
         }
-
-        if (CheckGpgError(err) == GPG_ERR_USER_1 || data_obj == nullptr ||
-            !data_obj->Check<GFBuffer>()) {
-          cb(-1, data_obj);
-          return;
-        }
-
-        auto gf_buffer = ExtractParams<GFBuffer>(data_obj, 0);
-
-        auto data = gf_buffer.ConvertToQByteArray().toBase64();
-        auto hash_key = QCryptographicHash::hash(phrase.toUtf8(),
-                                                 QCryptographicHash::Sha256);
-        QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                                  QAESEncryption::Padding::ISO);
-        auto encoded_data = encryption.encode(data, hash_key);
-
-        cb(WriteFile(key_package_path, encoded_data) ? 0 : -1,
-           TransferParams());
-        return;
-      });
+        cb(0, TransferParams());
+      },
+      "gpgme_op_export_keys", "2.1.0");
 }
 
 void KeyPackageOperator::ImportKeyPackage(const QString& key_package_path,
@@ -91,14 +346,6 @@ void KeyPackageOperator::ImportKeyPackage(const QString& key_package_path,
                                           const OperationCallback& cb) {
   RunOperaAsync(
       [=](const DataObjectPtr& data_object) -> GFError {
-        QByteArray encrypted_data;
-        ReadFile(key_package_path, encrypted_data);
-
-        if (encrypted_data.isEmpty()) {
-          LOG_W() << "failed to read key package: " << key_package_path;
-          return -1;
-        };
-
         QByteArray passphrase;
         ReadFile(phrase_path, passphrase);
         if (passphrase.size() != 256) {
@@ -106,24 +353,8 @@ void KeyPackageOperator::ImportKeyPackage(const QString& key_package_path,
           return -1;
         }
 
-        auto hash_key =
-            QCryptographicHash::hash(passphrase, QCryptographicHash::Sha256);
-        auto encoded = encrypted_data;
-
-        QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                                  QAESEncryption::Padding::ISO);
-
-        auto decoded =
-            encryption.removePadding(encryption.decode(encoded, hash_key));
-        auto key_data = QByteArray::fromBase64(decoded);
-        if (!key_data.startsWith(PGP_PUBLIC_KEY_BEGIN) &&
-            !key_data.startsWith(PGP_PRIVATE_KEY_BEGIN)) {
-          return -1;
-        }
-
         auto import_info_ptr =
-            GpgKeyImportExporter::GetInstance(channel).ImportKey(
-                GFBuffer(key_data));
+            ReadKeyPackage(key_package_path, passphrase, channel);
         if (import_info_ptr == nullptr) return GPG_ERR_NO_DATA;
 
         auto import_info = *import_info_ptr;
@@ -133,6 +364,66 @@ void KeyPackageOperator::ImportKeyPackage(const QString& key_package_path,
       cb, "import_key_package");
 }
 
+auto KeyPackageOperator::WriteKeyPackage(const QString& key_package_path,
+                                         int channel, const KeyArgsList& keys,
+                                         const QString& phrase,
+                                         bool secret) -> GpgError {
+  QSaveFile file(key_package_path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    LOG_W() << "failed to open key package: " << key_package_path;
+    return GPG_ERR_EIO;
+  }
+
+  KeyPackageWriter writer(&file, KeyPackageKey(phrase.toUtf8()));
+  if (!writer.WriteHeader()) return GPG_ERR_EIO;
+
+  // the exported keys go straight through the cipher into the file
+  GpgData data_out({}, [&writer](const void* buffer, size_t size) {
+    return writer.Write(buffer, size);
+  });
+
+  auto err = GpgKeyImportExporter::GetInstance(channel).ExportAllKeys(
+      keys, secret, false, data_out);
+  if (CheckGpgError(err) != GPG_ERR_NO_ERROR) {
+    file.cancelWriting();
+    return err;
+  }
+
+  if (!writer.Finish() || !file.commit()) return GPG_ERR_EIO;
+  return GPG_ERR_NO_ERROR;
+}
+
+auto KeyPackageOperator::ReadKeyPackage(const QString& key_package_path,
+                                        const QByteArray& phrase, int channel)
+    -> std::shared_ptr<GpgImportInformation> {
+  QFile file(key_package_path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    LOG_W() << "failed to read key package: " << key_package_path;
+    return nullptr;
+  }
+
+  KeyPackageReader reader(&file, KeyPackageKey(phrase));
+  if (!reader.ReadHeader()) {
+    file.seek(0);
+    return ImportLegacyKeyPackage(file.readAll(), phrase, channel);
+  }
+
+  // gpg imports every key as soon as it is read, so nothing may reach it
+  // before the whole package is known to be authentic and complete
+  if (!reader.Verify()) {
+    LOG_W() << "key package is corrupted or truncated: " << key_package_path;
+    return nullptr;
+  }
+
+  // the chunks are opened again while gpgme reads them
+  GpgData data_in(
+      [&reader](void* buffer, size_t size) {
+        return reader.Read(buffer, size);
+      },
+      {});
+  return GpgKeyImportExporter::GetInstance(channel).ImportKey(data_in);
+}
+
 auto KeyPackageOperator::GenerateKeyPackageName() -> QString {
   return generate_key_package_name();
 }
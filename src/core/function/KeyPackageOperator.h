@@ -33,8 +33,12 @@
 
 namespace GpgFrontend {
 
+class GpgImportInformation;
+
 /**
- * @brief give the possibility to import or export a key package
+ * @brief give the possibility to import or export a key package. The keys
+ * are streamed through AES-256-GCM in authenticated chunks, so neither side
+ * holds all of them in memory.
  *
  */
 class GPGFRONTEND_CORE_EXPORT KeyPackageOperator {
@@ -86,6 +90,33 @@ class GPGFRONTEND_CORE_EXPORT KeyPackageOperator {
                                const QString &phrase_path, int channel,
                                const OperationCallback &cb);
 
+  /**
+   * @brief export the keys into a key package, on the calling thread
+   *
+   * @param key_package_path
+   * @param channel
+   * @param keys
+   * @param phrase
+   * @param secret
+   * @return GpgError
+   */
+  static auto WriteKeyPackage(const QString &key_package_path, int channel,
+                              const KeyArgsList &keys, const QString &phrase,
+                              bool secret) -> GpgError;
+
+  /**
+   * @brief import the keys of a key package, the legacy ones included, on
+   * the calling thread
+   *
+   * @param key_package_path
+   * @param phrase
+   * @param channel
+   * @return std::shared_ptr<GpgImportInformation> nullptr on failure
+   */
+  static auto ReadKeyPackage(const QString &key_package_path,
+                             const QByteArray &phrase, int channel)
+      -> std::shared_ptr<GpgImportInformation>;
+
  private:
   /**
    * @brief generate key package name
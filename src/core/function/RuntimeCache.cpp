@@ -0,0 +1,275 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "RuntimeCache.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+
+#include "core/utils/MemoryUtils.h"
+
+namespace GpgFrontend {
+
+namespace {
+
+/**
+ * @brief slots of one second on the timing wheel
+ *
+ */
+constexpr qint64 kWheelSlots = 64;
+
+/**
+ * @brief estimated bytes of an entry besides its strings
+ *
+ */
+constexpr qint64 kEntryOverhead = 64;
+
+auto NowSeconds() -> qint64 {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+class RuntimeCache::Impl {
+ public:
+  Impl(qint64 byte_budget, int shards) {
+    for (int i = 0; i < std::max(shards, 1); i++) {
+      shards_.push_back(std::make_unique<Shard>());
+    }
+    SetByteBudget(byte_budget);
+  }
+
+  void Insert(const QString& key, QString value, qint64 ttl) {
+    auto& shard = get_shard(key);
+    const auto now = NowSeconds();
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+    erase(shard, key);
+
+    const auto bytes =
+        (key.size() + value.size()) * static_cast<qint64>(sizeof(QChar)) +
+        kEntryOverhead;
+
+    // never fits, so it is evicted right away
+    if (bytes > shard.budget) {
+      evictions_++;
+      return;
+    }
+
+    const auto expire = ttl < 0 ? -1 : now + ttl;
+    shard.lru.push_front({key, std::move(value), expire, bytes});
+    shard.index.insert(key, shard.lru.begin());
+    shard.bytes += bytes;
+
+    if (expire >= 0) {
+      // the slots up to the current tick are already turned
+      const auto tick = std::max(expire, shard.tick + 1);
+      shard.wheel[tick % kWheelSlots].push_back(key);
+    }
+
+    evict(shard);
+  }
+
+  auto Get(const QString& key) -> std::optional<QString> {
+    auto& shard = get_shard(key);
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+      misses_++;
+      return {};
+    }
+
+    auto entry = it.value();
+    if (entry->expire >= 0 && entry->expire <= NowSeconds()) {
+      erase(shard, key);
+      expirations_++;
+      misses_++;
+      return {};
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+    hits_++;
+    return entry->value;
+  }
+
+  auto Remove(const QString& key) -> bool {
+    auto& shard = get_shard(key);
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+    return erase(shard, key);
+  }
+
+  void Expire() {
+    const auto now = NowSeconds();
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->lock);
+      expire(*shard, now);
+    }
+  }
+
+  void SetByteBudget(qint64 byte_budget) {
+    const auto shard_budget =
+        std::max<qint64>(byte_budget / static_cast<qint64>(shards_.size()), 0);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->lock);
+      shard->budget = shard_budget;
+      evict(*shard);
+    }
+  }
+
+  [[nodiscard]] auto GetStats() const -> RuntimeCacheStats {
+    RuntimeCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.expirations = expirations_;
+
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->lock);
+      stats.entries += shard->index.size();
+      stats.bytes += shard->bytes;
+    }
+    return stats;
+  }
+
+ private:
+  struct Entry {
+    QString key;
+    QString value;
+    qint64 expire;  ///< seconds of the steady clock, -1 for none
+    qint64 bytes;
+  };
+
+  struct Shard {
+    std::mutex lock;
+    std::list<Entry> lru;  ///< most recently used first
+    QHash<QString, std::list<Entry>::iterator> index;
+    qint64 bytes = 0;
+    qint64 budget = 0;
+    std::array<QContainer<QString>, kWheelSlots> wheel;
+    qint64 tick = NowSeconds();  ///< the last turned slot
+  };
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<qint64> hits_{0};
+  std::atomic<qint64> misses_{0};
+  std::atomic<qint64> evictions_{0};
+  std::atomic<qint64> expirations_{0};
+
+  auto get_shard(const QString& key) -> Shard& {
+    return *shards_[qHash(key) % shards_.size()];
+  }
+
+  /**
+   * @brief erase the entry, the wheel keeps the key until its slot is turned
+   *
+   * @param shard
+   * @param key
+   * @return true
+   * @return false
+   */
+  static auto erase(Shard& shard, const QString& key) -> bool {
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) return false;
+
+    shard.bytes -= it.value()->bytes;
+    shard.lru.erase(it.value());
+    shard.index.erase(it);
+    return true;
+  }
+
+  void evict(Shard& shard) {
+    while (shard.bytes > shard.budget && !shard.lru.empty()) {
+      erase(shard, shard.lru.back().key);
+      evictions_++;
+    }
+  }
+
+  void expire(Shard& shard, qint64 now) {
+    // a full turn visits every slot once
+    const auto first = std::max(shard.tick + 1, now - kWheelSlots + 1);
+    for (auto tick = first; tick <= now; tick++) {
+      auto& slot = shard.wheel[tick % kWheelSlots];
+
+      QContainer<QString> later;
+      for (const auto& key : slot) {
+        auto it = shard.index.find(key);
+        // removed or inserted again
+        if (it == shard.index.end() || it.value()->expire < 0) continue;
+
+        const auto expire = it.value()->expire;
+        if (expire <= now) {
+          erase(shard, key);
+          expirations_++;
+        } else if (expire % kWheelSlots == tick % kWheelSlots &&
+                   !later.contains(key)) {
+          // in one of the next turns
+          later.push_back(key);
+        }
+      }
+      slot = later;
+    }
+    shard.tick = std::max(shard.tick, now);
+  }
+};
+
+RuntimeCache::RuntimeCache(qint64 byte_budget, int shards)
+    : p_(SecureCreateUniqueObject<Impl>(byte_budget, shards)) {}
+
+RuntimeCache::~RuntimeCache() = default;
+
+void RuntimeCache::Insert(const QString& key, QString value, qint64 ttl) {
+  p_->Insert(key, std::move(value), ttl);
+}
+
+auto RuntimeCache::Get(const QString& key) -> std::optional<QString> {
+  return p_->Get(key);
+}
+
+auto RuntimeCache::Remove(const QString& key) -> bool {
+  return p_->Remove(key);
+}
+
+void RuntimeCache::Expire() { p_->Expire(); }
+
+void RuntimeCache::SetByteBudget(qint64 byte_budget) {
+  p_->SetByteBudget(byte_budget);
+}
+
+auto RuntimeCache::GetStats() const -> RuntimeCacheStats {
+  return p_->GetStats();
+}
+
+}  // namespace GpgFrontend
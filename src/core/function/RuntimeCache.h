@@ -0,0 +1,129 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <optional>
+
+#include "core/GpgFrontendCore.h"
+#include "core/function/SecureMemoryAllocator.h"
+
+namespace GpgFrontend {
+
+/**
+ * @brief the counters of a runtime cache
+ *
+ */
+struct RuntimeCacheStats {
+  qint64 hits = 0;         ///< found and not expired
+  qint64 misses = 0;       ///< not found or expired
+  qint64 evictions = 0;    ///< dropped to keep the byte budget
+  qint64 expirations = 0;  ///< dropped because of the ttl
+  qint64 entries = 0;      ///< entries now
+  qint64 bytes = 0;        ///< estimated bytes of the entries now
+};
+
+/**
+ * @brief A thread safe cache of strings. The keys are spread over shards,
+ * each of them a lru list with a lock of its own and a share of the byte
+ * budget. Entries with a ttl are also put on a timing wheel of one second
+ * slots, which Expire() turns to drop them without waiting for a lookup.
+ *
+ */
+class GPGFRONTEND_CORE_EXPORT RuntimeCache {
+ public:
+  /**
+   * @brief Construct a new Runtime Cache object
+   *
+   * @param byte_budget
+   * @param shards
+   */
+  explicit RuntimeCache(qint64 byte_budget = kDefaultByteBudget,
+                        int shards = kDefaultShards);
+
+  /**
+   * @brief Destroy the Runtime Cache object
+   *
+   */
+  ~RuntimeCache();
+
+  /**
+   * @brief insert or replace the value, the least recently used entries of
+   * the shard are evicted if it exceeds the budget
+   *
+   * @param key
+   * @param value
+   * @param ttl seconds, no expiration if negative
+   */
+  void Insert(const QString& key, QString value, qint64 ttl = -1);
+
+  /**
+   * @brief get the value and mark it as recently used
+   *
+   * @param key
+   * @return std::optional<QString> nothing if it's missing or expired
+   */
+  auto Get(const QString& key) -> std::optional<QString>;
+
+  /**
+   * @brief remove the value
+   *
+   * @param key
+   * @return true if it existed
+   */
+  auto Remove(const QString& key) -> bool;
+
+  /**
+   * @brief turn the timing wheel up to now and drop the expired entries
+   *
+   */
+  void Expire();
+
+  /**
+   * @brief Set the byte budget, which is enforced at once
+   *
+   * @param byte_budget
+   */
+  void SetByteBudget(qint64 byte_budget);
+
+  /**
+   * @brief Get the counters
+   *
+   * @return RuntimeCacheStats
+   */
+  [[nodiscard]] auto GetStats() const -> RuntimeCacheStats;
+
+  static constexpr qint64 kDefaultByteBudget = 16 * 1024 * 1024;
+  static constexpr int kDefaultShards = 16;
+
+ private:
+  class Impl;
+  SecureUniquePtr<Impl> p_;
+};
+
+}  // namespace GpgFrontend
@@ -28,6 +28,7 @@
 
 #include "GpgAutomatonHandler.h"
 
+#include "core/function/gpg/GpgKeyGetter.h"
 #include "core/model/GpgData.h"
 #include "core/model/GpgKey.h"
 #include "core/utils/GpgUtils.h"
@@ -104,10 +105,16 @@ auto GpgAutomatonHandler::DoInteract(
 
   GpgData data_out;
 
+  auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   auto err =
       gpgme_op_interact(ctx_.DefaultContext(), static_cast<gpgme_key_t>(key), 0,
                         GpgAutomatonHandler::interator_cb_func,
                         static_cast<void*>(&handel_struct), data_out);
+
+  // the key may be edited even if the interaction failed at the end
+  key_getter.UpdateKeyCache({key_fpr}, stamp);
   return CheckGpgError(err) == GPG_ERR_NO_ERROR && handel_struct.Success();
 }
 
@@ -62,26 +62,45 @@ void SetSignersImpl(GpgContext& ctx_, const KeyArgsList& signers, bool ascii) {
   }
 }
 
-auto EncryptImpl(GpgContext& ctx_, const KeyArgsList& keys,
-                 const GFBuffer& in_buffer, bool ascii,
-                 const DataObjectPtr& data_object) -> GpgError {
+auto EncryptGpgDataImpl(GpgContext& ctx_, const KeyArgsList& keys,
+                        GpgData& data_in, bool ascii, GpgData& data_out,
+                        const DataObjectPtr& data_object) -> GpgError {
   auto recipients = Convert2RawGpgMEKeyList(keys);
 
-  GpgData data_in(in_buffer);
-  GpgData data_out;
-
   auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
   auto err = CheckGpgError(
       gpgme_op_encrypt(ctx, keys.isEmpty() ? nullptr : recipients.data(),
                        GPGME_ENCRYPT_ALWAYS_TRUST, data_in, data_out));
   data_object->Swap({
       GpgEncryptResult(gpgme_op_encrypt_result(ctx)),
-      data_out.Read2GFBuffer(),
   });
 
   return err;
 }
 
+auto EncryptImpl(GpgContext& ctx_, const KeyArgsList& keys,
+                 const GFBuffer& in_buffer, bool ascii,
+                 const DataObjectPtr& data_object) -> GpgError {
+  GpgData data_in(in_buffer);
+  GpgData data_out;
+
+  auto err =
+      EncryptGpgDataImpl(ctx_, keys, data_in, ascii, data_out, data_object);
+  data_object->AppendObject(data_out.Read2GFBuffer());
+  return err;
+}
+
+auto EncryptStreamImpl(GpgContext& ctx_, const KeyArgsList& keys,
+                       const GpgDataStream& in, const GpgDataStream& out,
+                       bool ascii, const DataObjectPtr& data_object)
+    -> GpgError {
+  GpgData data_in(in);
+  GpgData data_out(out);
+
+  return EncryptGpgDataImpl(ctx_, keys, data_in, ascii, data_out,
+                            data_object);
+}
+
 void GpgBasicOperator::Encrypt(const KeyArgsList& keys,
                                const GFBuffer& in_buffer, bool ascii,
                                const GpgOperationCallback& cb) {
@@ -121,21 +140,37 @@ auto GpgBasicOperator::EncryptSymmetricSync(const GFBuffer& in_buffer,
       "gpgme_op_encrypt_symmetric", "2.1.0");
 }
 
-auto DecryptImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
-                 const DataObjectPtr& data_object) -> GpgError {
-  GpgData data_in(in_buffer);
-  GpgData data_out;
-
+auto DecryptGpgDataImpl(GpgContext& ctx_, GpgData& data_in,
+                        GpgData& data_out,
+                        const DataObjectPtr& data_object) -> GpgError {
   auto err =
       CheckGpgError(gpgme_op_decrypt(ctx_.DefaultContext(), data_in, data_out));
   data_object->Swap({
       GpgDecryptResult(gpgme_op_decrypt_result(ctx_.DefaultContext())),
-      data_out.Read2GFBuffer(),
   });
 
   return err;
 }
 
+auto DecryptImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
+                 const DataObjectPtr& data_object) -> GpgError {
+  GpgData data_in(in_buffer);
+  GpgData data_out;
+
+  auto err = DecryptGpgDataImpl(ctx_, data_in, data_out, data_object);
+  data_object->AppendObject(data_out.Read2GFBuffer());
+  return err;
+}
+
+auto DecryptStreamImpl(GpgContext& ctx_, const GpgDataStream& in,
+                       const GpgDataStream& out,
+                       const DataObjectPtr& data_object) -> GpgError {
+  GpgData data_in(in);
+  GpgData data_out(out);
+
+  return DecryptGpgDataImpl(ctx_, data_in, data_out, data_object);
+}
+
 void GpgBasicOperator::Decrypt(const GFBuffer& in_buffer,
                                const GpgOperationCallback& cb) {
   RunGpgOperaAsync(
@@ -154,14 +189,11 @@ auto GpgBasicOperator::DecryptSync(const GFBuffer& in_buffer)
       "gpgme_op_decrypt", "2.1.0");
 }
 
-auto VerifyImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
-                const GFBuffer& sig_buffer,
-                const DataObjectPtr& data_object) -> GpgError {
+auto VerifyGpgDataImpl(GpgContext& ctx_, GpgData& data_in,
+                       const GFBuffer& sig_buffer, GpgData& data_out,
+                       const DataObjectPtr& data_object) -> GpgError {
   GpgError err;
 
-  GpgData data_in(in_buffer);
-  GpgData data_out;
-
   if (!sig_buffer.Empty()) {
     GpgData sig_data(sig_buffer);
     err = CheckGpgError(
@@ -173,12 +205,37 @@ auto VerifyImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
 
   data_object->Swap({
       GpgVerifyResult(gpgme_op_verify_result(ctx_.DefaultContext())),
-      GFBuffer(),
   });
 
   return err;
 }
 
+auto VerifyImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
+                const GFBuffer& sig_buffer,
+                const DataObjectPtr& data_object) -> GpgError {
+  GpgData data_in(in_buffer);
+  GpgData data_out;
+
+  auto err = VerifyGpgDataImpl(ctx_, data_in, sig_buffer, data_out,
+                               data_object);
+  data_object->AppendObject(GFBuffer());
+  return err;
+}
+
+auto VerifyStreamImpl(GpgContext& ctx_, const GpgDataStream& in,
+                      const GFBuffer& sig_buffer,
+                      const DataObjectPtr& data_object) -> GpgError {
+  GpgData data_in(in);
+
+  // the signed text is not kept, so the memory use stays bounded
+  GpgData data_out(GpgDataReadFunc{},
+                   GpgDataWriteFunc([](const void*, size_t size) -> ssize_t {
+                     return static_cast<ssize_t>(size);
+                   }));
+
+  return VerifyGpgDataImpl(ctx_, data_in, sig_buffer, data_out, data_object);
+}
+
 void GpgBasicOperator::Verify(const GFBuffer& in_buffer,
                               const GFBuffer& sig_buffer,
                               const GpgOperationCallback& cb) {
@@ -199,29 +256,51 @@ auto GpgBasicOperator::VerifySync(const GFBuffer& in_buffer,
       "gpgme_op_verify", "2.1.0");
 }
 
-auto SignImpl(GpgContext& ctx_, const KeyArgsList& signers,
-              const GFBuffer& in_buffer, GpgSignMode mode, bool ascii,
-              const DataObjectPtr& data_object) -> GpgError {
-  if (signers.empty()) return GPG_ERR_CANCELED;
-
+auto SignGpgDataImpl(GpgContext& ctx_, const KeyArgsList& signers,
+                     GpgData& data_in, GpgSignMode mode, bool ascii,
+                     GpgData& data_out,
+                     const DataObjectPtr& data_object) -> GpgError {
   GpgError err;
 
   // Set Singers of this opera
   SetSignersImpl(ctx_, signers, ascii);
 
-  GpgData data_in(in_buffer);
-  GpgData data_out;
-
   auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
   err = CheckGpgError(gpgme_op_sign(ctx, data_in, data_out, mode));
 
   data_object->Swap({
       GpgSignResult(gpgme_op_sign_result(ctx)),
-      data_out.Read2GFBuffer(),
   });
   return err;
 }
 
+auto SignImpl(GpgContext& ctx_, const KeyArgsList& signers,
+              const GFBuffer& in_buffer, GpgSignMode mode, bool ascii,
+              const DataObjectPtr& data_object) -> GpgError {
+  if (signers.empty()) return GPG_ERR_CANCELED;
+
+  GpgData data_in(in_buffer);
+  GpgData data_out;
+
+  auto err = SignGpgDataImpl(ctx_, signers, data_in, mode, ascii, data_out,
+                             data_object);
+  data_object->AppendObject(data_out.Read2GFBuffer());
+  return err;
+}
+
+auto SignStreamImpl(GpgContext& ctx_, const KeyArgsList& signers,
+                    const GpgDataStream& in, const GpgDataStream& out,
+                    GpgSignMode mode, bool ascii,
+                    const DataObjectPtr& data_object) -> GpgError {
+  if (signers.empty()) return GPG_ERR_CANCELED;
+
+  GpgData data_in(in);
+  GpgData data_out(out);
+
+  return SignGpgDataImpl(ctx_, signers, data_in, mode, ascii, data_out,
+                         data_object);
+}
+
 void GpgBasicOperator::Sign(const KeyArgsList& signers,
                             const GFBuffer& in_buffer, GpgSignMode mode,
                             bool ascii, const GpgOperationCallback& cb) {
@@ -242,25 +321,41 @@ auto GpgBasicOperator::SignSync(
       "gpgme_op_sign", "2.1.0");
 }
 
-auto DecryptVerifyImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
-                       const DataObjectPtr& data_object) -> GpgError {
+auto DecryptVerifyGpgDataImpl(GpgContext& ctx_, GpgData& data_in,
+                              GpgData& data_out,
+                              const DataObjectPtr& data_object) -> GpgError {
   GpgError err;
 
-  GpgData data_in(in_buffer);
-  GpgData data_out;
-
   err = CheckGpgError(
       gpgme_op_decrypt_verify(ctx_.DefaultContext(), data_in, data_out));
 
   data_object->Swap({
       GpgDecryptResult(gpgme_op_decrypt_result(ctx_.DefaultContext())),
       GpgVerifyResult(gpgme_op_verify_result(ctx_.DefaultContext())),
-      data_out.Read2GFBuffer(),
   });
 
   return err;
 }
 
+auto DecryptVerifyImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
+                       const DataObjectPtr& data_object) -> GpgError {
+  GpgData data_in(in_buffer);
+  GpgData data_out;
+
+  auto err = DecryptVerifyGpgDataImpl(ctx_, data_in, data_out, data_object);
+  data_object->AppendObject(data_out.Read2GFBuffer());
+  return err;
+}
+
+auto DecryptVerifyStreamImpl(GpgContext& ctx_, const GpgDataStream& in,
+                             const GpgDataStream& out,
+                             const DataObjectPtr& data_object) -> GpgError {
+  GpgData data_in(in);
+  GpgData data_out(out);
+
+  return DecryptVerifyGpgDataImpl(ctx_, data_in, data_out, data_object);
+}
+
 void GpgBasicOperator::DecryptVerify(const GFBuffer& in_buffer,
                                      const GpgOperationCallback& cb) {
   RunGpgOperaAsync(
@@ -279,11 +374,10 @@ auto GpgBasicOperator::DecryptVerifySync(const GFBuffer& in_buffer)
       "gpgme_op_decrypt_verify", "2.1.0");
 }
 
-auto EncryptSignImpl(GpgContext& ctx_, const KeyArgsList& keys,
-                     const KeyArgsList& signers, const GFBuffer& in_buffer,
-                     bool ascii, const DataObjectPtr& data_object) -> GpgError {
-  if (keys.empty() || signers.empty()) return GPG_ERR_CANCELED;
-
+auto EncryptSignGpgDataImpl(GpgContext& ctx_, const KeyArgsList& keys,
+                            const KeyArgsList& signers, GpgData& data_in,
+                            bool ascii, GpgData& data_out,
+                            const DataObjectPtr& data_object) -> GpgError {
   GpgError err;
   QContainer<gpgme_key_t> recipients(keys.begin(), keys.end());
 
@@ -292,9 +386,6 @@ auto EncryptSignImpl(GpgContext& ctx_, const KeyArgsList& keys,
 
   SetSignersImpl(ctx_, signers, ascii);
 
-  GpgData data_in(in_buffer);
-  GpgData data_out;
-
   auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
   err = CheckGpgError(gpgme_op_encrypt_sign(
       ctx, recipients.data(), GPGME_ENCRYPT_ALWAYS_TRUST, data_in, data_out));
@@ -302,11 +393,37 @@ auto EncryptSignImpl(GpgContext& ctx_, const KeyArgsList& keys,
   data_object->Swap({
       GpgEncryptResult(gpgme_op_encrypt_result(ctx)),
       GpgSignResult(gpgme_op_sign_result(ctx)),
-      data_out.Read2GFBuffer(),
   });
   return err;
 }
 
+auto EncryptSignImpl(GpgContext& ctx_, const KeyArgsList& keys,
+                     const KeyArgsList& signers, const GFBuffer& in_buffer,
+                     bool ascii, const DataObjectPtr& data_object) -> GpgError {
+  if (keys.empty() || signers.empty()) return GPG_ERR_CANCELED;
+
+  GpgData data_in(in_buffer);
+  GpgData data_out;
+
+  auto err = EncryptSignGpgDataImpl(ctx_, keys, signers, data_in, ascii,
+                                    data_out, data_object);
+  data_object->AppendObject(data_out.Read2GFBuffer());
+  return err;
+}
+
+auto EncryptSignStreamImpl(GpgContext& ctx_, const KeyArgsList& keys,
+                           const KeyArgsList& signers, const GpgDataStream& in,
+                           const GpgDataStream& out, bool ascii,
+                           const DataObjectPtr& data_object) -> GpgError {
+  if (keys.empty() || signers.empty()) return GPG_ERR_CANCELED;
+
+  GpgData data_in(in);
+  GpgData data_out(out);
+
+  return EncryptSignGpgDataImpl(ctx_, keys, signers, data_in, ascii, data_out,
+                                data_object);
+}
+
 void GpgBasicOperator::EncryptSign(const KeyArgsList& keys,
                                    const KeyArgsList& signers,
                                    const GFBuffer& in_buffer, bool ascii,
@@ -331,6 +448,139 @@ auto GpgBasicOperator::EncryptSignSync(const KeyArgsList& keys,
       "gpgme_op_encrypt_sign", "2.1.0");
 }
 
+void GpgBasicOperator::Encrypt(const KeyArgsList& keys,
+                               const GpgDataStream& in,
+                               const GpgDataStream& out, bool ascii,
+                               const GpgOperationCallback& cb) {
+  RunGpgOperaAsync(
+      [=](const DataObjectPtr& data_object) {
+        return EncryptStreamImpl(ctx_, keys, in, out, ascii, data_object);
+      },
+      cb, keys.isEmpty() ? "gpgme_op_encrypt_symmetric" : "gpgme_op_encrypt",
+      "2.1.0");
+}
+
+auto GpgBasicOperator::EncryptSync(const KeyArgsList& keys,
+                                   const GpgDataStream& in,
+                                   const GpgDataStream& out, bool ascii)
+    -> std::tuple<GpgError, DataObjectPtr> {
+  return RunGpgOperaSync(
+      [=](const DataObjectPtr& data_object) {
+        return EncryptStreamImpl(ctx_, keys, in, out, ascii, data_object);
+      },
+      keys.isEmpty() ? "gpgme_op_encrypt_symmetric" : "gpgme_op_encrypt",
+      "2.1.0");
+}
+
+void GpgBasicOperator::EncryptSign(const KeyArgsList& keys,
+                                   const KeyArgsList& signers,
+                                   const GpgDataStream& in,
+                                   const GpgDataStream& out, bool ascii,
+                                   const GpgOperationCallback& cb) {
+  RunGpgOperaAsync(
+      [=](const DataObjectPtr& data_object) -> GpgError {
+        return EncryptSignStreamImpl(ctx_, keys, signers, in, out, ascii,
+                                     data_object);
+      },
+      cb, "gpgme_op_encrypt_sign", "2.1.0");
+}
+
+auto GpgBasicOperator::EncryptSignSync(
+    const KeyArgsList& keys, const KeyArgsList& signers,
+    const GpgDataStream& in, const GpgDataStream& out,
+    bool ascii) -> std::tuple<GpgError, DataObjectPtr> {
+  return RunGpgOperaSync(
+      [=](const DataObjectPtr& data_object) -> GpgError {
+        return EncryptSignStreamImpl(ctx_, keys, signers, in, out, ascii,
+                                     data_object);
+      },
+      "gpgme_op_encrypt_sign", "2.1.0");
+}
+
+void GpgBasicOperator::Decrypt(const GpgDataStream& in,
+                               const GpgDataStream& out,
+                               const GpgOperationCallback& cb) {
+  RunGpgOperaAsync(
+      [=](const DataObjectPtr& data_object) {
+        return DecryptStreamImpl(ctx_, in, out, data_object);
+      },
+      cb, "gpgme_op_decrypt", "2.1.0");
+}
+
+auto GpgBasicOperator::DecryptSync(const GpgDataStream& in,
+                                   const GpgDataStream& out)
+    -> std::tuple<GpgError, DataObjectPtr> {
+  return RunGpgOperaSync(
+      [=](const DataObjectPtr& data_object) {
+        return DecryptStreamImpl(ctx_, in, out, data_object);
+      },
+      "gpgme_op_decrypt", "2.1.0");
+}
+
+void GpgBasicOperator::DecryptVerify(const GpgDataStream& in,
+                                     const GpgDataStream& out,
+                                     const GpgOperationCallback& cb) {
+  RunGpgOperaAsync(
+      [=](const DataObjectPtr& data_object) {
+        return DecryptVerifyStreamImpl(ctx_, in, out, data_object);
+      },
+      cb, "gpgme_op_decrypt_verify", "2.1.0");
+}
+
+auto GpgBasicOperator::DecryptVerifySync(const GpgDataStream& in,
+                                         const GpgDataStream& out)
+    -> std::tuple<GpgError, DataObjectPtr> {
+  return RunGpgOperaSync(
+      [=](const DataObjectPtr& data_object) -> GpgError {
+        return DecryptVerifyStreamImpl(ctx_, in, out, data_object);
+      },
+      "gpgme_op_decrypt_verify", "2.1.0");
+}
+
+void GpgBasicOperator::Verify(const GpgDataStream& in,
+                              const GFBuffer& sig_buffer,
+                              const GpgOperationCallback& cb) {
+  RunGpgOperaAsync(
+      [=](const DataObjectPtr& data_object) -> GpgError {
+        return VerifyStreamImpl(ctx_, in, sig_buffer, data_object);
+      },
+      cb, "gpgme_op_verify", "2.1.0");
+}
+
+auto GpgBasicOperator::VerifySync(const GpgDataStream& in,
+                                  const GFBuffer& sig_buffer)
+    -> std::tuple<GpgError, DataObjectPtr> {
+  return RunGpgOperaSync(
+      [=](const DataObjectPtr& data_object) {
+        return VerifyStreamImpl(ctx_, in, sig_buffer, data_object);
+      },
+      "gpgme_op_verify", "2.1.0");
+}
+
+void GpgBasicOperator::Sign(const KeyArgsList& signers,
+                            const GpgDataStream& in, const GpgDataStream& out,
+                            GpgSignMode mode, bool ascii,
+                            const GpgOperationCallback& cb) {
+  RunGpgOperaAsync(
+      [=](const DataObjectPtr& data_object) {
+        return SignStreamImpl(ctx_, signers, in, out, mode, ascii,
+                              data_object);
+      },
+      cb, "gpgme_op_sign", "2.1.0");
+}
+
+auto GpgBasicOperator::SignSync(
+    const KeyArgsList& signers, const GpgDataStream& in,
+    const GpgDataStream& out, GpgSignMode mode,
+    bool ascii) -> std::tuple<GpgError, DataObjectPtr> {
+  return RunGpgOperaSync(
+      [=](const DataObjectPtr& data_object) {
+        return SignStreamImpl(ctx_, signers, in, out, mode, ascii,
+                              data_object);
+      },
+      "gpgme_op_sign", "2.1.0");
+}
+
 void GpgBasicOperator::SetSigners(const KeyArgsList& signers, bool ascii) {
   SetSignersImpl(ctx_, signers, ascii);
 }
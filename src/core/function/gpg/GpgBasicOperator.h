@@ -32,6 +32,7 @@
 #include "core/function/gpg/GpgContext.h"
 #include "core/function/result_analyse/GpgResultAnalyse.h"
 #include "core/model/GFBuffer.h"
+#include "core/model/GpgData.h"
 #include "core/typedef/CoreTypedef.h"
 #include "core/typedef/GpgTypedef.h"
 
@@ -213,6 +214,151 @@ class GPGFRONTEND_CORE_EXPORT GpgBasicOperator
                 GpgSignMode mode,
                 bool ascii) -> std::tuple<GpgError, DataObjectPtr>;
 
+  /**
+   * @brief streaming variant of Encrypt(), the ciphertext goes to the sink
+   * while the source is read. The data object holds the results only.
+   *
+   * @param keys empty for symmetric encryption
+   * @param in
+   * @param out
+   * @param ascii
+   * @param cb
+   */
+  void Encrypt(const KeyArgsList& keys, const GpgDataStream& in,
+               const GpgDataStream& out, bool ascii,
+               const GpgOperationCallback& cb);
+
+  /**
+   * @brief streaming variant of EncryptSync(). An exchanger as the source
+   * must be fed by another thread.
+   *
+   * @param keys empty for symmetric encryption
+   * @param in
+   * @param out
+   * @param ascii
+   * @return std::tuple<GpgError, DataObjectPtr>
+   */
+  auto EncryptSync(const KeyArgsList& keys, const GpgDataStream& in,
+                   const GpgDataStream& out,
+                   bool ascii) -> std::tuple<GpgError, DataObjectPtr>;
+
+  /**
+   * @brief streaming variant of EncryptSign()
+   *
+   * @param keys
+   * @param signers
+   * @param in
+   * @param out
+   * @param ascii
+   * @param cb
+   */
+  void EncryptSign(const KeyArgsList& keys, const KeyArgsList& signers,
+                   const GpgDataStream& in, const GpgDataStream& out,
+                   bool ascii, const GpgOperationCallback& cb);
+
+  /**
+   * @brief streaming variant of EncryptSignSync()
+   *
+   * @param keys
+   * @param signers
+   * @param in
+   * @param out
+   * @param ascii
+   * @return std::tuple<GpgError, DataObjectPtr>
+   */
+  auto EncryptSignSync(const KeyArgsList& keys, const KeyArgsList& signers,
+                       const GpgDataStream& in, const GpgDataStream& out,
+                       bool ascii) -> std::tuple<GpgError, DataObjectPtr>;
+
+  /**
+   * @brief streaming variant of Decrypt()
+   *
+   * @param in
+   * @param out
+   * @param cb
+   */
+  void Decrypt(const GpgDataStream& in, const GpgDataStream& out,
+               const GpgOperationCallback& cb);
+
+  /**
+   * @brief streaming variant of DecryptSync()
+   *
+   * @param in
+   * @param out
+   * @return std::tuple<GpgError, DataObjectPtr>
+   */
+  auto DecryptSync(const GpgDataStream& in, const GpgDataStream& out)
+      -> std::tuple<GpgError, DataObjectPtr>;
+
+  /**
+   * @brief streaming variant of DecryptVerify()
+   *
+   * @param in
+   * @param out
+   * @param cb
+   */
+  void DecryptVerify(const GpgDataStream& in, const GpgDataStream& out,
+                     const GpgOperationCallback& cb);
+
+  /**
+   * @brief streaming variant of DecryptVerifySync()
+   *
+   * @param in
+   * @param out
+   * @return std::tuple<GpgError, DataObjectPtr>
+   */
+  auto DecryptVerifySync(const GpgDataStream& in, const GpgDataStream& out)
+      -> std::tuple<GpgError, DataObjectPtr>;
+
+  /**
+   * @brief streaming variant of Verify(), the signed text of a normal
+   * signature is dropped
+   *
+   * @param in
+   * @param sig_buffer detached signature, or empty
+   * @param cb
+   */
+  void Verify(const GpgDataStream& in, const GFBuffer& sig_buffer,
+              const GpgOperationCallback& cb);
+
+  /**
+   * @brief streaming variant of VerifySync()
+   *
+   * @param in
+   * @param sig_buffer detached signature, or empty
+   * @return std::tuple<GpgError, DataObjectPtr>
+   */
+  auto VerifySync(const GpgDataStream& in, const GFBuffer& sig_buffer)
+      -> std::tuple<GpgError, DataObjectPtr>;
+
+  /**
+   * @brief streaming variant of Sign()
+   *
+   * @param signers
+   * @param in
+   * @param out
+   * @param mode
+   * @param ascii
+   * @param cb
+   */
+  void Sign(const KeyArgsList& signers, const GpgDataStream& in,
+            const GpgDataStream& out, GpgSignMode mode, bool ascii,
+            const GpgOperationCallback& cb);
+
+  /**
+   * @brief streaming variant of SignSync()
+   *
+   * @param signers
+   * @param in
+   * @param out
+   * @param mode
+   * @param ascii
+   * @return std::tuple<GpgError, DataObjectPtr>
+   */
+  auto SignSync(const KeyArgsList& signers, const GpgDataStream& in,
+                const GpgDataStream& out, GpgSignMode mode,
+                bool ascii) -> std::tuple<GpgError, DataObjectPtr>;
+
   /**
    * @brief  Set the private key for signatures, this operation is a global
    * operation.
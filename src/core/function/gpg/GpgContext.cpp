@@ -33,13 +33,15 @@
 
 #include <cassert>
 #include <cstddef>
+#include <deque>
 #include <mutex>
+#include <utility>
 
 #include "core/function/CoreSignalStation.h"
 #include "core/function/basic/GpgFunctionObject.h"
 #include "core/model/GpgPassphraseContext.h"
 #include "core/module/ModuleManager.h"
-#include "core/utils/CacheUtils.h"
+#include "core/thread/TaskRunnerGetter.h"
 #include "core/utils/GpgUtils.h"
 #include "core/utils/MemoryUtils.h"
 
@@ -68,13 +70,22 @@ class GpgContext::Impl {
     if (binary_ctx_ref_ != nullptr) {
       gpgme_release(binary_ctx_ref_);
     }
+
+    for (const auto &slot : worker_ctx_slots_) {
+      if (slot.ctx_ref != nullptr) gpgme_release(slot.ctx_ref);
+      if (slot.binary_ctx_ref != nullptr) gpgme_release(slot.binary_ctx_ref);
+    }
   }
 
-  [[nodiscard]] auto BinaryContext() const -> gpgme_ctx_t {
-    return binary_ctx_ref_;
+  [[nodiscard]] auto BinaryContext() -> gpgme_ctx_t {
+    const auto *slot = current_worker_ctx_slot();
+    return slot != nullptr ? slot->binary_ctx_ref : binary_ctx_ref_;
   }
 
-  [[nodiscard]] auto DefaultContext() const -> gpgme_ctx_t { return ctx_ref_; }
+  [[nodiscard]] auto DefaultContext() -> gpgme_ctx_t {
+    const auto *slot = current_worker_ctx_slot();
+    return slot != nullptr ? slot->ctx_ref : ctx_ref_;
+  }
 
   [[nodiscard]] auto Good() const -> bool { return good_; }
 
@@ -86,10 +97,26 @@ class GpgContext::Impl {
         return false;
       }
     }
-    gpgme_set_passphrase_cb(ctx, cb, reinterpret_cast<void *>(parent_));
+    // every context gets a hook of its own, so the state of the passphrase
+    // request stays with the operation running on it
+    PassphraseHook *hook = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(worker_ctx_slots_lock_);
+      hook = &passphrase_hooks_.emplace_back();
+    }
+    gpgme_set_passphrase_cb(ctx, cb, hook);
     return true;
   }
 
+  static void SetAskForNewPassphrase(gpgme_ctx_t ctx, bool ask_for_new) {
+    gpgme_passphrase_cb_t cb = nullptr;
+    void *hook = nullptr;
+    gpgme_get_passphrase_cb(ctx, &cb, &hook);
+    if (cb == nullptr || hook == nullptr) return;
+
+    static_cast<PassphraseHook *>(hook)->ask_for_new = ask_for_new;
+  }
+
   static auto TestPassphraseCb(void *opaque, const char *uid_hint,
                                const char *passphrase_info, int last_was_bad,
                                int fd) -> gpgme_error_t {
@@ -116,8 +143,10 @@ class GpgContext::Impl {
   static auto CustomPassphraseCb(void *hook, const char *uid_hint,
                                  const char *passphrase_info, int prev_was_bad,
                                  int fd) -> gpgme_error_t {
-    auto context_cache = GetCacheValue("PinentryContext");
-    bool ask_for_new = context_cache == "NEW_PASSPHRASE";
+    // only the first request of the operation is for the new passphrase
+    auto *passphrase_hook = static_cast<PassphraseHook *>(hook);
+    bool ask_for_new = passphrase_hook != nullptr &&
+                       std::exchange(passphrase_hook->ask_for_new, false);
     auto context =
         QSharedPointer<GpgPassphraseContext>(new GpgPassphraseContext(
             uid_hint != nullptr ? uid_hint : "",
@@ -148,7 +177,6 @@ class GpgContext::Impl {
         });
 
     looper.exec();
-    ResetCacheValue("PinentryContext");
 
     LOG_D() << "passphrase size:" << passphrase.size();
 
@@ -181,20 +209,81 @@ class GpgContext::Impl {
   }
 
  private:
+  /**
+   * @brief the state of the passphrase callback of one context
+   *
+   */
+  struct PassphraseHook {
+    bool ask_for_new = false;  ///< the passphrase of a new key is requested
+  };
+
+  /**
+   * @brief the contexts owned by one concurrency slot of the gpg lane
+   *
+   */
+  struct WorkerContextSlot {
+    gpgme_ctx_t ctx_ref = nullptr;         ///<
+    gpgme_ctx_t binary_ctx_ref = nullptr;  ///<
+    bool initialized = false;              ///<
+  };
+
   GpgContext *parent_;
   GpgContextInitArgs args_{};             ///<
   gpgme_ctx_t ctx_ref_ = nullptr;         ///<
   gpgme_ctx_t binary_ctx_ref_ = nullptr;  ///<
-  bool good_ = true;
-  std::mutex ctx_ref_lock_;
-  std::mutex binary_ctx_ref_lock_;
+  std::mutex worker_ctx_slots_lock_;
+  std::deque<WorkerContextSlot> worker_ctx_slots_;
+  std::deque<PassphraseHook> passphrase_hooks_;
+  bool good_ = true;  ///< initialized last, it creates the primary contexts
+
+  /**
+   * @brief Each concurrency slot of the gpg lane leases its own pair of
+   * contexts, created on its first operation at this channel, so there are
+   * never more pairs than gpg workers. Threads not running a gpg task share
+   * the primary contexts.
+   *
+   * @return WorkerContextSlot* nullptr if the primary contexts should be used
+   */
+  auto current_worker_ctx_slot() -> const WorkerContextSlot * {
+    const auto index =
+        Thread::TaskRunnerGetter::GetInstance().GetGpgLaneSlot();
+    if (index < 0 || !good_) return nullptr;
+
+    WorkerContextSlot *slot = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(worker_ctx_slots_lock_);
+      if (worker_ctx_slots_.size() <= static_cast<size_t>(index)) {
+        worker_ctx_slots_.resize(index + 1);
+      }
+
+      // std::deque keeps references stable across resize()
+      slot = &worker_ctx_slots_[index];
+    }
+
+    // a slot is held by one task at a time, nobody else touches it here
+    if (!slot->initialized) {
+      slot->initialized = true;
+      if (!new_ctx(args_, true, slot->ctx_ref) ||
+          !new_ctx(args_, false, slot->binary_ctx_ref)) {
+        LOG_W() << "cannot create gpgme contexts for gpg lane slot:" << index
+                << "channel:" << parent_->GetChannel()
+                << ", fallback to primary contexts";
+      }
+    }
+
+    if (slot->ctx_ref == nullptr || slot->binary_ctx_ref == nullptr) {
+      return nullptr;
+    }
+    return slot;
+  }
 
   static auto set_ctx_key_list_mode(const gpgme_ctx_t &ctx) -> bool {
     assert(ctx != nullptr);
 
-    const auto gpgme_version = Module::RetrieveRTValueTypedOrDefault<>(
+    static Module::RTHandle<QString> gpgme_version_handle(
         "core", "gpgme.version", QString{"0.0.0"});
-    LOG_D() << "got gpgme version version from rt: " << gpgme_version;
+    LOG_D() << "got gpgme version version from rt: "
+            << gpgme_version_handle.Get();
 
     if (gpgme_get_keylist_mode(ctx) == 0) {
       FLOG_W("ctx is not a valid pointer, reported by gpgme_get_keylist_mode");
@@ -210,8 +299,9 @@ class GpgContext::Impl {
   }
 
   auto set_ctx_openpgp_engine_info(gpgme_ctx_t ctx) -> bool {
-    const auto app_path = Module::RetrieveRTValueTypedOrDefault<>(
-        "core", QString("gpgme.ctx.app_path"), QString{});
+    static Module::RTHandle<QString> app_path_handle(
+        "core", "gpgme.ctx.app_path", QString{});
+    const auto app_path = app_path_handle.Get();
 
     QString database_path;
     // set custom gpg key db path
@@ -306,7 +396,8 @@ class GpgContext::Impl {
     return true;
   }
 
-  auto binary_ctx_initialize(const GpgContextInitArgs &args) -> bool {
+  auto new_ctx(const GpgContextInitArgs &args, bool armor,
+               gpgme_ctx_t &ctx_ref) -> bool {
     gpgme_ctx_t p_ctx;
     if (auto err = CheckGpgError(gpgme_new(&p_ctx)); err != GPG_ERR_NO_ERROR) {
       LOG_W() << "get new gpg context error: "
@@ -314,32 +405,23 @@ class GpgContext::Impl {
       return false;
     }
     assert(p_ctx != nullptr);
-    binary_ctx_ref_ = p_ctx;
+    ctx_ref = p_ctx;
 
-    if (!common_ctx_initialize(binary_ctx_ref_, args)) {
-      FLOG_W("get new ctx failed, binary");
+    if (!common_ctx_initialize(ctx_ref, args)) {
+      FLOG_W("get new ctx failed, armor: %d", armor);
       return false;
     }
 
-    gpgme_set_armor(binary_ctx_ref_, 0);
+    gpgme_set_armor(ctx_ref, armor ? 1 : 0);
     return true;
   }
 
-  auto default_ctx_initialize(const GpgContextInitArgs &args) -> bool {
-    gpgme_ctx_t p_ctx;
-    if (CheckGpgError(gpgme_new(&p_ctx)) != GPG_ERR_NO_ERROR) {
-      FLOG_W("get new ctx failed, default");
-      return false;
-    }
-    assert(p_ctx != nullptr);
-    ctx_ref_ = p_ctx;
-
-    if (!common_ctx_initialize(ctx_ref_, args)) {
-      return false;
-    }
+  auto binary_ctx_initialize(const GpgContextInitArgs &args) -> bool {
+    return new_ctx(args, false, binary_ctx_ref_);
+  }
 
-    gpgme_set_armor(ctx_ref_, 1);
-    return true;
+  auto default_ctx_initialize(const GpgContextInitArgs &args) -> bool {
+    return new_ctx(args, true, ctx_ref_);
   }
 };
 
@@ -359,6 +441,10 @@ auto GpgContext::DefaultContext() -> gpgme_ctx_t {
   return p_->DefaultContext();
 }
 
+void GpgContext::SetAskForNewPassphrase(gpgme_ctx_t ctx, bool ask_for_new) {
+  Impl::SetAskForNewPassphrase(ctx, ask_for_new);
+}
+
 GpgContext::~GpgContext() = default;
 
 }  // namespace GpgFrontend
\ No newline at end of file
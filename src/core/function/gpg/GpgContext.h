@@ -71,6 +71,15 @@ class GPGFRONTEND_CORE_EXPORT GpgContext
 
   auto DefaultContext() -> gpgme_ctx_t;
 
+  /**
+   * @brief let the next passphrase request of the operation running on ctx
+   * ask for a new passphrase instead of an existing one.
+   *
+   * @param ctx
+   * @param ask_for_new
+   */
+  static void SetAskForNewPassphrase(gpgme_ctx_t ctx, bool ask_for_new);
+
  private:
   class Impl;
   SecureUniquePtr<Impl> p_;
@@ -63,6 +63,21 @@ void CreateArchiveHelper(const QString& in_path,
       });
 }
 
+/**
+ * @brief files of at least this size are mapped or go through a large buffer,
+ * below it a stdio stream is as fast
+ *
+ */
+constexpr qint64 kLargeGpgDataFileSize = 1024 * 1024;
+
+auto FileGpgDataModeHelper(qint64 in_size, bool read) -> GpgDataFileMode {
+  if (in_size < kLargeGpgDataFileSize) return GpgDataFileMode::kStream;
+
+  // a mapping needs the whole file to fit into the address space
+  return read && sizeof(void*) >= 8 ? GpgDataFileMode::kMapped
+                                    : GpgDataFileMode::kBuffered;
+}
+
 GpgFileOpera::GpgFileOpera(int channel)
     : SingletonFunctionObject<GpgFileOpera>(channel) {}
 
@@ -83,11 +98,15 @@ auto EncryptFileImpl(GpgContext& ctx_, const KeyArgsList& keys,
                      const QString& in_path, bool ascii,
                      const QString& out_path,
                      const DataObjectPtr& data_object) -> GpgError {
-  GpgData data_in(in_path, true);
-  GpgData data_out(out_path, false);
+  const auto in_size = QFileInfo(in_path).size();
+  GpgData data_in(in_path, true, FileGpgDataModeHelper(in_size, true));
+  GpgData data_out(out_path, false, FileGpgDataModeHelper(in_size, false),
+                   in_size);
 
-  return EncryptFileGpgDataImpl(ctx_, keys, data_in, ascii, data_out,
-                                data_object);
+  auto err = EncryptFileGpgDataImpl(ctx_, keys, data_in, ascii, data_out,
+                                    data_object);
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
+  return CheckGpgError(data_out.Flush());
 }
 
 void GpgFileOpera::EncryptFile(const KeyArgsList& keys, const QString& in_path,
@@ -145,10 +164,14 @@ auto DecryptFileGpgDataImpl(GpgContext& ctx_, GpgData& data_in,
 auto DecryptFileImpl(GpgContext& ctx_, const QString& in_path,
                      const QString& out_path,
                      const DataObjectPtr& data_object) -> GpgError {
-  GpgData data_in(in_path, true);
-  GpgData data_out(out_path, false);
+  const auto in_size = QFileInfo(in_path).size();
+  GpgData data_in(in_path, true, FileGpgDataModeHelper(in_size, true));
+  GpgData data_out(out_path, false, FileGpgDataModeHelper(in_size, false),
+                   in_size);
 
-  return DecryptFileGpgDataImpl(ctx_, data_in, data_out, data_object);
+  auto err = DecryptFileGpgDataImpl(ctx_, data_in, data_out, data_object);
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
+  return CheckGpgError(data_out.Flush());
 }
 
 void GpgFileOpera::DecryptFile(const QString& in_path, const QString& out_path,
@@ -177,7 +200,9 @@ void GpgFileOpera::DecryptArchive(const QString& in_path,
 
   RunGpgOperaAsync(
       [=](const DataObjectPtr& data_object) -> GpgError {
-        GpgData data_in(in_path, true);
+        GpgData data_in(
+            in_path, true,
+            FileGpgDataModeHelper(QFileInfo(in_path).size(), true));
         GpgData data_out(ex);
 
         return DecryptFileGpgDataImpl(ctx_, data_in, data_out, data_object);
@@ -208,7 +233,9 @@ auto SignFileImpl(GpgContext& ctx_, GpgBasicOperator& basic_opera_,
                   const KeyArgsList& keys, const QString& in_path, bool ascii,
                   const QString& out_path,
                   const DataObjectPtr& data_object) -> GpgError {
-  GpgData data_in(in_path, true);
+  // the detached signature is small
+  GpgData data_in(in_path, true,
+                  FileGpgDataModeHelper(QFileInfo(in_path).size(), true));
   GpgData data_out(out_path, false);
 
   return SignFileGpgDataImpl(ctx_, basic_opera_, keys, data_in, ascii, data_out,
@@ -242,7 +269,8 @@ auto VerifyFileImpl(GpgContext& ctx_, const QString& data_path,
                     const DataObjectPtr& data_object) -> GpgError {
   GpgError err;
 
-  GpgData data_in(data_path, true);
+  GpgData data_in(data_path, true,
+                  FileGpgDataModeHelper(QFileInfo(data_path).size(), true));
   GpgData data_out;
   if (!sign_path.isEmpty()) {
     GpgData sig_data(sign_path, true);
@@ -308,11 +336,16 @@ auto EncryptSignFileImpl(GpgContext& ctx_, GpgBasicOperator& basic_opera_,
                          const KeyArgsList& signer_keys, const QString& in_path,
                          bool ascii, const QString& out_path,
                          const DataObjectPtr& data_object) -> GpgError {
-  GpgData data_in(in_path, true);
-  GpgData data_out(out_path, false);
+  const auto in_size = QFileInfo(in_path).size();
+  GpgData data_in(in_path, true, FileGpgDataModeHelper(in_size, true));
+  GpgData data_out(out_path, false, FileGpgDataModeHelper(in_size, false),
+                   in_size);
 
-  return EncryptSignFileGpgDataImpl(ctx_, basic_opera_, keys, signer_keys,
-                                    data_in, ascii, data_out, data_object);
+  auto err =
+      EncryptSignFileGpgDataImpl(ctx_, basic_opera_, keys, signer_keys,
+                                 data_in, ascii, data_out, data_object);
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
+  return CheckGpgError(data_out.Flush());
 }
 
 void GpgFileOpera::EncryptSignFile(const KeyArgsList& keys,
@@ -377,10 +410,14 @@ auto DecryptVerifyFileGpgDataImpl(
 auto DecryptVerifyFileImpl(GpgContext& ctx_, const QString& in_path,
                            const QString& out_path,
                            const DataObjectPtr& data_object) -> GpgError {
-  GpgData data_in(in_path, true);
-  GpgData data_out(out_path, false);
+  const auto in_size = QFileInfo(in_path).size();
+  GpgData data_in(in_path, true, FileGpgDataModeHelper(in_size, true));
+  GpgData data_out(out_path, false, FileGpgDataModeHelper(in_size, false),
+                   in_size);
 
-  return DecryptVerifyFileGpgDataImpl(ctx_, data_in, data_out, data_object);
+  auto err = DecryptVerifyFileGpgDataImpl(ctx_, data_in, data_out, data_object);
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
+  return CheckGpgError(data_out.Flush());
 }
 
 void GpgFileOpera::DecryptVerifyFile(const QString& in_path,
@@ -410,7 +447,9 @@ void GpgFileOpera::DecryptVerifyArchive(const QString& in_path,
 
   RunGpgOperaAsync(
       [=](const DataObjectPtr& data_object) -> GpgError {
-        GpgData data_in(in_path, true);
+        GpgData data_in(
+            in_path, true,
+            FileGpgDataModeHelper(QFileInfo(in_path).size(), true));
         GpgData data_out(ex);
         return DecryptVerifyFileGpgDataImpl(ctx_, data_in, data_out,
                                             data_object);
@@ -30,10 +30,16 @@
 
 #include <gpg-error.h>
 
+#include <chrono>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <utility>
 
 #include "core/GpgModel.h"
 #include "core/function/gpg/GpgContext.h"
+#include "core/function/gpg/GpgKeyTableSnapshot.h"
+#include "core/thread/TaskRunnerGetter.h"
 #include "core/utils/GpgUtils.h"
 
 namespace GpgFrontend {
@@ -41,7 +47,15 @@ namespace GpgFrontend {
 class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
  public:
   explicit Impl(int channel)
-      : SingletonFunctionObject<GpgKeyGetter::Impl>(channel) {}
+      : SingletonFunctionObject<GpgKeyGetter::Impl>(channel) {
+    snapshot_guard_->impl = this;
+  }
+
+  ~Impl() {
+    // waits for a snapshot being written on the io runner right now
+    std::lock_guard<std::mutex> lock(snapshot_guard_->lock);
+    snapshot_guard_->impl = nullptr;
+  }
 
   auto GetKey(const QString& fpr, bool use_cache) -> GpgKey {
     // find in cache first
@@ -74,81 +88,81 @@ class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
   }
 
   auto FetchKey() -> GpgKeyList {
-    if (keys_search_cache_.empty()) {
-      FlushKeyCache();
-    }
+    ensure_cache_loaded();
 
     auto keys_list = GpgKeyList{};
     {
       // get the lock
-      std::lock_guard<std::mutex> lock(keys_cache_mutex_);
-      for (const auto& key : keys_cache_) {
-        keys_list.push_back(key);
+      std::shared_lock<std::shared_mutex> lock(keys_cache_mutex_);
+      for (const auto& fpr : keys_cache_.order) {
+        keys_list.push_back(keys_cache_.keys.value(fpr));
       }
     }
     return keys_list;
   }
 
-  auto FetchGpgKeyList() -> GpgKeyList {
-    if (keys_search_cache_.empty()) {
-      FlushKeyCache();
-    }
-
-    auto keys_list = GpgKeyList{};
-    {
-      // get the lock
-      std::lock_guard<std::mutex> lock(keys_cache_mutex_);
-      for (const auto& key : keys_cache_) {
-        keys_list.push_back(key);
-      }
-    }
-    return keys_list;
-  }
+  auto FetchGpgKeyList() -> GpgKeyList { return FetchKey(); }
 
   auto FlushKeyCache() -> bool {
-    // clear the keys cache
-    keys_cache_.clear();
-    keys_search_cache_.clear();
-
-    // init
-    GpgError err = gpgme_op_keylist_start(ctx_.DefaultContext(), nullptr, 0);
+    std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+    return flush_key_cache();
+  }
 
-    // for debug
-    assert(CheckGpgError(err) == GPG_ERR_NO_ERROR);
+  auto SyncKeyCache() -> bool {
+    const auto stamp = snapshot_.GetKeyringStamp();
+    if (cache_loaded_ && !stamp.isEmpty()) {
+      std::lock_guard<std::mutex> lock(stamp_mutex_);
+      if (stamp == cache_stamp_) return true;
+    }
 
-    // return when error
-    if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+    LOG_D() << "keyring changed outside of the key cache, channel:"
+            << SingletonFunctionObject::GetChannel();
+    return FlushKeyCache();
+  }
 
-    {
-      // get the lock
-      std::lock_guard<std::mutex> lock(keys_cache_mutex_);
-      gpgme_key_t key;
-      while ((err = gpgme_op_keylist_next(ctx_.DefaultContext(), &key)) ==
-             GPG_ERR_NO_ERROR) {
-        auto gpg_key = GpgKey(std::move(key));
-
-        // detect if the key is in a smartcard
-        // if so, try to get full information using gpgme_get_key()
-        // this maybe a bug in gpgme
-        if (gpg_key.IsHasCardKey()) {
-          gpg_key = GetKey(gpg_key.GetId(), false);
-        }
+  auto GetKeyringStamp() -> QByteArray { return snapshot_.GetKeyringStamp(); }
 
-        keys_cache_.push_back(gpg_key);
-        keys_search_cache_.insert(gpg_key.GetId(), gpg_key);
-        keys_search_cache_.insert(gpg_key.GetFingerprint(), gpg_key);
+  auto UpdateKeyCache(const KeyIdArgsList& key_ids,
+                      const QByteArray& before_stamp) -> bool {
+    QStringList patterns;
+    for (const auto& key_id : key_ids) {
+      if (!key_id.isEmpty() && !patterns.contains(key_id)) {
+        patterns.append(key_id);
       }
     }
 
-    // for debug
-    assert(CheckGpgError2ErrCode(err, GPG_ERR_EOF) == GPG_ERR_EOF);
+    // the listing shares the gpgme context with the full listings
+    std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+    if (!cache_loaded_) return flush_key_cache();
+    if (patterns.isEmpty()) return true;
 
-    err = gpgme_op_keylist_end(ctx_.DefaultContext());
-    assert(CheckGpgError2ErrCode(err, GPG_ERR_EOF) == GPG_ERR_NO_ERROR);
+    const auto stamp = snapshot_.GetKeyringStamp();
+    if (!update_keys(patterns)) return false;
 
+    // only the listed keys are in the cache now, a change made by someone
+    // else before the operation is left to the next SyncKeyCache()
+    if (!advance_cache_stamp(before_stamp, stamp)) {
+      LOG_D() << "keyring changed before the update, channel:"
+              << SingletonFunctionObject::GetChannel();
+      return true;
+    }
+
+    schedule_snapshot(stamp);
     return true;
   }
 
+  auto GetKeysByEmail(const QString& email) -> GpgKeyList {
+    ensure_cache_loaded();
+
+    auto keys = GpgKeyList{};
+    std::shared_lock<std::shared_mutex> lock(keys_cache_mutex_);
+    for (const auto& fpr :
+         keys_cache_.email_index.values(email.trimmed().toLower())) {
+      keys.push_back(keys_cache_.keys.value(fpr));
+    }
+    return keys;
+  }
+
   auto GetKeys(const KeyIdArgsList& ids) -> GpgKeyList {
     auto keys = GpgKeyList{};
     for (const auto& key_id : ids) keys.push_back(GetKey(key_id, true));
@@ -164,11 +178,111 @@ class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
   }
 
   auto GetGpgKeyTableModel() -> QSharedPointer<GpgKeyTableModel> {
+    // show the snapshot while the keyring is listed in the background
+    if (!cache_loaded_ && snapshot_.IsLoaded()) {
+      return SecureCreateQSharedObject<GpgKeyTableModel>(
+          SingletonFunctionObject::GetChannel(), snapshot_.GetRows(), nullptr);
+    }
+
     return SecureCreateQSharedObject<GpgKeyTableModel>(
         SingletonFunctionObject::GetChannel(), FetchGpgKeyList(), nullptr);
   }
 
  private:
+  /**
+   * @brief keys in keyring order with indexes on their identifiers
+   *
+   */
+  struct KeyCache {
+    QHash<QString, GpgKey> keys;               ///< primary fpr -> key
+    QContainer<QString> order;                 ///< primary fprs
+    QHash<QString, QString> id_index;          ///< key and subkey ids, fprs
+    QMultiHash<QString, QString> email_index;  ///< lower case emails
+
+    void Upsert(const GpgKey& key) {
+      const auto fpr = key.GetFingerprint();
+      if (keys.contains(fpr)) {
+        unindex(keys.value(fpr));
+      } else {
+        order.push_back(fpr);
+      }
+
+      keys.insert(fpr, key);
+      index(key);
+    }
+
+    void Remove(const QString& fpr) {
+      if (!keys.contains(fpr)) return;
+
+      unindex(keys.value(fpr));
+      keys.remove(fpr);
+      order.removeOne(fpr);
+    }
+
+    [[nodiscard]] auto Resolve(const QString& key_id) const -> QString {
+      return id_index.value(key_id);
+    }
+
+   private:
+    void index(const GpgKey& key) {
+      const auto fpr = key.GetFingerprint();
+      id_index.insert(key.GetId(), fpr);
+      id_index.insert(fpr, fpr);
+
+      for (const auto& s_key : *key.GetSubKeys()) {
+        id_index.insert(s_key.GetID(), fpr);
+        id_index.insert(s_key.GetFingerprint(), fpr);
+      }
+
+      for (const auto& uid : *key.GetUIDs()) {
+        const auto email = uid.GetEmail().trimmed().toLower();
+        if (!email.isEmpty()) email_index.insert(email, fpr);
+      }
+    }
+
+    void unindex(const GpgKey& key) {
+      const auto fpr = key.GetFingerprint();
+      auto remove_id = [&](const QString& id) {
+        if (id_index.value(id) == fpr) id_index.remove(id);
+      };
+
+      remove_id(key.GetId());
+      remove_id(fpr);
+      for (const auto& s_key : *key.GetSubKeys()) {
+        remove_id(s_key.GetID());
+        remove_id(s_key.GetFingerprint());
+      }
+
+      for (const auto& uid : *key.GetUIDs()) {
+        email_index.remove(uid.GetEmail().trimmed().toLower(), fpr);
+      }
+    }
+  };
+
+  /**
+   * @brief patterns per keylist operation of an incremental update
+   *
+   */
+  static constexpr qsizetype kKeyListPatternBatchSize = 64;
+
+  /**
+   * @brief how long the snapshot waits for more updates before it is written
+   *
+   */
+  static constexpr std::chrono::milliseconds kSnapshotSaveDelay{2000};
+
+  /**
+   * @brief how the delayed snapshot task on the io runner reaches the impl,
+   * the destructor detaches it under the lock.
+   *
+   */
+  struct SnapshotGuard {
+    std::mutex lock;
+    Impl* impl = nullptr;
+    QByteArray stamp;        ///< stamp of the latest update
+    bool scheduled = false;  ///< a snapshot task is waiting
+  };
+
   /**
    * @brief Get the gpgme context object
    *
@@ -176,6 +290,13 @@ class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
   GpgContext& ctx_ =
       GpgContext::GetInstance(SingletonFunctionObject::GetChannel());
 
+  /**
+   * @brief the key table values kept on disk for the next start
+   *
+   */
+  GpgKeyTableSnapshot& snapshot_ =
+      GpgKeyTableSnapshot::GetInstance(SingletonFunctionObject::GetChannel());
+
   /**
    * @brief shared mutex for the keys cache
    *
@@ -183,22 +304,47 @@ class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
   mutable std::mutex ctx_mutex_;
 
   /**
-   * @brief cache the keys with key id
+   * @brief the keys cache
    *
    */
-  QMap<QString, GpgKey> keys_search_cache_;
+  KeyCache keys_cache_;
 
   /**
-   * @brief
+   * @brief shared mutex for the keys cache
    *
    */
-  QContainer<GpgKey> keys_cache_;
+  mutable std::shared_mutex keys_cache_mutex_;
 
   /**
-   * @brief shared mutex for the keys cache
+   * @brief if the whole keyring has been listed once
+   *
+   */
+  std::atomic_bool cache_loaded_ = false;
+
+  /**
+   * @brief one listing at a time, full or not, they use the same context
+   *
+   */
+  std::mutex flush_mutex_;
+
+  /**
+   * @brief the state of the delayed snapshot
+   *
+   */
+  std::shared_ptr<SnapshotGuard> snapshot_guard_ =
+      std::make_shared<SnapshotGuard>();
+
+  /**
+   * @brief guards the stamp below
+   *
+   */
+  std::mutex stamp_mutex_;
+
+  /**
+   * @brief stamp of the keyring the cache is in sync with
    *
    */
-  mutable std::mutex keys_cache_mutex_;
+  QByteArray cache_stamp_;
 
   /**
    * @brief Get the Key object
@@ -207,15 +353,209 @@ class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
    * @return GpgKey
    */
   auto get_key_in_cache(const QString& key_id) -> GpgKey {
-    std::lock_guard<std::mutex> lock(keys_cache_mutex_);
-    if (keys_search_cache_.find(key_id) != keys_search_cache_.end()) {
-      std::lock_guard<std::mutex> lock(ctx_mutex_);
-      // return a copy of the key in cache
-      return keys_search_cache_[key_id];
-    }
+    std::shared_lock<std::shared_mutex> lock(keys_cache_mutex_);
+    const auto fpr = keys_cache_.Resolve(key_id);
 
     // return a bad key
-    return {};
+    if (fpr.isEmpty()) return {};
+
+    // return a copy of the key in cache
+    return keys_cache_.keys.value(fpr);
+  }
+
+  /**
+   * @brief list the whole keyring and replace the cache, should be called
+   * with flush_mutex_ held
+   *
+   * @return true if the listing completed
+   */
+  auto flush_key_cache() -> bool {
+    const auto stamp = snapshot_.GetKeyringStamp();
+
+    // build the new cache aside, lookups keep using the old one meanwhile
+    KeyCache cache;
+    if (!list_keys({}, [&](const GpgKey& key) { cache.Upsert(key); })) {
+      return false;
+    }
+
+    {
+      std::unique_lock<std::shared_mutex> lock(keys_cache_mutex_);
+      keys_cache_ = std::move(cache);
+    }
+
+    cache_loaded_ = true;
+    set_cache_stamp(stamp);
+
+    save_snapshot(stamp);
+    return true;
+  }
+
+  /**
+   * @brief list the keyring unless the cache was loaded already. If another
+   * thread is listing it right now, e.g. the reconcile task at startup,
+   * wait for it instead of listing it a second time.
+   *
+   * @return true if the cache is loaded
+   */
+  auto ensure_cache_loaded() -> bool {
+    if (cache_loaded_) return true;
+
+    std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+    return cache_loaded_ || flush_key_cache();
+  }
+
+  /**
+   * @brief list the keys matching the patterns again and replace them in the
+   * cache, keys which can't be listed anymore are removed. Should be called
+   * with flush_mutex_ held.
+   *
+   * @param patterns
+   * @return true if the listing completed
+   */
+  auto update_keys(const QStringList& patterns) -> bool {
+    QContainer<GpgKey> keys;
+    for (qsizetype i = 0; i < patterns.size(); i += kKeyListPatternBatchSize) {
+      if (!list_keys(patterns.mid(i, kKeyListPatternBatchSize),
+                     [&](const GpgKey& key) { keys.push_back(key); })) {
+        return false;
+      }
+    }
+
+    QSet<QString> listed_fprs;
+    for (const auto& key : keys) listed_fprs.insert(key.GetFingerprint());
+
+    {
+      std::unique_lock<std::shared_mutex> lock(keys_cache_mutex_);
+
+      // keys which can't be listed anymore have been deleted
+      for (const auto& pattern : patterns) {
+        const auto fpr = keys_cache_.Resolve(pattern);
+        if (!fpr.isEmpty() && !listed_fprs.contains(fpr)) {
+          keys_cache_.Remove(fpr);
+        }
+      }
+
+      for (const auto& key : keys) keys_cache_.Upsert(key);
+    }
+
+    LOG_D() << "key cache updated, keys:" << keys.size()
+            << "requested:" << patterns.size();
+    return true;
+  }
+
+  void set_cache_stamp(const QByteArray& stamp) {
+    std::lock_guard<std::mutex> lock(stamp_mutex_);
+    cache_stamp_ = stamp;
+  }
+
+  /**
+   * @brief move the stamp of the cache to the stamp after an operation, if
+   * the cache was in sync with the keyring before it
+   *
+   * @return true if the stamp was moved
+   */
+  auto advance_cache_stamp(const QByteArray& before,
+                           const QByteArray& after) -> bool {
+    std::lock_guard<std::mutex> lock(stamp_mutex_);
+    if (before.isEmpty() || cache_stamp_ != before) return false;
+
+    cache_stamp_ = after;
+    return true;
+  }
+
+  /**
+   * @brief write the snapshot on the io runner once the updates settle, so
+   * a burst of single key edits rewrites it once.
+   *
+   * @param stamp stamp of the keyring taken before the keys were listed
+   */
+  void schedule_snapshot(const QByteArray& stamp) {
+    {
+      std::lock_guard<std::mutex> lock(snapshot_guard_->lock);
+      snapshot_guard_->stamp = stamp;
+      if (std::exchange(snapshot_guard_->scheduled, true)) return;
+    }
+
+    Thread::TaskRunnerGetter::GetInstance()
+        .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_IO)
+        ->PostScheduleTask(
+            new Thread::Task(
+                [guard = snapshot_guard_](const DataObjectPtr&) -> int {
+                  std::lock_guard<std::mutex> lock(guard->lock);
+                  guard->scheduled = false;
+                  if (guard->impl != nullptr) {
+                    guard->impl->save_snapshot(guard->stamp);
+                  }
+                  return 0;
+                },
+                "key_table_snapshot_save_task"),
+            kSnapshotSaveDelay);
+  }
+
+  /**
+   * @brief write the rows of the cached keys to the key table snapshot
+   *
+   * @param stamp stamp of the keyring taken before the keys were listed
+   */
+  void save_snapshot(const QByteArray& stamp) {
+    QContainer<GpgKeyTableRow> rows;
+    {
+      std::shared_lock<std::shared_mutex> lock(keys_cache_mutex_);
+      rows.reserve(keys_cache_.order.size());
+      for (const auto& fpr : keys_cache_.order) {
+        rows.push_back(GpgKeyTableRow(keys_cache_.keys.value(fpr)));
+      }
+    }
+    snapshot_.Save(stamp, rows);
+  }
+
+  /**
+   * @brief list the keys matching the patterns, all keys if empty
+   *
+   * @param patterns
+   * @param callback
+   * @return true if the listing completed
+   */
+  auto list_keys(const QStringList& patterns,
+                 const std::function<void(const GpgKey&)>& callback) -> bool {
+    std::vector<QByteArray> pattern_buffers;
+    std::vector<const char*> pattern_ptrs;
+    pattern_buffers.reserve(patterns.size());
+    for (const auto& pattern : patterns) {
+      pattern_buffers.push_back(pattern.toUtf8());
+    }
+    for (const auto& buffer : pattern_buffers) {
+      pattern_ptrs.push_back(buffer.constData());
+    }
+    pattern_ptrs.push_back(nullptr);
+
+    auto* ctx = ctx_.DefaultContext();
+    GpgError err =
+        patterns.isEmpty()
+            ? gpgme_op_keylist_start(ctx, nullptr, 0)
+            : gpgme_op_keylist_ext_start(ctx, pattern_ptrs.data(), 0, 0);
+
+    // return when error
+    if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+
+    gpgme_key_t key;
+    while ((err = gpgme_op_keylist_next(ctx, &key)) == GPG_ERR_NO_ERROR) {
+      auto gpg_key = GpgKey(std::move(key));
+
+      // detect if the key is in a smartcard
+      // if so, try to get full information using gpgme_get_key()
+      // this maybe a bug in gpgme
+      if (gpg_key.IsHasCardKey()) {
+        gpg_key = GetKey(gpg_key.GetId(), false);
+      }
+
+      callback(gpg_key);
+    }
+
+    const auto eof = CheckGpgError2ErrCode(err, GPG_ERR_EOF) == GPG_ERR_EOF;
+
+    err = gpgme_op_keylist_end(ctx);
+    return eof && CheckGpgError(err) == GPG_ERR_NO_ERROR;
   }
 };
 
@@ -235,6 +575,21 @@ auto GpgKeyGetter::GetPubkey(const QString& key_id, bool use_cache) -> GpgKey {
 
 auto GpgKeyGetter::FlushKeyCache() -> bool { return p_->FlushKeyCache(); }
 
+auto GpgKeyGetter::SyncKeyCache() -> bool { return p_->SyncKeyCache(); }
+
+auto GpgKeyGetter::GetKeyringStamp() -> QByteArray {
+  return p_->GetKeyringStamp();
+}
+
+auto GpgKeyGetter::UpdateKeyCache(const KeyIdArgsList& key_ids,
+                                  const QByteArray& before_stamp) -> bool {
+  return p_->UpdateKeyCache(key_ids, before_stamp);
+}
+
+auto GpgKeyGetter::GetKeysByEmail(const QString& email) -> GpgKeyList {
+  return p_->GetKeysByEmail(email);
+}
+
 auto GpgKeyGetter::GetKeys(const KeyIdArgsList& ids) -> GpgKeyList {
   return p_->GetKeys(ids);
 }
@@ -86,11 +86,48 @@ class GPGFRONTEND_CORE_EXPORT GpgKeyGetter
   auto FetchKey() -> GpgKeyList;
 
   /**
-   * @brief flush the keys in the cache
+   * @brief list the whole keyring again and replace the keys in the cache
    *
    */
   auto FlushKeyCache() -> bool;
 
+  /**
+   * @brief list the whole keyring again only if it was changed by something
+   * that didn't update the cache, e.g. gpg run by a module or by the user.
+   *
+   * @return true if success
+   */
+  auto SyncKeyCache() -> bool;
+
+  /**
+   * @brief Get the stamp of the keyring files, take it before an operation
+   * changing the keyring and pass it to UpdateKeyCache()
+   *
+   * @return QByteArray
+   */
+  auto GetKeyringStamp() -> QByteArray;
+
+  /**
+   * @brief list only the given keys again, keys which are gone are removed
+   * from the cache. Called after the keys are imported, deleted or edited.
+   * The cache stays in sync with the keyring only if it was in sync at
+   * before_stamp, otherwise the next SyncKeyCache() lists all keys.
+   *
+   * @param key_ids fingerprints or key ids
+   * @param before_stamp stamp of the keyring taken before the operation
+   * @return true if success
+   */
+  auto UpdateKeyCache(const KeyIdArgsList& key_ids,
+                      const QByteArray& before_stamp) -> bool;
+
+  /**
+   * @brief Get the keys having a uid with the email
+   *
+   * @param email
+   * @return GpgKeyList
+   */
+  auto GetKeysByEmail(const QString& email) -> GpgKeyList;
+
   /**
    * @brief Get the Keys Copy object
    *
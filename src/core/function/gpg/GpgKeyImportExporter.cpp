@@ -29,6 +29,7 @@
 #include "GpgKeyImportExporter.h"
 
 #include "core/GpgModel.h"
+#include "core/function/gpg/GpgKeyGetter.h"
 #include "core/model/GpgImportInformation.h"
 #include "core/utils/AsyncUtils.h"
 #include "core/utils/GpgUtils.h"
@@ -49,6 +50,14 @@ auto GpgKeyImportExporter::ImportKey(const GFBuffer& in_buffer)
   if (in_buffer.Empty()) return {};
 
   GpgData data_in(in_buffer);
+  return ImportKey(data_in);
+}
+
+auto GpgKeyImportExporter::ImportKey(GpgData& data_in)
+    -> std::shared_ptr<GpgImportInformation> {
+  auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   auto err = CheckGpgError(gpgme_op_import(ctx_.BinaryContext(), data_in));
   if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return {};
 
@@ -63,6 +72,13 @@ auto GpgKeyImportExporter::ImportKey(const GFBuffer& in_buffer)
     import_info->imported_keys.push_back(key);
     status = status->next;
   }
+
+  // only the imported keys need to be listed again
+  KeyIdArgsList fprs;
+  for (const auto& key : import_info->imported_keys) {
+    if (!key.fpr.isEmpty()) fprs.append(key.fpr);
+  }
+  key_getter.UpdateKeyCache(fprs, stamp);
   return import_info;
 }
 
@@ -141,37 +157,33 @@ void GpgKeyImportExporter::ExportAllKeys(const KeyArgsList& keys, bool secret,
                                          const GpgOperationCallback& cb) const {
   RunGpgOperaAsync(
       [=](const DataObjectPtr& data_object) -> GpgError {
-        if (keys.empty()) return GPG_ERR_CANCELED;
-
-        int mode = 0;
-        QContainer<gpgme_key_t> keys_array(keys.begin(), keys.end());
-
-        // Last entry data_in array has to be nullptr
-        keys_array.push_back(nullptr);
-
         GpgData data_out;
-        auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
-        auto err = gpgme_op_export_keys(ctx, keys_array.data(), mode, data_out);
+        auto err = ExportAllKeys(keys, secret, ascii, data_out);
         if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
 
-        auto buffer = data_out.Read2GFBuffer();
+        data_object->Swap({data_out.Read2GFBuffer()});
+        return err;
+      },
+      cb, "gpgme_op_export_keys", "2.1.0");
+}
+
+auto GpgKeyImportExporter::ExportAllKeys(const KeyArgsList& keys, bool secret,
+                                         bool ascii, GpgData& data_out) const
+    -> GpgError {
+  if (keys.empty()) return GPG_ERR_CANCELED;
 
-        if (secret) {
-          int mode = 0;
-          mode |= GPGME_EXPORT_MODE_SECRET;
+  QContainer<gpgme_key_t> keys_array(keys.begin(), keys.end());
 
-          GpgData data_out_secret;
-          auto err = gpgme_op_export_keys(ctx, keys_array.data(), mode,
-                                          data_out_secret);
-          if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
+  // Last entry data_in array has to be nullptr
+  keys_array.push_back(nullptr);
 
-          buffer.Append(data_out_secret.Read2GFBuffer());
-        }
+  // the secret keys follow the public ones in the same data
+  auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
+  auto err = gpgme_op_export_keys(ctx, keys_array.data(), 0, data_out);
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR || !secret) return err;
 
-        data_object->Swap({buffer});
-        return err;
-      },
-      cb, "gpgme_op_export_keys", "2.1.0");
+  return gpgme_op_export_keys(ctx, keys_array.data(), GPGME_EXPORT_MODE_SECRET,
+                              data_out);
 }
 
 auto GpgKeyImportExporter::ExportSubkey(const QString& fpr, bool ascii) const
@@ -31,6 +31,7 @@
 #include "core/function/basic/GpgFunctionObject.h"
 #include "core/function/gpg/GpgContext.h"
 #include "core/model/GFBuffer.h"
+#include "core/model/GpgData.h"
 #include "core/typedef/GpgTypedef.h"
 
 namespace GpgFrontend {
@@ -60,6 +61,15 @@ class GPGFRONTEND_CORE_EXPORT GpgKeyImportExporter
    */
   auto ImportKey(const GFBuffer&) -> std::shared_ptr<GpgImportInformation>;
 
+  /**
+   * @brief import the keys read from the data, e.g. a callback backed one
+   * which streams them
+   *
+   * @param data_in
+   * @return std::shared_ptr<GpgImportInformation>
+   */
+  auto ImportKey(GpgData& data_in) -> std::shared_ptr<GpgImportInformation>;
+
   /**
    * @brief
    *
@@ -106,6 +116,19 @@ class GPGFRONTEND_CORE_EXPORT GpgKeyImportExporter
   void ExportAllKeys(const KeyArgsList& keys, bool secret, bool ascii,
                      const GpgOperationCallback& cb) const;
 
+  /**
+   * @brief export the public keys, followed by the secret ones if required,
+   * into the data. It runs on the calling thread.
+   *
+   * @param keys
+   * @param secret
+   * @param ascii
+   * @param data_out
+   * @return GpgError
+   */
+  auto ExportAllKeys(const KeyArgsList& keys, bool secret, bool ascii,
+                     GpgData& data_out) const -> GpgError;
+
  private:
   GpgContext& ctx_;
 };
@@ -53,16 +53,22 @@ auto GpgKeyManager::SignKey(const GpgKey& target, KeyArgsList& keys,
     expires_time_t = expires->toSecsSinceEpoch();
   }
 
+  auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   auto err = CheckGpgError(
       gpgme_op_keysign(ctx_.DefaultContext(), static_cast<gpgme_key_t>(target),
                        uid.toUtf8(), expires_time_t, flags));
+  if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
 
-  return CheckGpgError(err) == GPG_ERR_NO_ERROR;
+  key_getter.UpdateKeyCache({target.GetFingerprint()}, stamp);
+  return true;
 }
 
 auto GpgKeyManager::RevSign(const GpgKey& key,
                             const SignIdArgsList& signature_id) -> bool {
   auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
 
   for (const auto& sign_id : signature_id) {
     auto signing_key = key_getter.GetKey(sign_id.first);
@@ -71,8 +77,13 @@ auto GpgKeyManager::RevSign(const GpgKey& key,
     auto err = CheckGpgError(
         gpgme_op_revsig(ctx_.DefaultContext(), gpgme_key_t(key),
                         gpgme_key_t(signing_key), sign_id.second.toUtf8(), 0));
-    if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+    if (CheckGpgError(err) != GPG_ERR_NO_ERROR) {
+      key_getter.UpdateKeyCache({key.GetFingerprint()}, stamp);
+      return false;
+    }
   }
+
+  key_getter.UpdateKeyCache({key.GetFingerprint()}, stamp);
   return true;
 }
 
@@ -87,11 +98,16 @@ auto GpgKeyManager::SetExpire(const GpgKey& key,
 
   if (subkey != nullptr) sub_fprs = subkey->GetFingerprint().toUtf8();
 
+  auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   auto err = CheckGpgError(gpgme_op_setexpire(ctx_.DefaultContext(),
                                               static_cast<gpgme_key_t>(key),
                                               expires_time, sub_fprs, 0));
+  if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
 
-  return CheckGpgError(err) == GPG_ERR_NO_ERROR;
+  key_getter.UpdateKeyCache({key.GetFingerprint()}, stamp);
+  return true;
 }
 
 auto GpgKeyManager::SetOwnerTrustLevel(const GpgKey& key,
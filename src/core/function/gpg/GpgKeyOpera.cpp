@@ -50,18 +50,25 @@ GpgKeyOpera::GpgKeyOpera(int channel)
  * @param uidList key ids
  */
 void GpgKeyOpera::DeleteKeys(KeyIdArgsList key_ids) {
+  auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   GpgError err;
+  KeyIdArgsList fprs;
   for (const auto& tmp : key_ids) {
-    auto key = GpgKeyGetter::GetInstance(GetChannel()).GetKey(tmp);
+    auto key = key_getter.GetKey(tmp);
     if (key.IsGood()) {
       err = CheckGpgError(gpgme_op_delete_ext(
           ctx_.DefaultContext(), static_cast<gpgme_key_t>(key),
           GPGME_DELETE_ALLOW_SECRET | GPGME_DELETE_FORCE));
       assert(gpg_err_code(err) == GPG_ERR_NO_ERROR);
+      fprs.append(key.GetFingerprint());
     } else {
       LOG_W() << "GpgKeyOpera DeleteKeys get key failed: " << tmp;
     }
   }
+
+  key_getter.UpdateKeyCache(fprs, stamp);
 }
 
 /**
@@ -80,6 +87,9 @@ auto GpgKeyOpera::SetExpire(const GpgKey& key, const SubkeyId& subkey_fpr,
     expires_time = QDateTime::currentDateTime().secsTo(*expires);
   }
 
+  auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   GpgError err;
   if (key.GetFingerprint() == subkey_fpr || subkey_fpr.isEmpty()) {
     err =
@@ -93,6 +103,7 @@ auto GpgKeyOpera::SetExpire(const GpgKey& key, const SubkeyId& subkey_fpr,
     assert(gpg_err_code(err) == GPG_ERR_NO_ERROR);
   }
 
+  key_getter.UpdateKeyCache({key.GetFingerprint()}, stamp);
   return err;
 }
 
@@ -190,12 +201,21 @@ auto GenerateKeyImpl(GpgContext& ctx,
           << params->IsAllowSign() << params->IsAllowAuth()
           << !params->IsSubKey();
 
+  auto& key_getter = GpgKeyGetter::GetInstance(ctx.GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
+  // the passphrase requested while creating the key is the new one
+  GpgContext::SetAskForNewPassphrase(ctx.DefaultContext(),
+                                     !params->IsNoPassPhrase());
   err = gpgme_op_createkey(ctx.DefaultContext(), userid.toUtf8(), algo.toUtf8(),
                            0, expires, nullptr, flags);
+  GpgContext::SetAskForNewPassphrase(ctx.DefaultContext(), false);
 
   if (CheckGpgError(err) == GPG_ERR_NO_ERROR) {
-    data_object->Swap(
-        {GpgGenerateKeyResult{gpgme_op_genkey_result(ctx.DefaultContext())}});
+    auto result =
+        GpgGenerateKeyResult{gpgme_op_genkey_result(ctx.DefaultContext())};
+    key_getter.UpdateKeyCache({result.GetFingerprint()}, stamp);
+    data_object->Swap({result});
   } else {
     data_object->Swap({GpgGenerateKeyResult{}});
   }
@@ -249,6 +269,9 @@ auto GenerateSubKeyImpl(GpgContext& ctx, const GpgKey& key,
   LOG_D() << "subkey generation args: " << key.GetId() << algo << expires
           << flags;
 
+  auto& key_getter = GpgKeyGetter::GetInstance(ctx.GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   auto err =
       gpgme_op_createsubkey(ctx.DefaultContext(), static_cast<gpgme_key_t>(key),
                             algo.toLatin1(), 0, expires, flags);
@@ -259,6 +282,7 @@ auto GenerateSubKeyImpl(GpgContext& ctx, const GpgKey& key,
 
   data_object->Swap(
       {GpgGenerateKeyResult{gpgme_op_genkey_result(ctx.DefaultContext())}});
+  key_getter.UpdateKeyCache({key.GetFingerprint()}, stamp);
   return CheckGpgError(err);
 }
 
@@ -354,8 +378,14 @@ auto GpgKeyOpera::ModifyTOFUPolicy(
     return GPG_ERR_NOT_SUPPORTED;
   }
 
+  auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   auto err = gpgme_op_tofu_policy(ctx_.DefaultContext(),
                                   static_cast<gpgme_key_t>(key), tofu_policy);
+  if (CheckGpgError(err) == GPG_ERR_NO_ERROR) {
+    key_getter.UpdateKeyCache({key.GetFingerprint()}, stamp);
+  }
   return CheckGpgError(err);
 }
 
@@ -0,0 +1,309 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "GpgKeyTableSnapshot.h"
+
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+
+#include "core/function/DataObjectOperator.h"
+#include "core/function/GlobalSettingStation.h"
+#include "core/module/ModuleManager.h"
+
+namespace GpgFrontend {
+
+namespace {
+
+constexpr quint32 kSnapshotMagic = 0x47464B54;  // GFKT
+constexpr quint32 kSnapshotVersion = 3;
+constexpr auto kSnapshotStreamVersion = QDataStream::Qt_5_12;
+
+/**
+ * @brief bytes a row takes at least on disk, bounds the reservation for a
+ * broken row count
+ *
+ */
+constexpr qsizetype kSnapshotMinRowSize = 10 * 4 + 8 + 4 + 1;
+
+enum SnapshotRowFlag : quint8 {
+  kPRIVATE = 1 << 0,
+  kREVOKED = 1 << 1,
+  kDISABLED = 1 << 2,
+  kEXPIRED = 1 << 3,
+};
+
+/**
+ * @brief the files gpg changes when keys, secret keys or the trust and
+ * validity of keys are changed
+ *
+ */
+const QStringList kKeyringFiles = {"pubring.kbx", "pubring.gpg",
+                                   "private-keys-v1.d", "trustdb.gpg"};
+
+}  // namespace
+
+class GpgKeyTableSnapshot::Impl {
+ public:
+  explicit Impl(GpgKeyTableSnapshot* parent) : parent_(parent) {}
+
+  [[nodiscard]] auto GetKeyringStamp() const -> QByteArray {
+    const auto database_path = key_database_path();
+    if (database_path.isEmpty()) return {};
+
+    // the owner trust is translated, so is the snapshot
+    auto stamp = QLocale().name().toUtf8();
+    for (const auto& file : kKeyringFiles) {
+      const QFileInfo info(QDir(database_path).filePath(file));
+
+      stamp += ';' + file.toUtf8() + ':';
+      if (!info.exists()) {
+        stamp += '-';
+        continue;
+      }
+      stamp += QByteArray::number(info.size()) + ':' +
+               QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+    }
+    return stamp;
+  }
+
+  auto Load() -> bool {
+    const auto stamp = GetKeyringStamp();
+    if (stamp.isEmpty()) return false;
+
+    const auto path = snapshot_path();
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    const auto size = file.size();
+    if (size <= 0 || size > std::numeric_limits<int>::max()) return false;
+
+    auto* mapped = file.map(0, size);
+    if (mapped == nullptr) {
+      LOG_W() << "cannot map key table snapshot: " << file.fileName();
+      return false;
+    }
+
+    // decrypt straight out of the mapping
+    const auto data = DataObjectOperator::GetInstance().UnsealData(
+        QByteArray::fromRawData(reinterpret_cast<const char*>(mapped),
+                                static_cast<int>(size)),
+        snapshot_aad(path));
+    file.unmap(mapped);
+
+    QContainer<GpgKeyTableRow> rows;
+    if (!data || !decode(*data, stamp, rows)) {
+      LOG_D() << "key table snapshot is outdated, channel: "
+              << parent_->GetChannel();
+      return false;
+    }
+
+    LOG_D() << "key table snapshot loaded, channel: " << parent_->GetChannel()
+            << "rows: " << rows.size();
+
+    std::unique_lock<std::shared_mutex> lock(rows_mutex_);
+    rows_ = std::move(rows);
+    loaded_ = true;
+    return true;
+  }
+
+  [[nodiscard]] auto IsLoaded() const -> bool {
+    std::shared_lock<std::shared_mutex> lock(rows_mutex_);
+    return loaded_;
+  }
+
+  [[nodiscard]] auto GetRows() const -> QContainer<GpgKeyTableRow> {
+    std::shared_lock<std::shared_mutex> lock(rows_mutex_);
+    return rows_;
+  }
+
+  void Release() {
+    std::unique_lock<std::shared_mutex> lock(rows_mutex_);
+    rows_.clear();
+    rows_.squeeze();
+    loaded_ = false;
+  }
+
+  auto Save(const QByteArray& stamp,
+            const QContainer<GpgKeyTableRow>& rows) -> bool {
+    if (stamp.isEmpty()) return false;
+
+    std::lock_guard<std::mutex> lock(save_mutex_);
+
+    const auto path = snapshot_path();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(kSnapshotStreamVersion);
+    stream << kSnapshotMagic << kSnapshotVersion << stamp
+           << static_cast<quint32>(rows.size());
+
+    for (const auto& row : rows) {
+      quint8 flags = 0;
+      if (row.is_private) flags |= kPRIVATE;
+      if (row.is_revoked) flags |= kREVOKED;
+      if (row.is_disabled) flags |= kDISABLED;
+      if (row.is_expired) flags |= kEXPIRED;
+
+      stream << row.fpr << row.id << row.type << row.name << row.email
+             << row.usage << row.owner_trust << row.algo << row.comment
+             << row.uids
+             << static_cast<qint64>(row.create_time.toSecsSinceEpoch())
+             << static_cast<qint32>(row.subkeys_count) << flags;
+    }
+
+    // the names, emails and user ids are sealed like the data objects
+    const auto sealed =
+        stream.status() == QDataStream::Ok
+            ? DataObjectOperator::GetInstance().SealData(data,
+                                                         snapshot_aad(path))
+            : QByteArray{};
+
+    // the old snapshot stays in place until the new one is complete
+    QSaveFile file(path);
+    if (sealed.isEmpty() || !file.open(QIODevice::WriteOnly)) {
+      LOG_W() << "cannot write key table snapshot: " << path;
+      return false;
+    }
+
+    // restricted before anything is written
+    if (!file.setPermissions(QFileDevice::ReadOwner |
+                             QFileDevice::WriteOwner)) {
+      LOG_W() << "cannot restrict permissions of key table snapshot: " << path;
+    }
+
+    if (file.write(sealed) != sealed.size() || !file.commit()) {
+      LOG_W() << "cannot write key table snapshot: " << path;
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  GpgKeyTableSnapshot* parent_;
+  QContainer<GpgKeyTableRow> rows_;
+  bool loaded_ = false;
+  mutable std::shared_mutex rows_mutex_;
+  std::mutex save_mutex_;
+
+  [[nodiscard]] auto key_database_path() const -> QString {
+    auto database_path = Module::RetrieveRTValueTypedOrDefault<>(
+        "core",
+        QString("gpgme.ctx.list.%1.database_path").arg(parent_->GetChannel()),
+        QString{});
+    if (database_path.isEmpty()) {
+      database_path = Module::RetrieveRTValueTypedOrDefault<>(
+          "core", "gpgme.ctx.default_database_path", QString{});
+    }
+    return database_path;
+  }
+
+  [[nodiscard]] auto snapshot_path() const -> QString {
+    const auto database_path_hash =
+        QCryptographicHash::hash(
+            QDir(key_database_path()).absolutePath().toUtf8(),
+            QCryptographicHash::Sha256)
+            .toHex();
+    return GlobalSettingStation::GetInstance().GetAppDataPath() +
+           "/key_table_snapshots/" + database_path_hash + ".snapshot";
+  }
+
+  static auto snapshot_aad(const QString& path) -> QByteArray {
+    return QFileInfo(path).fileName().toUtf8();
+  }
+
+  static auto decode(const QByteArray& data, const QByteArray& stamp,
+                     QContainer<GpgKeyTableRow>& rows) -> bool {
+    QDataStream stream(data);
+    stream.setVersion(kSnapshotStreamVersion);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != kSnapshotMagic || version != kSnapshotVersion) return false;
+
+    QByteArray file_stamp;
+    quint32 count = 0;
+    stream >> file_stamp >> count;
+    if (stream.status() != QDataStream::Ok || file_stamp != stamp) {
+      return false;
+    }
+
+    rows.reserve(std::min<qsizetype>(count, data.size() / kSnapshotMinRowSize));
+    for (quint32 i = 0; i < count; i++) {
+      GpgKeyTableRow row;
+      qint64 create_time = 0;
+      qint32 subkeys_count = 0;
+      quint8 flags = 0;
+
+      stream >> row.fpr >> row.id >> row.type >> row.name >> row.email >>
+          row.usage >> row.owner_trust >> row.algo >> row.comment >>
+          row.uids >> create_time >> subkeys_count >> flags;
+      if (stream.status() != QDataStream::Ok) return false;
+
+      row.create_time = QDateTime::fromSecsSinceEpoch(create_time);
+      row.subkeys_count = subkeys_count;
+      row.is_private = (flags & kPRIVATE) != 0;
+      row.is_revoked = (flags & kREVOKED) != 0;
+      row.is_disabled = (flags & kDISABLED) != 0;
+      row.is_expired = (flags & kEXPIRED) != 0;
+      rows.push_back(std::move(row));
+    }
+
+    return stream.atEnd();
+  }
+};
+
+GpgKeyTableSnapshot::GpgKeyTableSnapshot(int channel)
+    : SingletonFunctionObject<GpgKeyTableSnapshot>(channel),
+      p_(SecureCreateUniqueObject<Impl>(this)) {}
+
+GpgKeyTableSnapshot::~GpgKeyTableSnapshot() = default;
+
+auto GpgKeyTableSnapshot::GetKeyringStamp() const -> QByteArray {
+  return p_->GetKeyringStamp();
+}
+
+auto GpgKeyTableSnapshot::Load() -> bool { return p_->Load(); }
+
+auto GpgKeyTableSnapshot::IsLoaded() const -> bool { return p_->IsLoaded(); }
+
+auto GpgKeyTableSnapshot::GetRows() const -> QContainer<GpgKeyTableRow> {
+  return p_->GetRows();
+}
+
+void GpgKeyTableSnapshot::Release() { p_->Release(); }
+
+auto GpgKeyTableSnapshot::Save(const QByteArray& stamp,
+                               const QContainer<GpgKeyTableRow>& rows)
+    -> bool {
+  return p_->Save(stamp, rows);
+}
+
+}  // namespace GpgFrontend
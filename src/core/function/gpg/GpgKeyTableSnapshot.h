@@ -0,0 +1,111 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include "core/function/basic/GpgFunctionObject.h"
+#include "core/model/GpgKeyTableModel.h"
+
+namespace GpgFrontend {
+
+/**
+ * @brief The values of the key table kept on disk, so that the key list can
+ * be shown at start before the keyring is listed. The snapshot is valid as
+ * long as the keyring files keep their modification time and size. It is
+ * encrypted by the cipher of the data objects.
+ *
+ */
+class GPGFRONTEND_CORE_EXPORT GpgKeyTableSnapshot
+    : public SingletonFunctionObject<GpgKeyTableSnapshot> {
+ public:
+  /**
+   * @brief Construct a new Gpg Key Table Snapshot object
+   *
+   * @param channel
+   */
+  explicit GpgKeyTableSnapshot(int channel = kGpgFrontendDefaultChannel);
+
+  /**
+   * @brief Destroy the Gpg Key Table Snapshot object
+   *
+   */
+  ~GpgKeyTableSnapshot();
+
+  /**
+   * @brief Get the stamp of the keyring files of the key database, take it
+   * before listing the keys which are going to be saved
+   *
+   * @return QByteArray
+   */
+  [[nodiscard]] auto GetKeyringStamp() const -> QByteArray;
+
+  /**
+   * @brief map the snapshot file and read the rows if it is still valid for
+   * the keyring
+   *
+   * @return true if the rows are loaded
+   */
+  auto Load() -> bool;
+
+  /**
+   * @brief if there are rows loaded
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto IsLoaded() const -> bool;
+
+  /**
+   * @brief Get the loaded rows
+   *
+   * @return QContainer<GpgKeyTableRow>
+   */
+  [[nodiscard]] auto GetRows() const -> QContainer<GpgKeyTableRow>;
+
+  /**
+   * @brief drop the loaded rows, once the keys are in the key cache
+   *
+   */
+  void Release();
+
+  /**
+   * @brief replace the snapshot file by the rows
+   *
+   * @param stamp stamp of the keyring when the keys were listed
+   * @param rows
+   * @return true if the file is written
+   */
+  auto Save(const QByteArray& stamp,
+            const QContainer<GpgKeyTableRow>& rows) -> bool;
+
+ private:
+  class Impl;
+  SecureUniquePtr<Impl> p_;
+};
+
+}  // namespace GpgFrontend
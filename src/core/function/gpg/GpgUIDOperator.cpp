@@ -30,6 +30,7 @@
 
 #include "core/GpgModel.h"
 #include "core/function/gpg/GpgAutomatonHandler.h"
+#include "core/function/gpg/GpgKeyGetter.h"
 #include "core/utils/GpgUtils.h"
 
 namespace GpgFrontend {
@@ -38,17 +39,29 @@ GpgUIDOperator::GpgUIDOperator(int channel)
     : SingletonFunctionObject<GpgUIDOperator>(channel) {}
 
 auto GpgUIDOperator::AddUID(const GpgKey& key, const QString& uid) -> bool {
+  auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   auto err = gpgme_op_adduid(ctx_.DefaultContext(),
                              static_cast<gpgme_key_t>(key), uid.toUtf8(), 0);
-  return CheckGpgError(err) == GPG_ERR_NO_ERROR;
+  if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+
+  key_getter.UpdateKeyCache({key.GetFingerprint()}, stamp);
+  return true;
 }
 
 auto GpgUIDOperator::SetPrimaryUID(const GpgKey& key,
                                    const QString& uid) -> bool {
+  auto& key_getter = GpgKeyGetter::GetInstance(GetChannel());
+  const auto stamp = key_getter.GetKeyringStamp();
+
   auto err = CheckGpgError(gpgme_op_set_uid_flag(
       ctx_.DefaultContext(), static_cast<gpgme_key_t>(key), uid.toUtf8(),
       "primary", nullptr));
-  return CheckGpgError(err) == GPG_ERR_NO_ERROR;
+  if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+
+  key_getter.UpdateKeyCache({key.GetFingerprint()}, stamp);
+  return true;
 }
 
 auto GpgUIDOperator::AddUID(const GpgKey& key, const QString& name,
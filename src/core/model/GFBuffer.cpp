@@ -36,24 +36,51 @@ GFBuffer::GFBuffer(QByteArray buffer) : buffer_(std::move(buffer)) {}
 
 GFBuffer::GFBuffer(const QString& str) : buffer_(str.toUtf8()) {}
 
+GFBuffer::GFBuffer(char* data, size_t size,
+                   std::function<void(char*)> deleter)
+    : buffer_(QByteArray::fromRawData(data, static_cast<qsizetype>(size))),
+      storage_(data, std::move(deleter)) {}
+
 auto GFBuffer::operator==(const GFBuffer& o) const -> bool {
   return buffer_ == o.buffer_;
 }
 
 auto GFBuffer::Data() const -> const char* { return buffer_.constData(); }
 
-void GFBuffer::Resize(ssize_t size) { buffer_.resize(size); }
+void GFBuffer::Resize(ssize_t size) {
+  detach();
+  buffer_.resize(size);
+}
 
 auto GFBuffer::Size() const -> size_t { return buffer_.size(); }
 
-auto GFBuffer::ConvertToQByteArray() const -> QByteArray { return buffer_; }
+auto GFBuffer::ConvertToQByteArray() const -> QByteArray {
+  // the adopted storage may go before the returned array
+  if (storage_ != nullptr) return {buffer_.constData(), buffer_.size()};
+  return buffer_;
+}
+
+auto GFBuffer::ConvertToQString() const -> QString {
+  return QString::fromUtf8(buffer_.constData(), buffer_.size());
+}
 
 auto GFBuffer::Empty() const -> bool { return this->Size() == 0; }
 
-void GFBuffer::Append(const GFBuffer& o) { buffer_.append(o.buffer_); }
+void GFBuffer::Append(const GFBuffer& o) {
+  detach();
+  buffer_.append(o.buffer_);
+}
 
 void GFBuffer::Append(const char* buffer, ssize_t size) {
+  detach();
   buffer_.append(buffer, size);
 }
 
+void GFBuffer::detach() {
+  if (storage_ == nullptr) return;
+
+  buffer_ = QByteArray(buffer_.constData(), buffer_.size());
+  storage_.reset();
+}
+
 }  // namespace GpgFrontend
\ No newline at end of file
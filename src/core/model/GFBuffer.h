@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "core/GpgFrontendCoreExport.h"
 #include "core/utils/MemoryUtils.h"
 
@@ -41,6 +43,13 @@ class GPGFRONTEND_CORE_EXPORT GFBuffer {
 
   explicit GFBuffer(const QString& str);
 
+  /**
+   * @brief adopts external storage without copying it, the deleter is called
+   * once no copy of the buffer refers to it anymore
+   *
+   */
+  GFBuffer(char* data, size_t size, std::function<void(char*)> deleter);
+
   auto operator==(const GFBuffer& o) const -> bool;
 
   [[nodiscard]] auto Data() const -> const char*;
@@ -57,8 +66,13 @@ class GPGFRONTEND_CORE_EXPORT GFBuffer {
 
   [[nodiscard]] auto ConvertToQByteArray() const -> QByteArray;
 
+  [[nodiscard]] auto ConvertToQString() const -> QString;
+
  private:
   QByteArray buffer_;
+  std::shared_ptr<char> storage_;  ///< adopted storage behind buffer_
+
+  void detach();
 };
 
 }  // namespace GpgFrontend
\ No newline at end of file
@@ -28,57 +28,86 @@
 
 #include "GFDataExchanger.h"
 
+#include <cstring>
+
 namespace GpgFrontend {
 
+GFDataExchanger::GFDataExchanger(ssize_t size)
+    : buffer_(new std::byte[static_cast<size_t>(size)]),
+      capacity_(static_cast<size_t>(size)) {}
+
 auto GFDataExchanger::Write(const std::byte* buffer, size_t size) -> ssize_t {
   if (close_) return -1;
   if (size == 0) return 0;
 
-  std::atomic<ssize_t> write_bytes = 0;
-  std::unique_lock<std::mutex> lock(mutex_);
-  try {
-    for (size_t i = 0; i < size; i++) {
-      if (queue_.size() == static_cast<unsigned long>(queue_max_size_)) {
-        not_empty_.notify_all();
-      }
-
-      not_full_.wait(lock, [=] {
-        return queue_.size() < static_cast<unsigned long>(queue_max_size_) ||
-               close_;
-      });
-      if (close_) return -1;
-
-      queue_.push(buffer[i]);
-      write_bytes++;
-    }
-  } catch (...) {
-    FLOG_W(
-        "gf data exchanger caught exception when it writes to queue, abort...");
+  size_t write_bytes = 0;
+  while (write_bytes < size) {
+    auto region = ReserveWrite(size - write_bytes);
+    if (region.size == 0) return -1;
+
+    std::memcpy(region.data, buffer + write_bytes, region.size);
+    CommitWrite(region.size);
+    write_bytes += region.size;
   }
 
-  if (!queue_.empty()) not_empty_.notify_all();
-  return write_bytes;
+  return static_cast<ssize_t>(write_bytes);
 }
 
 auto GFDataExchanger::Read(std::byte* buffer, size_t size) -> ssize_t {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (size == 0 || (close_ && queue_.empty())) return 0;
+  if (size == 0) return 0;
 
-  std::atomic<ssize_t> read_bytes = 0;
-  for (size_t i = 0; i < size; ++i) {
-    if (queue_.empty()) not_full_.notify_all();
-    not_empty_.wait(lock, [=] { return !queue_.empty() || close_; });
+  const auto readable = wait_readable();
+  if (readable == 0) return 0;
 
-    if (close_ && queue_.empty()) return 0;
-    buffer[i] = queue_.front();
-    queue_.pop();
-    read_bytes++;
-  }
+  const auto head = head_.load(std::memory_order_relaxed);
+  const auto offset = head % capacity_;
+  const auto read_bytes = std::min(readable, size);
+  const auto first_part = std::min(read_bytes, capacity_ - offset);
 
-  if (queue_.size() < static_cast<unsigned long>(queue_max_size_)) {
-    not_full_.notify_all();
+  std::memcpy(buffer, buffer_.get() + offset, first_part);
+  if (read_bytes > first_part) {
+    std::memcpy(buffer + first_part, buffer_.get(), read_bytes - first_part);
   }
-  return read_bytes;
+
+  head_.store(head + read_bytes);
+  notify_writable();
+  return static_cast<ssize_t>(read_bytes);
+}
+
+auto GFDataExchanger::ReserveWrite(size_t size) -> Region {
+  if (size == 0) return {};
+
+  const auto writable = wait_writable();
+  if (writable == 0) return {};
+
+  const auto offset = tail_.load(std::memory_order_relaxed) % capacity_;
+  return {buffer_.get() + offset,
+          std::min({writable, capacity_ - offset, size})};
+}
+
+void GFDataExchanger::CommitWrite(size_t size) {
+  if (size == 0) return;
+
+  tail_.store(tail_.load(std::memory_order_relaxed) + size);
+  notify_readable();
+}
+
+auto GFDataExchanger::BorrowReadRegion(size_t size) -> Region {
+  if (size == 0) return {};
+
+  const auto readable = wait_readable();
+  if (readable == 0) return {};
+
+  const auto offset = head_.load(std::memory_order_relaxed) % capacity_;
+  return {buffer_.get() + offset,
+          std::min({readable, capacity_ - offset, size})};
+}
+
+void GFDataExchanger::ReleaseReadRegion(size_t size) {
+  if (size == 0) return;
+
+  head_.store(head_.load(std::memory_order_relaxed) + size);
+  notify_writable();
 }
 
 void GFDataExchanger::CloseWrite() {
@@ -89,6 +118,56 @@ void GFDataExchanger::CloseWrite() {
   not_empty_.notify_all();
 }
 
-GFDataExchanger::GFDataExchanger(ssize_t size) : queue_max_size_(size) {}
+auto GFDataExchanger::Capacity() const -> size_t { return capacity_; }
+
+auto GFDataExchanger::wait_readable() -> size_t {
+  // load close_ first: every byte written before closing is visible then
+  auto closed = close_.load();
+  auto readable = tail_.load() - head_.load(std::memory_order_relaxed);
+  if (readable != 0 || closed) return readable;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  reader_waiting_ = true;
+  not_empty_.wait(lock, [&] {
+    closed = close_.load();
+    readable = tail_.load() - head_.load(std::memory_order_relaxed);
+    return readable != 0 || closed;
+  });
+  reader_waiting_ = false;
+  return readable;
+}
+
+auto GFDataExchanger::wait_writable() -> size_t {
+  if (close_) return 0;
+
+  auto writable =
+      capacity_ - (tail_.load(std::memory_order_relaxed) - head_.load());
+  if (writable != 0) return writable;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  writer_waiting_ = true;
+  not_full_.wait(lock, [&] {
+    writable =
+        capacity_ - (tail_.load(std::memory_order_relaxed) - head_.load());
+    return writable != 0 || close_;
+  });
+  writer_waiting_ = false;
+  return close_ ? 0 : writable;
+}
+
+void GFDataExchanger::notify_readable() {
+  // pairs with the store of reader_waiting_ in wait_readable()
+  if (!reader_waiting_) return;
+
+  std::unique_lock<std::mutex> const lock(mutex_);
+  not_empty_.notify_one();
+}
+
+void GFDataExchanger::notify_writable() {
+  if (!writer_waiting_) return;
+
+  std::unique_lock<std::mutex> const lock(mutex_);
+  not_full_.notify_one();
+}
 
-}  // namespace GpgFrontend
\ No newline at end of file
+}  // namespace GpgFrontend
@@ -28,34 +28,153 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
-#include <queue>
+#include <memory>
+#include <mutex>
+
+#include "core/GpgFrontendCoreExport.h"
 
 namespace GpgFrontend {
 
 constexpr ssize_t kDataExchangerSize =
     static_cast<const ssize_t>(1024 * 1024 * 8);  // 8 MB
 
-class GFDataExchanger {
+/**
+ * @brief A single producer, single consumer byte pipe backed by a contiguous
+ * ring buffer.
+ *
+ * The producer only advances the tail and the consumer only advances the
+ * head, so data is moved with bulk memcpy and without holding any lock. The
+ * mutex and the condition variables are only touched when one side has to
+ * sleep on an empty (or full) buffer and the other side makes it non-empty
+ * (or non-full) again.
+ */
+class GPGFRONTEND_CORE_EXPORT GFDataExchanger {
  public:
+  /**
+   * @brief a contiguous piece of the ring buffer
+   *
+   */
+  struct Region {
+    std::byte* data = nullptr;
+    size_t size = 0;
+  };
+
+  /**
+   * @brief Construct a new GFDataExchanger object
+   *
+   * @param size capacity of the ring buffer in bytes
+   */
   explicit GFDataExchanger(ssize_t size);
 
+  /**
+   * @brief write all bytes of buffer, blocks while the ring buffer is full.
+   *
+   * @return ssize_t size, or -1 if the exchanger has been closed
+   */
   auto Write(const std::byte* buffer, size_t size) -> ssize_t;
 
+  /**
+   * @brief read at most size bytes, blocks until some bytes are readable.
+   *
+   * @return ssize_t bytes read, 0 when closed and drained
+   */
   auto Read(std::byte* buffer, size_t size) -> ssize_t;
 
+  /**
+   * @brief reserve a contiguous writable region of at most size bytes. blocks
+   * until at least one byte is free. the region is empty if the exchanger has
+   * been closed.
+   *
+   * @param size
+   * @return Region
+   */
+  auto ReserveWrite(size_t size) -> Region;
+
+  /**
+   * @brief publish the first size bytes of the last reserved region.
+   *
+   * @param size
+   */
+  void CommitWrite(size_t size);
+
+  /**
+   * @brief borrow a contiguous readable region of at most size bytes without
+   * copying it out. blocks until at least one byte is readable. the region is
+   * empty if the exchanger has been closed and drained. the region stays
+   * valid until it is released.
+   *
+   * @param size
+   * @return Region
+   */
+  auto BorrowReadRegion(size_t size) -> Region;
+
+  /**
+   * @brief give the first size bytes of the last borrowed region back to the
+   * producer.
+   *
+   * @param size
+   */
+  void ReleaseReadRegion(size_t size);
+
+  /**
+   * @brief close the exchanger, could be called by both sides.
+   *
+   */
   void CloseWrite();
 
+  /**
+   * @brief
+   *
+   * @return size_t
+   */
+  [[nodiscard]] auto Capacity() const -> size_t;
+
  private:
-  std::condition_variable not_full_, not_empty_;
-  std::queue<std::byte> queue_;
-  std::mutex mutex_;
-  const ssize_t queue_max_size_;
+  std::unique_ptr<std::byte[]> buffer_;
+  const size_t capacity_;
+
+  alignas(64) std::atomic<size_t> head_ = 0;  ///< total bytes consumed
+  alignas(64) std::atomic<size_t> tail_ = 0;  ///< total bytes produced
+
   std::atomic_bool close_ = false;
+  std::atomic_bool reader_waiting_ = false;
+  std::atomic_bool writer_waiting_ = false;
+
+  std::mutex mutex_;
+  std::condition_variable not_full_, not_empty_;
+
+  /**
+   * @brief wait until the buffer is non-empty or closed
+   *
+   * @return size_t readable bytes
+   */
+  auto wait_readable() -> size_t;
+
+  /**
+   * @brief wait until the buffer is non-full or closed
+   *
+   * @return size_t writable bytes, 0 if closed
+   */
+  auto wait_writable() -> size_t;
+
+  /**
+   * @brief wake up the consumer if it sleeps on an empty buffer
+   *
+   */
+  void notify_readable();
+
+  /**
+   * @brief wake up the producer if it sleeps on a full buffer
+   *
+   */
+  void notify_writable();
 };
 
 inline auto CreateStandardGFDataExchanger() -> QSharedPointer<GFDataExchanger> {
   return QSharedPointer<GFDataExchanger>::create(kDataExchangerSize);
 }
 
-}  // namespace GpgFrontend
\ No newline at end of file
+}  // namespace GpgFrontend
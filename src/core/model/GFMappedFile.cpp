@@ -0,0 +1,270 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "GFMappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/utils/MemoryUtils.h"
+
+namespace GpgFrontend {
+
+namespace {
+
+/**
+ * @brief lines published to the readers at once while indexing
+ *
+ */
+constexpr size_t kLineIndexBatchSize = 64 * 1024;
+
+constexpr std::string_view kArmorBegin = "-----BEGIN ";
+constexpr std::string_view kArmorDashes = "-----";
+constexpr std::string_view kArmorSignedMessage = "PGP SIGNED MESSAGE";
+constexpr std::string_view kArmorSignature = "PGP SIGNATURE";
+
+}  // namespace
+
+class GFMappedFile::Impl {
+ public:
+  explicit Impl(const QString& path) : file_(path) {
+    if (!file_.open(QIODevice::ReadOnly)) {
+      LOG_W() << "failed to open file to map: " << path;
+      return;
+    }
+
+    size_ = file_.size();
+    if (size_ > 0) data_ = file_.map(0, size_);
+    if (data_ == nullptr) {
+      LOG_W() << "failed to map file: " << path << file_.errorString();
+    }
+  }
+
+  ~Impl() {
+    if (data_ != nullptr) file_.unmap(data_);
+  }
+
+  [[nodiscard]] auto IsMapped() const -> bool { return data_ != nullptr; }
+
+  [[nodiscard]] auto Size() const -> qint64 { return size_; }
+
+  auto BuildLineIndex(const std::function<bool(qint64)>& progress) -> bool {
+    if (data_ == nullptr || indexed_) return indexed_;
+
+    const auto* data = reinterpret_cast<const char*>(data_);
+    std::vector<qint64> batch;
+    batch.reserve(kLineIndexBatchSize);
+
+    qint64 offset = 0;
+    while (offset < size_) {
+      const auto* line_break = static_cast<const char*>(std::memchr(
+          data + offset, '\n', static_cast<size_t>(size_ - offset)));
+
+      // the last line without line break
+      const auto end = line_break != nullptr ? line_break - data : size_;
+      batch.push_back(end);
+      offset = end + 1;
+
+      if (batch.size() == kLineIndexBatchSize) {
+        publish(batch);
+        if (progress && !progress(std::min(offset, size_))) return false;
+      }
+    }
+
+    publish(batch);
+    indexed_ = true;
+    if (progress) progress(size_);
+    return true;
+  }
+
+  [[nodiscard]] auto IsLineIndexed() const -> bool { return indexed_; }
+
+  [[nodiscard]] auto LineCount() const -> qint64 {
+    std::lock_guard<std::mutex> lock(index_lock_);
+    return static_cast<qint64>(line_ends_.size());
+  }
+
+  [[nodiscard]] auto Line(qint64 index) const -> QByteArray {
+    qint64 begin = 0;
+    qint64 end = 0;
+    {
+      std::lock_guard<std::mutex> lock(index_lock_);
+      if (index < 0 || index >= static_cast<qint64>(line_ends_.size())) {
+        return {};
+      }
+      begin = index == 0 ? 0 : line_ends_[index - 1] + 1;
+      end = line_ends_[index];
+    }
+
+    const auto* data = reinterpret_cast<const char*>(data_);
+    if (end > begin && data[end - 1] == '\r') end--;
+    return QByteArray::fromRawData(data + begin, end - begin);
+  }
+
+  [[nodiscard]] auto FindArmorBlocks() const -> QContainer<ArmorBlock> {
+    QContainer<ArmorBlock> blocks;
+    if (data_ == nullptr) return blocks;
+
+    const std::string_view content(reinterpret_cast<const char*>(data_),
+                                   static_cast<size_t>(size_));
+
+    size_t offset = 0;
+    while ((offset = content.find(kArmorBegin, offset)) !=
+           std::string_view::npos) {
+      // only at the start of a line
+      if (offset > 0 && content[offset - 1] != '\n') {
+        offset += kArmorBegin.size();
+        continue;
+      }
+
+      const auto type_begin = offset + kArmorBegin.size();
+      const auto type_end = content.find(kArmorDashes, type_begin);
+      const auto line_end = content.find('\n', type_begin);
+      if (type_end == std::string_view::npos || type_end > line_end) {
+        offset = type_begin;
+        continue;
+      }
+
+      auto type = content.substr(type_begin, type_end - type_begin);
+      const auto end_type =
+          type == kArmorSignedMessage ? kArmorSignature : type;
+      const auto end_line =
+          "-----END " + std::string(end_type) + std::string(kArmorDashes);
+
+      auto end = content.find(end_line, type_end);
+      if (end == std::string_view::npos) break;
+      end += end_line.size();
+
+      // with the line break
+      if (end < content.size() && content[end] == '\r') end++;
+      if (end < content.size() && content[end] == '\n') end++;
+
+      blocks.push_back(
+          {static_cast<qint64>(offset), static_cast<qint64>(end),
+           QByteArray(type.data(), static_cast<int>(type.size()))});
+      offset = end;
+    }
+    return blocks;
+  }
+
+  [[nodiscard]] auto CopyTo(const QString& path) const -> bool {
+    if (data_ == nullptr) return false;
+    if (QFileInfo(path) == QFileInfo(file_)) return true;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+      LOG_W() << "failed to open file to copy to: " << path;
+      return false;
+    }
+    if (file.write(reinterpret_cast<const char*>(data_), size_) != size_) {
+      file.cancelWriting();
+      return false;
+    }
+    return file.commit();
+  }
+
+  /**
+   * @brief the mapped bytes from begin to end, clamped to the file
+   *
+   * @param begin
+   * @param end
+   * @return std::pair<char*, qint64> the data and its size
+   */
+  [[nodiscard]] auto Range(qint64 begin, qint64 end) const
+      -> std::pair<char*, qint64> {
+    if (data_ == nullptr) return {nullptr, 0};
+
+    begin = std::clamp<qint64>(begin, 0, size_);
+    end = std::clamp<qint64>(end, begin, size_);
+    return {reinterpret_cast<char*>(data_) + begin, end - begin};
+  }
+
+ private:
+  QFile file_;
+  uchar* data_ = nullptr;
+  qint64 size_ = 0;
+
+  mutable std::mutex index_lock_;
+  std::vector<qint64> line_ends_;  ///< offsets of the line breaks
+  std::atomic<bool> indexed_{false};
+
+  void publish(std::vector<qint64>& batch) {
+    std::lock_guard<std::mutex> lock(index_lock_);
+    line_ends_.insert(line_ends_.end(), batch.begin(), batch.end());
+    batch.clear();
+  }
+};
+
+GFMappedFile::GFMappedFile(const QString& path)
+    : p_(SecureCreateUniqueObject<Impl>(path)) {}
+
+GFMappedFile::~GFMappedFile() = default;
+
+auto GFMappedFile::IsMapped() const -> bool { return p_->IsMapped(); }
+
+auto GFMappedFile::Size() const -> qint64 { return p_->Size(); }
+
+auto GFMappedFile::BuildLineIndex(const std::function<bool(qint64)>& progress)
+    -> bool {
+  return p_->BuildLineIndex(progress);
+}
+
+auto GFMappedFile::IsLineIndexed() const -> bool { return p_->IsLineIndexed(); }
+
+auto GFMappedFile::LineCount() const -> qint64 { return p_->LineCount(); }
+
+auto GFMappedFile::Line(qint64 index) const -> QByteArray {
+  return p_->Line(index);
+}
+
+auto GFMappedFile::FindArmorBlocks() const -> QContainer<ArmorBlock> {
+  return p_->FindArmorBlocks();
+}
+
+auto GFMappedFile::CopyTo(const QString& path) const -> bool {
+  return p_->CopyTo(path);
+}
+
+auto GFMappedFile::GetBuffer(const std::shared_ptr<GFMappedFile>& file,
+                             qint64 begin, qint64 end) -> GFBuffer {
+  if (file == nullptr) return {};
+
+  auto [data, size] = file->p_->Range(begin, end);
+  if (data == nullptr) return {};
+
+  // the buffer only reads the mapping, which lives as long as the deleter
+  return {data, static_cast<size_t>(size), [file](char*) {}};
+}
+
+}  // namespace GpgFrontend
@@ -0,0 +1,154 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "core/GpgFrontendCoreExport.h"
+#include "core/model/GFBuffer.h"
+#include "core/typedef/CoreTypedef.h"
+
+namespace GpgFrontend {
+
+/**
+ * @brief A file mapped read only into memory, for viewing and operating on
+ * files too large for a text document. The offsets of the lines are indexed
+ * on demand, e.g. by a background task, while the lines indexed so far can
+ * already be read from any thread.
+ *
+ */
+class GPGFRONTEND_CORE_EXPORT GFMappedFile {
+ public:
+  /**
+   * @brief an ascii armored block in the file
+   *
+   */
+  struct ArmorBlock {
+    qint64 begin;     ///< offset of the begin line
+    qint64 end;       ///< offset after the end line
+    QByteArray type;  ///< e.g. "PGP MESSAGE"
+  };
+
+  /**
+   * @brief Construct a new GFMappedFile object and map the file
+   *
+   * @param path
+   */
+  explicit GFMappedFile(const QString& path);
+
+  /**
+   * @brief Destroy the GFMappedFile object
+   *
+   */
+  ~GFMappedFile();
+
+  /**
+   * @brief whether the file is mapped
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto IsMapped() const -> bool;
+
+  /**
+   * @brief size of the file
+   *
+   * @return qint64
+   */
+  [[nodiscard]] auto Size() const -> qint64;
+
+  /**
+   * @brief index the offsets of the lines, the ones indexed so far are
+   * published in batches
+   *
+   * @param progress called with the indexed bytes after every batch, the
+   * indexing stops if it returns false
+   * @return true if the whole file is indexed
+   */
+  auto BuildLineIndex(const std::function<bool(qint64)>& progress = {})
+      -> bool;
+
+  /**
+   * @brief whether the whole file is indexed
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto IsLineIndexed() const -> bool;
+
+  /**
+   * @brief count of the lines indexed so far
+   *
+   * @return qint64
+   */
+  [[nodiscard]] auto LineCount() const -> qint64;
+
+  /**
+   * @brief the bytes of the line without the line break, not copied
+   *
+   * @param index
+   * @return QByteArray empty if not indexed yet
+   */
+  [[nodiscard]] auto Line(qint64 index) const -> QByteArray;
+
+  /**
+   * @brief find the ascii armored blocks by scanning the mapped bytes
+   *
+   * @return QContainer<ArmorBlock>
+   */
+  [[nodiscard]] auto FindArmorBlocks() const -> QContainer<ArmorBlock>;
+
+  /**
+   * @brief write the mapped bytes to another file. The mapped file itself is
+   * left untouched, since truncating it would pull the mapping away.
+   *
+   * @param path
+   * @return true if the bytes are at the path
+   */
+  [[nodiscard]] auto CopyTo(const QString& path) const -> bool;
+
+  /**
+   * @brief a buffer over the mapped bytes, which is not copied. The buffer
+   * and its copies keep the file mapped.
+   *
+   * @param file
+   * @param begin
+   * @param end
+   * @return GFBuffer
+   */
+  static auto GetBuffer(const std::shared_ptr<GFMappedFile>& file,
+                        qint64 begin, qint64 end) -> GFBuffer;
+
+ private:
+  class Impl;
+  SecureUniquePtr<Impl> p_;
+};
+
+}  // namespace GpgFrontend
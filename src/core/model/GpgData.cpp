@@ -28,8 +28,15 @@
 
 #include "core/model/GpgData.h"
 
+#include <fcntl.h>
 #include <unistd.h>
 
+#if !defined(_WIN32) && !defined(WIN32)
+#include <sys/mman.h>
+#endif
+
+#include <cstring>
+
 #include "core/model/GFDataExchanger.h"
 #include "core/typedef/GpgTypedef.h"
 
@@ -52,7 +59,195 @@ void GFReleaseExCb(void* handle) {
   ex->CloseWrite();
 }
 
-GpgData::GpgData() {
+using GpgDataFuncs = std::pair<GpgDataReadFunc, GpgDataWriteFunc>;
+
+auto GFReadFuncCb(void* handle, void* buffer, size_t size) -> ssize_t {
+  auto* funcs = static_cast<GpgDataFuncs*>(handle);
+  if (!funcs->first) {
+    errno = EBADF;
+    return -1;
+  }
+  return funcs->first(buffer, size);
+}
+
+auto GFWriteFuncCb(void* handle, const void* buffer, size_t size) -> ssize_t {
+  auto* funcs = static_cast<GpgDataFuncs*>(handle);
+  if (!funcs->second) {
+    errno = EBADF;
+    return -1;
+  }
+  return funcs->second(buffer, size);
+}
+
+/**
+ * @brief the file behind GpgDataFileMode::kMapped and kBuffered
+ *
+ */
+class GpgData::FileBackend {
+ public:
+  FileBackend(const QString& path, bool read, size_t buffer_size)
+      : file_(path),
+        read_(read),
+        buffer_(std::max(buffer_size, kBufferSize)) {
+    // support unicode path, the buffering is done by ourselves
+    if (!file_.open((read ? QIODevice::ReadOnly : QIODevice::WriteOnly) |
+                    QIODevice::Unbuffered)) {
+      LOG_W() << "failed to open file of gpg data: " << path
+              << file_.errorString();
+    }
+  }
+
+  ~FileBackend() {
+    if (!Flush()) LOG_W() << "failed to flush file of gpg data";
+    release_preallocation();
+    if (map_ != nullptr) file_.unmap(map_);
+  }
+
+  /**
+   * @brief map the whole file, which is read sequentially
+   *
+   * @return const uchar* nullptr on failure
+   */
+  auto Map() -> const uchar* {
+    if (!file_.isOpen() || file_.size() <= 0) return nullptr;
+
+    map_ = file_.map(0, file_.size());
+#if defined(POSIX_MADV_SEQUENTIAL)
+    if (map_ != nullptr) {
+      posix_madvise(map_, static_cast<size_t>(file_.size()),
+                    POSIX_MADV_SEQUENTIAL);
+    }
+#endif
+    return map_;
+  }
+
+  [[nodiscard]] auto Size() const -> size_t {
+    return static_cast<size_t>(file_.size());
+  }
+
+  /**
+   * @brief tell the kernel that the file is accessed sequentially and
+   * reserve the expected size of an output, both are only hints
+   *
+   * @param size_hint
+   */
+  void Advise(qint64 size_hint) {
+    const auto fd = file_.handle();
+    if (fd < 0) return;
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+    if (!read_ && size_hint > 0) {
+      preallocated_ = fallocate(fd, FALLOC_FL_KEEP_SIZE, 0,
+                                static_cast<off_t>(size_hint)) == 0;
+    }
+#else
+    Q_UNUSED(size_hint);
+#endif
+  }
+
+  auto Read(void* buffer, size_t size) -> ssize_t {
+    if (pos_ == len_) {
+      // large reads go straight into the buffer of gpgme
+      if (size >= buffer_.size()) return file_read(buffer, size);
+
+      const auto len = file_read(buffer_.data(), buffer_.size());
+      if (len <= 0) return len;
+      pos_ = 0;
+      len_ = static_cast<size_t>(len);
+    }
+
+    const auto len = std::min(size, len_ - pos_);
+    std::memcpy(buffer, buffer_.data() + pos_, len);
+    pos_ += len;
+    return static_cast<ssize_t>(len);
+  }
+
+  auto Write(const void* buffer, size_t size) -> ssize_t {
+    if (len_ + size > buffer_.size() && !Flush()) {
+      errno = EIO;
+      return -1;
+    }
+
+    if (size >= buffer_.size()) {
+      if (file_.write(static_cast<const char*>(buffer),
+                      static_cast<qint64>(size)) != static_cast<qint64>(size)) {
+        errno = EIO;
+        return -1;
+      }
+      return static_cast<ssize_t>(size);
+    }
+
+    std::memcpy(buffer_.data() + len_, buffer, size);
+    len_ += size;
+    return static_cast<ssize_t>(size);
+  }
+
+  auto Seek(off_t offset, int whence) -> off_t {
+    if (!Flush()) {
+      errno = EIO;
+      return -1;
+    }
+
+    // the position of gpgme is behind the buffered bytes
+    qint64 target = offset;
+    if (whence == SEEK_CUR) target += file_.pos() - (len_ - pos_);
+    if (whence == SEEK_END) target += file_.size();
+
+    if (target < 0 || !file_.seek(target)) {
+      errno = EINVAL;
+      return -1;
+    }
+
+    pos_ = len_ = 0;
+    return static_cast<off_t>(target);
+  }
+
+  auto Flush() -> bool {
+    if (read_ || len_ == 0) return true;
+
+    const auto len = static_cast<qint64>(len_);
+    len_ = 0;
+    return file_.write(buffer_.data(), len) == len;
+  }
+
+ private:
+  QFile file_;
+  bool read_;
+  uchar* map_ = nullptr;
+  std::vector<char> buffer_;
+  size_t pos_ = 0;  ///< read position in the buffer
+  size_t len_ = 0;  ///< bytes in the buffer
+  bool preallocated_ = false;
+
+  /**
+   * @brief the blocks reserved past the end by Advise() stay with the file,
+   * e.g. on ext4 and xfs, truncating the output to its length frees them
+   *
+   */
+  void release_preallocation() {
+    if (!preallocated_) return;
+    preallocated_ = false;
+
+    const auto size = file_.size();
+    if (size < 0 || ftruncate(file_.handle(), static_cast<off_t>(size)) != 0) {
+      LOG_W() << "failed to release the preallocation of gpg data file: "
+              << file_.fileName();
+    }
+  }
+
+  auto file_read(void* buffer, size_t size) -> ssize_t {
+    const auto len =
+        file_.read(static_cast<char*>(buffer), static_cast<qint64>(size));
+    if (len < 0) errno = EIO;
+    return static_cast<ssize_t>(len);
+  }
+};
+
+GpgData::GpgData() : mem_backed_(true) {
   gpgme_data_t data;
 
   auto err = gpgme_data_new(&data);
@@ -90,15 +285,57 @@ GpgData::GpgData(int fd) : fd_(fd), data_cbs_() {
   data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
 }
 
-GpgData::GpgData(const QString& path, bool read) {
+GpgData::GpgData(const QString& path, bool read)
+    : GpgData(path, read, GpgDataFileMode::kStream) {}
+
+GpgData::GpgData(const QString& path, bool read, GpgDataFileMode mode,
+                 qint64 size_hint, size_t buffer_size)
+    : data_cbs_() {
   gpgme_data_t data;
+  GpgError err;
 
-  // support unicode path
-  QFile file(path);
-  file.open(read ? QIODevice::ReadOnly : QIODevice::WriteOnly);
-  fp_ = fdopen(dup(file.handle()), read ? "rb" : "wb");
+  if (mode == GpgDataFileMode::kStream) {
+    // support unicode path
+    QFile file(path);
+    file.open(read ? QIODevice::ReadOnly : QIODevice::WriteOnly);
+    fp_ = fdopen(dup(file.handle()), read ? "rb" : "wb");
 
-  auto err = gpgme_data_new_from_stream(&data, fp_);
+    err = gpgme_data_new_from_stream(&data, fp_);
+  } else {
+    file_backend_ =
+        SecureCreateUniqueObject<FileBackend>(path, read, buffer_size);
+
+    const auto* mapped =
+        read && mode == GpgDataFileMode::kMapped ? file_backend_->Map()
+                                                 : nullptr;
+    if (mapped != nullptr) {
+      err = gpgme_data_new_from_mem(&data,
+                                    reinterpret_cast<const char*>(mapped),
+                                    file_backend_->Size(), 0);
+    } else {
+      file_backend_->Advise(size_hint);
+
+      data_cbs_.read = nullptr;
+      data_cbs_.write = nullptr;
+      if (read) {
+        data_cbs_.read = [](void* handle, void* buffer,
+                            size_t size) -> ssize_t {
+          return static_cast<FileBackend*>(handle)->Read(buffer, size);
+        };
+      } else {
+        data_cbs_.write = [](void* handle, const void* buffer,
+                             size_t size) -> ssize_t {
+          return static_cast<FileBackend*>(handle)->Write(buffer, size);
+        };
+      }
+      data_cbs_.seek = [](void* handle, off_t offset, int whence) -> off_t {
+        return static_cast<FileBackend*>(handle)->Seek(offset, whence);
+      };
+      data_cbs_.release = nullptr;
+
+      err = gpgme_data_new_from_cbs(&data, &data_cbs_, file_backend_.get());
+    }
+  }
   assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
 
   data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
@@ -119,7 +356,63 @@ GpgData::GpgData(QSharedPointer<GFDataExchanger> ex)
   data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
 }
 
+GpgData::GpgData(GpgDataReadFunc read, GpgDataWriteFunc write)
+    : data_cbs_(), data_funcs_(std::move(read), std::move(write)) {
+  gpgme_data_t data;
+
+  data_cbs_.read = GFReadFuncCb;
+  data_cbs_.write = GFWriteFuncCb;
+  data_cbs_.seek = nullptr;
+  data_cbs_.release = nullptr;
+
+  auto err = gpgme_data_new_from_cbs(&data, &data_cbs_, &data_funcs_);
+  assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
+
+  data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
+}
+
+GpgData::GpgData(const GpgDataStream& stream) : data_cbs_() {
+  gpgme_data_t data;
+  void* handle = nullptr;
+
+  if (const auto* ex = std::get_if<QSharedPointer<GFDataExchanger>>(&stream)) {
+    data_ex_ = *ex;
+    data_cbs_.read = GFReadExCb;
+    data_cbs_.write = GFWriteExCb;
+    data_cbs_.release = GFReleaseExCb;
+    handle = data_ex_.get();
+  } else {
+    auto* device = std::get<QIODevice*>(stream);
+    data_funcs_.first = [device](void* buffer, size_t size) -> ssize_t {
+      const auto len = device->read(static_cast<char*>(buffer),
+                                    static_cast<qint64>(size));
+      if (len < 0) errno = EIO;
+      return static_cast<ssize_t>(len);
+    };
+    data_funcs_.second = [device](const void* buffer,
+                                  size_t size) -> ssize_t {
+      const auto len = device->write(static_cast<const char*>(buffer),
+                                     static_cast<qint64>(size));
+      if (len < 0) errno = EIO;
+      return static_cast<ssize_t>(len);
+    };
+    data_cbs_.read = GFReadFuncCb;
+    data_cbs_.write = GFWriteFuncCb;
+    data_cbs_.release = nullptr;
+    handle = &data_funcs_;
+  }
+  data_cbs_.seek = nullptr;
+
+  auto err = gpgme_data_new_from_cbs(&data, &data_cbs_, handle);
+  assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
+
+  data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
+}
+
 GpgData::~GpgData() {
+  // the mapping or the buffer must outlive the data
+  data_ref_.reset();
+
   if (fp_ != nullptr) {
     fclose(fp_);
   }
@@ -130,25 +423,56 @@ GpgData::~GpgData() {
 }
 
 auto GpgData::Read2GFBuffer() -> GFBuffer {
-  gpgme_off_t ret = gpgme_data_seek(*this, 0, SEEK_SET);
-  GFBuffer out_buffer;
+  if (mem_backed_) {
+    if (data_ref_ == nullptr) return cached_buffer_;
+
+    // take the memory of gpgme over instead of copying it
+    size_t size = 0;
+    auto* mem = gpgme_data_release_and_get_mem(data_ref_.release(), &size);
+    if (mem != nullptr) {
+      cached_buffer_ = GFBuffer(mem, size, [](char* p) { gpgme_free(p); });
+    }
+    return cached_buffer_;
+  }
 
-  if (ret != 0) {
+  // the size of seekable data is known, which is read without reallocation
+  const auto size = gpgme_data_seek(*this, 0, SEEK_END);
+  if (gpgme_data_seek(*this, 0, SEEK_SET) != 0) {
     const GpgError err = gpgme_err_code_from_errno(errno);
     assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
-  } else {
-    std::array<char, kBufferSize + 2> buf;
+    return {};
+  }
 
-    while ((ret = gpgme_data_read(*this, buf.data(), kBufferSize)) > 0) {
-      out_buffer.Append(buf.data(), ret);
-    }
+  QByteArray buffer(static_cast<qsizetype>(std::max<gpgme_off_t>(size, 0)),
+                    Qt::Uninitialized);
+  qsizetype len = 0;
+  ssize_t ret = 1;
+  while (len < buffer.size() &&
+         (ret = gpgme_data_read(*this, buffer.data() + len,
+                                buffer.size() - len)) > 0) {
+    len += ret;
+  }
+  buffer.truncate(len);
 
-    if (ret < 0) {
-      const GpgError err = gpgme_err_code_from_errno(errno);
-      assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
-    }
+  // the data has grown or its size is unknown
+  std::array<char, kBufferSize> chunk;
+  while (ret > 0 &&
+         (ret = gpgme_data_read(*this, chunk.data(), chunk.size())) > 0) {
+    buffer.append(chunk.data(), static_cast<qsizetype>(ret));
+  }
+
+  if (ret < 0) {
+    const GpgError err = gpgme_err_code_from_errno(errno);
+    assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
+  }
+  return GFBuffer(std::move(buffer));
+}
+
+auto GpgData::Flush() -> GpgError {
+  if (file_backend_ == nullptr || file_backend_->Flush()) {
+    return GPG_ERR_NO_ERROR;
   }
-  return out_buffer;
+  return gpgme_error(GPG_ERR_EIO);
 }
 
 GpgData::operator gpgme_data_t() { return data_ref_.get(); }
@@ -30,14 +30,55 @@
 
 #include <gpgme.h>
 
+#include <variant>
+
 #include "core/GpgFrontendCoreExport.h"
 #include "core/model/GFBuffer.h"
 #include "core/typedef/CoreTypedef.h"
+#include "core/typedef/GpgTypedef.h"
 
 namespace GpgFrontend {
 
 class GFDataExchanger;
 
+/**
+ * @brief gives gpgme at most size bytes, 0 at the end and -1 on errors
+ *
+ */
+using GpgDataReadFunc = std::function<ssize_t(void* buffer, size_t size)>;
+
+/**
+ * @brief takes the bytes written by gpgme, returns how many or -1
+ *
+ */
+using GpgDataWriteFunc =
+    std::function<ssize_t(const void* buffer, size_t size)>;
+
+/**
+ * @brief a source or a sink to stream a GpgData from or to. A QIODevice must
+ * be open, must not be used by others meanwhile and must work without an
+ * event loop, e.g. a QFile or a QBuffer. An exchanger is closed for writing
+ * once the GpgData is released.
+ *
+ */
+using GpgDataStream = std::variant<QSharedPointer<GFDataExchanger>, QIODevice*>;
+
+/**
+ * @brief how a file backed GpgData does its I/O
+ *
+ */
+enum class GpgDataFileMode {
+  kStream,    ///< through a stdio stream of the file
+  kMapped,    ///< an input mapped into memory, buffered if it cannot be mapped
+  kBuffered,  ///< through a large buffer, with hints to the kernel
+};
+
+/**
+ * @brief default size of the buffer of GpgDataFileMode::kBuffered
+ *
+ */
+constexpr size_t kGpgDataFileBufferSize = 1024 * 1024;
+
 /**
  * @brief
  *
@@ -80,12 +121,42 @@ class GPGFRONTEND_CORE_EXPORT GpgData {
    */
   explicit GpgData(const QString& path, bool read);
 
+  /**
+   * @brief Construct a new Gpg Data object backed by a file in the given mode
+   *
+   * @param path
+   * @param read
+   * @param mode
+   * @param size_hint expected size of an output, which is preallocated
+   * @param buffer_size size of the buffer of GpgDataFileMode::kBuffered
+   */
+  GpgData(const QString& path, bool read, GpgDataFileMode mode,
+          qint64 size_hint = 0, size_t buffer_size = kGpgDataFileBufferSize);
+
   /**
    * @brief Construct a new Gpg Data object
    *
    */
   explicit GpgData(GFBuffer);
 
+  /**
+   * @brief Construct a new Gpg Data object backed by callbacks, which allows
+   * to stream the data without holding all of it, e.g. through a cipher. It
+   * cannot be seeked.
+   *
+   * @param read
+   * @param write
+   */
+  GpgData(GpgDataReadFunc read, GpgDataWriteFunc write);
+
+  /**
+   * @brief Construct a new Gpg Data object streaming from or to the source
+   * or the sink. It cannot be seeked.
+   *
+   * @param stream
+   */
+  explicit GpgData(const GpgDataStream& stream);
+
   /**
    * @brief Destroy the Gpg Data object
    *
@@ -100,13 +171,23 @@ class GPGFRONTEND_CORE_EXPORT GpgData {
   operator gpgme_data_t();
 
   /**
-   * @brief
+   * @brief read all of the data. A memory backed data hands its buffer over
+   * without copying it and cannot be used by gpgme afterwards.
    *
-   * @return ByteArrayPtr
+   * @return GFBuffer
    */
   auto Read2GFBuffer() -> GFBuffer;
 
+  /**
+   * @brief write the buffered output of a file backed GpgData to the file
+   *
+   * @return GpgError
+   */
+  auto Flush() -> GpgError;
+
  private:
+  class FileBackend;
+
   /**
    * @brief
    *
@@ -118,6 +199,8 @@ class GPGFRONTEND_CORE_EXPORT GpgData {
   };
 
   GFBuffer cached_buffer_;
+  bool mem_backed_ = false;  ///< memory allocated by gpgme
+  SecureUniquePtr<FileBackend> file_backend_;  ///< outlives data_ref_
 
   std::unique_ptr<struct gpgme_data, DataRefDeleter> data_ref_ = nullptr;  ///<
   FILE* fp_ = nullptr;
@@ -125,6 +208,7 @@ class GPGFRONTEND_CORE_EXPORT GpgData {
 
   struct gpgme_data_cbs data_cbs_;
   QSharedPointer<GFDataExchanger> data_ex_;
+  std::pair<GpgDataReadFunc, GpgDataWriteFunc> data_funcs_;
 };
 
 }  // namespace GpgFrontend
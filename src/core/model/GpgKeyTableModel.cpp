@@ -28,27 +28,154 @@
 
 #include "GpgKeyTableModel.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "core/function/gpg/GpgKeyGetter.h"
 #include "core/model/GpgKey.h"
 
 namespace GpgFrontend {
 
+namespace {
+
+auto KeyTypeSymbol(const GpgKey &key) -> QString {
+  QString type_sym;
+  type_sym += key.IsPrivateKey() ? "pub/sec" : "pub";
+  if (key.IsPrivateKey() && !key.IsHasMasterKey()) type_sym += "#";
+  if (key.IsHasCardKey()) type_sym += "^";
+  return type_sym;
+}
+
+auto KeyUsageSymbol(const GpgKey &key) -> QString {
+  QString usage_sym;
+  if (key.IsHasActualCertCap()) usage_sym += "C";
+  if (key.IsHasActualEncrCap()) usage_sym += "E";
+  if (key.IsHasActualSignCap()) usage_sym += "S";
+  if (key.IsHasActualAuthCap()) usage_sym += "A";
+  return usage_sym;
+}
+
+/**
+ * @brief a search text or keywords needs at least that many characters to
+ * be looked up in the trigram index
+ *
+ */
+constexpr qsizetype kTrigramSize = 3;
+
+auto Trigram(const QChar *chars) -> quint64 {
+  return (static_cast<quint64>(chars[0].unicode()) << 32) |
+         (static_cast<quint64>(chars[1].unicode()) << 16) |
+         static_cast<quint64>(chars[2].unicode());
+}
+
+}  // namespace
+
+GpgKeyTableRow::GpgKeyTableRow(const GpgKey &key)
+    : fpr(key.GetFingerprint()),
+      id(key.GetId()),
+      type(KeyTypeSymbol(key)),
+      name(key.GetName()),
+      email(key.GetEmail()),
+      usage(KeyUsageSymbol(key)),
+      owner_trust(key.GetOwnerTrust()),
+      create_time(key.GetCreateTime()),
+      algo(key.GetKeyAlgo()),
+      subkeys_count(static_cast<int>(key.GetSubKeys()->size())),
+      comment(key.GetComment()),
+      is_private(key.IsPrivateKey()),
+      is_revoked(key.IsRevoked()),
+      is_disabled(key.IsDisabled()),
+      is_expired(key.IsExpired()) {
+  for (const auto &uid : *key.GetUIDs()) uids.push_back(uid.GetUID());
+}
+
+void GpgKeyTableModel::RowCache::Reserve(qsizetype size) {
+  ids.reserve(size);
+  types.reserve(size);
+  names.reserve(size);
+  emails.reserve(size);
+  usages.reserve(size);
+  owner_trusts.reserve(size);
+  create_dates.reserve(size);
+  algos.reserve(size);
+  subkeys_counts.reserve(size);
+  comments.reserve(size);
+  private_flags.reserve(size);
+  usable_flags.reserve(size);
+  search_texts.reserve(size);
+}
+
+void GpgKeyTableModel::RowCache::Append(const GpgKeyTableRow &row) {
+  ids.push_back(row.id);
+  types.push_back(row.type);
+  names.push_back(row.name);
+  emails.push_back(row.email);
+  usages.push_back(row.usage);
+  owner_trusts.push_back(row.owner_trust);
+  create_dates.push_back(QLocale().toString(row.create_time, "yyyy-MM-dd"));
+  algos.push_back(row.algo);
+  subkeys_counts.push_back(row.subkeys_count);
+  comments.push_back(row.comment);
+  private_flags.push_back(row.is_private);
+  usable_flags.push_back(
+      !(row.is_revoked || row.is_disabled || row.is_expired));
+
+  // a line per field, so that no keywords match across two fields
+  QStringList search_fields{row.name,
+                            row.email,
+                            row.comment,
+                            row.id,
+                            row.fpr,
+                            row.type,
+                            row.usage,
+                            row.owner_trust,
+                            create_dates.back(),
+                            row.algo,
+                            QString::number(row.subkeys_count)};
+  search_fields << row.uids;
+  search_texts.push_back(search_fields.join('\n').toLower());
+}
+
+auto GpgKeyTableModel::RowCache::Size() const -> qsizetype {
+  return ids.size();
+}
+
 GpgKeyTableModel::GpgKeyTableModel(int channel, GpgKeyList keys,
                                    QObject *parent)
     : QAbstractTableModel(parent),
-      buffered_keys_(std::move(keys)),
       column_headers_({tr("Select"), tr("Type"), tr("Name"),
                        tr("Email Address"), tr("Usage"), tr("Trust"),
                        tr("Key ID"), tr("Create Date"), tr("Algorithm"),
                        tr("Subkey(s)"), tr("Comment")}),
       gpg_context_channel_(channel),
-      key_check_state_(buffered_keys_.size()) {
+      key_check_state_(keys.size()) {
+  row_cache_.Reserve(keys.size());
+  for (const auto &key : keys) row_cache_.Append(GpgKeyTableRow(key));
+
   LOG_D() << "init gpg key table module at channel: " << gpg_context_channel_
-          << "key list size: " << buffered_keys_.size();
+          << "key list size: " << row_cache_.Size();
+}
+
+GpgKeyTableModel::GpgKeyTableModel(int channel,
+                                   QContainer<GpgKeyTableRow> rows,
+                                   QObject *parent)
+    : QAbstractTableModel(parent),
+      is_snapshot_(true),
+      column_headers_({tr("Select"), tr("Type"), tr("Name"),
+                       tr("Email Address"), tr("Usage"), tr("Trust"),
+                       tr("Key ID"), tr("Create Date"), tr("Algorithm"),
+                       tr("Subkey(s)"), tr("Comment")}),
+      gpg_context_channel_(channel),
+      key_check_state_(rows.size()) {
+  row_cache_.Reserve(rows.size());
+  for (const auto &row : rows) row_cache_.Append(row);
+
+  LOG_D() << "init gpg key table module from snapshot at channel: "
+          << gpg_context_channel_ << "rows: " << row_cache_.Size();
 }
 
 auto GpgKeyTableModel::rowCount(const QModelIndex & /*parent*/) const -> int {
-  return static_cast<int>(buffered_keys_.size());
+  return static_cast<int>(row_cache_.Size());
 }
 
 auto GpgKeyTableModel::columnCount(const QModelIndex & /*parent*/) const
@@ -58,7 +185,7 @@ auto GpgKeyTableModel::columnCount(const QModelIndex & /*parent*/) const
 
 auto GpgKeyTableModel::data(const QModelIndex &index,
                             int role) const -> QVariant {
-  if (!index.isValid() || buffered_keys_.empty()) return {};
+  if (!index.isValid() || index.row() >= row_cache_.Size()) return {};
 
   if (role == Qt::CheckStateRole) {
     if (index.column() == 0) {
@@ -67,50 +194,41 @@ auto GpgKeyTableModel::data(const QModelIndex &index,
   }
 
   if (role == Qt::DisplayRole) {
-    const auto &key = buffered_keys_.at(index.row());
+    const auto row = index.row();
 
     switch (index.column()) {
       case 0: {
-        return index.row();
+        return row;
       }
       case 1: {
-        QString type_sym;
-        type_sym += key.IsPrivateKey() ? "pub/sec" : "pub";
-        if (key.IsPrivateKey() && !key.IsHasMasterKey()) type_sym += "#";
-        if (key.IsHasCardKey()) type_sym += "^";
-        return type_sym;
+        return row_cache_.types[row];
       }
       case 2: {
-        return key.GetName();
+        return row_cache_.names[row];
       }
       case 3: {
-        return key.GetEmail();
+        return row_cache_.emails[row];
       }
       case 4: {
-        QString usage_sym;
-        if (key.IsHasActualCertCap()) usage_sym += "C";
-        if (key.IsHasActualEncrCap()) usage_sym += "E";
-        if (key.IsHasActualSignCap()) usage_sym += "S";
-        if (key.IsHasActualAuthCap()) usage_sym += "A";
-        return usage_sym;
+        return row_cache_.usages[row];
       }
       case 5: {
-        return key.GetOwnerTrust();
+        return row_cache_.owner_trusts[row];
       }
       case 6: {
-        return key.GetId();
+        return row_cache_.ids[row];
       }
       case 7: {
-        return QLocale().toString(key.GetCreateTime(), "yyyy-MM-dd");
+        return row_cache_.create_dates[row];
       }
       case 8: {
-        return key.GetKeyAlgo();
+        return row_cache_.algos[row];
       }
       case 9: {
-        return static_cast<int>(key.GetSubKeys()->size());
+        return row_cache_.subkeys_counts[row];
       }
       case 10: {
-        return key.GetComment();
+        return row_cache_.comments[row];
       }
       default:
         return {};
@@ -170,23 +288,100 @@ auto GpgKeyTableModel::setData(const QModelIndex &index, const QVariant &value,
 
 auto GpgKeyTableModel::GetAllKeyIds() -> KeyIdArgsList {
   KeyIdArgsList keys;
-  for (auto &key : buffered_keys_) {
-    keys.push_back(key.GetId());
+  for (const auto &key_id : row_cache_.ids) {
+    keys.push_back(key_id);
   }
   return keys;
 }
 
 auto GpgKeyTableModel::GetKeyIDByRow(int row) const -> QString {
-  if (buffered_keys_.size() <= row) return {};
+  if (row_cache_.Size() <= row) return {};
 
-  return buffered_keys_[row].GetId();
+  return row_cache_.ids[row];
 }
 
 auto GpgKeyTableModel::IsPrivateKeyByRow(int row) const -> bool {
-  if (buffered_keys_.size() <= row) return false;
-  return buffered_keys_[row].IsPrivateKey();
+  if (row_cache_.Size() <= row) return false;
+  return row_cache_.private_flags[row];
+}
+
+auto GpgKeyTableModel::IsUsableKeyByRow(int row) const -> bool {
+  if (row_cache_.Size() <= row) return false;
+  return row_cache_.usable_flags[row];
 }
 
+auto GpgKeyTableModel::SearchRows(const QString &keywords) const
+    -> QContainer<int> {
+  const auto query = keywords.toLower();
+
+  QContainer<int> candidates;
+  if (!last_search_.isEmpty() && query.contains(last_search_)) {
+    // the user keeps typing, only the last matches can still match
+    if (query == last_search_) return last_search_rows_;
+    candidates = last_search_rows_;
+  } else if (query.size() >= kTrigramSize) {
+    if (!search_index_built_) build_search_index();
+
+    QSet<quint64> trigrams;
+    for (qsizetype i = 0; i + kTrigramSize <= query.size(); i++) {
+      trigrams.insert(Trigram(query.constData() + i));
+    }
+
+    QContainer<const QContainer<int> *> postings;
+    for (const auto &trigram : trigrams) {
+      auto it = search_index_.constFind(trigram);
+      if (it == search_index_.constEnd()) {
+        postings.clear();
+        break;
+      }
+      postings.push_back(&it.value());
+    }
+
+    // intersect starting from the shortest list of rows
+    std::sort(
+        postings.begin(), postings.end(),
+        [](const auto *a, const auto *b) { return a->size() < b->size(); });
+    if (!postings.isEmpty()) candidates = *postings.front();
+    for (qsizetype i = 1; i < postings.size() && !candidates.isEmpty(); i++) {
+      QContainer<int> intersection;
+      std::set_intersection(candidates.cbegin(), candidates.cend(),
+                            postings[i]->cbegin(), postings[i]->cend(),
+                            std::back_inserter(intersection));
+      candidates = std::move(intersection);
+    }
+  } else {
+    candidates.reserve(row_cache_.Size());
+    for (int row = 0; row < row_cache_.Size(); row++) candidates.push_back(row);
+  }
+
+  // the trigrams may be spread over a text, check the candidates
+  QContainer<int> rows;
+  for (const auto row : candidates) {
+    if (row_cache_.search_texts[row].contains(query)) rows.push_back(row);
+  }
+
+  last_search_ = query;
+  last_search_rows_ = rows;
+  return rows;
+}
+
+void GpgKeyTableModel::build_search_index() const {
+  for (int row = 0; row < row_cache_.Size(); row++) {
+    const auto &text = row_cache_.search_texts[row];
+    for (qsizetype i = 0; i + kTrigramSize <= text.size(); i++) {
+      // rows are indexed in order, each row once per trigram
+      auto &rows = search_index_[Trigram(text.constData() + i)];
+      if (rows.isEmpty() || rows.back() != row) rows.push_back(row);
+    }
+  }
+
+  search_index_built_ = true;
+  LOG_D() << "key table search index built, rows:" << row_cache_.Size()
+          << "trigrams:" << search_index_.size();
+}
+
+auto GpgKeyTableModel::IsSnapshot() const -> bool { return is_snapshot_; }
+
 auto GpgKeyTableModel::GetGpgContextChannel() const -> int {
   return gpg_context_channel_;
 }
@@ -88,6 +88,7 @@ enum class GpgKeyTableDisplayMode : unsigned int {
   kPUBLIC_KEY = 1 << 0,
   kPRIVATE_KEY = 1 << 1,
   kFAVORITES = 1 << 2,
+  kUSABLE = 1 << 3,  ///< neither revoked, disabled nor expired
   kALL = ~0U
 };
 
@@ -110,6 +111,40 @@ inline auto operator&(GpgKeyTableDisplayMode lhs,
   return (static_cast<T>(lhs) & static_cast<T>(rhs)) != 0;
 }
 
+/**
+ * @brief the values of a key which the key table shows, they are kept in the
+ * key table snapshot to show the keys before the keyring is listed
+ *
+ */
+struct GPGFRONTEND_CORE_EXPORT GpgKeyTableRow {
+  QString fpr;            ///<
+  QString id;             ///<
+  QString type;           ///< pub, pub/sec, with # and ^ marks
+  QString name;           ///<
+  QString email;          ///<
+  QString usage;          ///< actual capabilities, like CESA
+  QString owner_trust;    ///<
+  QDateTime create_time;  ///<
+  QString algo;           ///<
+  int subkeys_count = 0;  ///<
+  QString comment;        ///<
+  QStringList uids;       ///< full user ids
+
+  bool is_private = false;   ///<
+  bool is_revoked = false;   ///<
+  bool is_disabled = false;  ///<
+  bool is_expired = false;   ///<
+
+  GpgKeyTableRow() = default;
+
+  /**
+   * @brief Construct a new Gpg Key Table Row object
+   *
+   * @param key
+   */
+  explicit GpgKeyTableRow(const GpgKey &key);
+};
+
 class GPGFRONTEND_CORE_EXPORT GpgKeyTableModel : public QAbstractTableModel {
   Q_OBJECT
  public:
@@ -122,6 +157,17 @@ class GPGFRONTEND_CORE_EXPORT GpgKeyTableModel : public QAbstractTableModel {
   explicit GpgKeyTableModel(int channel, GpgKeyList keys,
                             QObject *parent = nullptr);
 
+  /**
+   * @brief Construct a model of the rows of a key table snapshot, which
+   * has no keys behind it
+   *
+   * @param channel
+   * @param rows
+   * @param parent
+   */
+  explicit GpgKeyTableModel(int channel, QContainer<GpgKeyTableRow> rows,
+                            QObject *parent = nullptr);
+
   /**
    * @brief
    *
@@ -204,6 +250,34 @@ class GPGFRONTEND_CORE_EXPORT GpgKeyTableModel : public QAbstractTableModel {
    */
   [[nodiscard]] auto IsPrivateKeyByRow(int row) const -> bool;
 
+  /**
+   * @brief if the key is neither revoked, disabled nor expired
+   *
+   * @param row
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto IsUsableKeyByRow(int row) const -> bool;
+
+  /**
+   * @brief Get the rows whose name, email, user ids, key id, fingerprint or
+   * any shown value contains the keywords, case insensitive
+   *
+   * @param keywords
+   * @return QContainer<int> rows in ascending order
+   */
+  [[nodiscard]] auto SearchRows(const QString &keywords) const
+      -> QContainer<int>;
+
+  /**
+   * @brief if the rows come from the key table snapshot, the keys of them
+   * may not be in the key cache yet
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto IsSnapshot() const -> bool;
+
   /**
    * @brief
    *
@@ -212,11 +286,50 @@ class GPGFRONTEND_CORE_EXPORT GpgKeyTableModel : public QAbstractTableModel {
   [[nodiscard]] auto GetGpgContextChannel() const -> int;
 
  private:
-  GpgKeyList buffered_keys_;
+  /**
+   * @brief the display values of the rows, column by column, computed once
+   * per model so that data() only indexes into them
+   *
+   */
+  struct RowCache {
+    QContainer<QString> ids;           ///<
+    QContainer<QString> types;         ///<
+    QContainer<QString> names;         ///<
+    QContainer<QString> emails;        ///<
+    QContainer<QString> usages;        ///<
+    QContainer<QString> owner_trusts;  ///<
+    QContainer<QString> create_dates;  ///< formatted in the locale
+    QContainer<QString> algos;         ///<
+    QContainer<int> subkeys_counts;    ///<
+    QContainer<QString> comments;      ///<
+    QContainer<bool> private_flags;    ///<
+    QContainer<bool> usable_flags;     ///< not revoked, disabled or expired
+    QContainer<QString> search_texts;  ///< lower case, a field per line
+
+    void Reserve(qsizetype size);
+
+    void Append(const GpgKeyTableRow &row);
+
+    [[nodiscard]] auto Size() const -> qsizetype;
+  };
+
+  RowCache row_cache_;
+  bool is_snapshot_ = false;
+
+  mutable QHash<quint64, QContainer<int>> search_index_;  ///< trigram -> rows
+  mutable bool search_index_built_ = false;               ///<
+  mutable QString last_search_;                           ///<
+  mutable QContainer<int> last_search_rows_;              ///<
   QStringList column_headers_;
   int gpg_context_channel_;
 
   QContainer<bool> key_check_state_;
+
+  /**
+   * @brief index the trigrams of the search texts of all rows
+   *
+   */
+  void build_search_index() const;
 };
 
 }  // namespace GpgFrontend
\ No newline at end of file
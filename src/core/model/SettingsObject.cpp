@@ -43,6 +43,7 @@ SettingsObject::SettingsObject(QString settings_name)
     } else {
       QJsonObject::operator=({});
     }
+    stored_ = *this;
 
   } catch (std::exception& e) {
     LOG_W() << "load setting object error: {}" << e.what();
@@ -53,9 +54,9 @@ SettingsObject::SettingsObject(QJsonObject sub_json)
     : QJsonObject(std::move(sub_json)) {}
 
 SettingsObject::~SettingsObject() {
-  if (!settings_name_.isEmpty()) {
-    DataObjectOperator::GetInstance().SaveDataObj(settings_name_,
-                                                  QJsonDocument(*this));
+  if (!settings_name_.isEmpty() && IsModified()) {
+    DataObjectOperator::GetInstance().SaveDataObjLater(settings_name_,
+                                                       QJsonDocument(*this));
   }
 }
 
@@ -63,4 +64,8 @@ void SettingsObject::Store(const QJsonObject& json) {
   auto* parent = (static_cast<QJsonObject*>(this));
   *parent = json;
 }
+
+auto SettingsObject::IsModified() const -> bool {
+  return static_cast<const QJsonObject&>(*this) != stored_;
+}
 }  // namespace GpgFrontend
\ No newline at end of file
@@ -54,7 +54,8 @@ class GPGFRONTEND_CORE_EXPORT SettingsObject : public QJsonObject {
   explicit SettingsObject(QJsonObject sub_json);
 
   /**
-   * @brief Destroy the Settings Object object
+   * @brief Destroy the Settings Object object, it is saved only if it was
+   * modified
    *
    */
   ~SettingsObject();
@@ -65,7 +66,16 @@ class GPGFRONTEND_CORE_EXPORT SettingsObject : public QJsonObject {
    */
   void Store(const QJsonObject&);
 
+  /**
+   * @brief whether it differs from the stored one
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto IsModified() const -> bool;
+
  private:
   QString settings_name_;  ///<
+  QJsonObject stored_;     ///< as it was loaded
 };
 }  // namespace GpgFrontend
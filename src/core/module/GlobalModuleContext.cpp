@@ -28,19 +28,274 @@
 
 #include "GlobalModuleContext.h"
 
+#include <chrono>
+#include <deque>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 #include "core/module/Event.h"
 #include "core/module/Module.h"
 #include "core/thread/Task.h"
+#include "core/thread/TaskRunner.h"
+#include "core/thread/TaskTracer.h"
 #include "model/DataObject.h"
 #include "thread/TaskRunnerGetter.h"
 #include "utils/MemoryUtils.h"
 
 namespace GpgFrontend::Module {
 
+namespace {
+
+// events a lane executes before it yields its thread to the other tasks
+constexpr int kModuleEventBatch = 16;
+
+auto SinceUs(std::chrono::steady_clock::time_point since) -> qint64 {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - since)
+      .count();
+}
+
+}  // namespace
+
+/**
+ * @brief A serial lane of a module on a thread of its own, which the module
+ * lives on. Its events and its deactivation run there one after another and
+ * in order, while the modules run concurrently. An event which is dropped
+ * instead is completed by its callback with "ret" set to -1, so a trigger
+ * waiting for it, like the pinentry request, never hangs.
+ *
+ */
+class ModuleEventLane : public std::enable_shared_from_this<ModuleEventLane> {
+ public:
+  ModuleEventLane(ModulePtr module, ModuleIdentifier module_id)
+      : module_(std::move(module)),
+        module_id_(std::move(module_id)),
+        runner_(SecureCreateSharedObject<Thread::TaskRunner>()) {
+    runner_->Start();
+  }
+
+  /**
+   * @brief the runner of the thread the module lives on
+   *
+   * @return TaskRunnerPtr
+   */
+  [[nodiscard]] auto GetTaskRunner() const -> TaskRunnerPtr { return runner_; }
+
+  void Configure(int capacity, ModuleEventOverflowPolicy policy) {
+    std::deque<QueuedEvent> dropped;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      capacity_ = std::max(1, capacity);
+      policy_ = policy;
+
+      while (static_cast<int>(queue_.size()) > capacity_) {
+        dropped.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+        dropped_++;
+      }
+    }
+
+    for (const auto& queued : dropped) complete_dropped(queued.event);
+  }
+
+  void Open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    open_ = true;
+  }
+
+  /**
+   * @brief drop the queued events and refuse new ones. The running event
+   * isn't waited for, whatever is posted to the runner afterwards runs once
+   * it is done.
+   *
+   */
+  void Close() {
+    std::deque<QueuedEvent> dropped;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      open_ = false;
+      dropped_ += static_cast<qint64>(queue_.size());
+      dropped.swap(queue_);
+    }
+
+    for (const auto& queued : dropped) complete_dropped(queued.event);
+  }
+
+  void Post(const EventReference& event) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    EventReference dropped;
+    if (!open_) {
+      dropped = event;
+    } else if (static_cast<int>(queue_.size()) >= capacity_) {
+      dropped = make_room_locked(event);
+      dropped_++;
+      LOG_W() << "event queue of module" << module_id_
+              << "is full, drop event:" << dropped->GetIdentifier();
+    }
+
+    auto need_schedule = false;
+    if (dropped != event) {
+      queue_.push_back({event, std::chrono::steady_clock::now()});
+      need_schedule = !std::exchange(scheduled_, true);
+    }
+    lock.unlock();
+
+    if (dropped != nullptr) complete_dropped(dropped);
+    if (need_schedule) schedule();
+  }
+
+  auto Stats() -> ModuleEventStats {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ModuleEventStats stats;
+    stats.queued = static_cast<int>(queue_.size());
+    stats.capacity = capacity_;
+    stats.executed = executed_;
+    stats.failed = failed_;
+    stats.dropped = dropped_;
+    stats.max_latency_us = max_latency_us_;
+    stats.max_exec_us = max_exec_us_;
+    if (executed_ > 0) {
+      stats.avg_latency_us = total_latency_us_ / executed_;
+      stats.avg_exec_us = total_exec_us_ / executed_;
+    }
+    return stats;
+  }
+
+ private:
+  struct QueuedEvent {
+    EventReference event;
+    std::chrono::steady_clock::time_point triggered_at;
+  };
+
+  const ModulePtr module_;
+  const ModuleIdentifier module_id_;
+  const TaskRunnerPtr runner_;
+
+  std::mutex mutex_;
+  std::deque<QueuedEvent> queue_;
+  int capacity_ = kModuleEventQueueCapacity;
+  ModuleEventOverflowPolicy policy_ = ModuleEventOverflowPolicy::kDropOldest;
+  bool open_ = false;
+  bool scheduled_ = false;  ///< a drain task is posted or running
+
+  qint64 executed_ = 0;
+  qint64 failed_ = 0;
+  qint64 dropped_ = 0;
+  qint64 total_latency_us_ = 0;
+  qint64 max_latency_us_ = 0;
+  qint64 total_exec_us_ = 0;
+  qint64 max_exec_us_ = 0;
+
+  /**
+   * @brief apply the overflow policy to a full queue
+   *
+   * @return EventReference the event to drop, which may be the new one
+   */
+  auto make_room_locked(const EventReference& event) -> EventReference {
+    switch (policy_) {
+      case ModuleEventOverflowPolicy::kDropNewest:
+        return event;
+      case ModuleEventOverflowPolicy::kCoalesce: {
+        auto it = std::find_if(queue_.begin(), queue_.end(),
+                               [&](const QueuedEvent& queued) {
+                                 return queued.event->GetIdentifier() ==
+                                        event->GetIdentifier();
+                               });
+        if (it != queue_.end()) {
+          auto dropped = std::move(it->event);
+          queue_.erase(it);
+          return dropped;
+        }
+        [[fallthrough]];
+      }
+      case ModuleEventOverflowPolicy::kDropOldest: {
+        auto dropped = std::move(queue_.front().event);
+        queue_.pop_front();
+        return dropped;
+      }
+    }
+    return event;
+  }
+
+  /**
+   * @brief tell the trigger that this module won't execute the event
+   *
+   * @param event
+   */
+  void complete_dropped(const EventReference& event) {
+    event->ExecuteCallback(module_id_, {{"ret", "-1"}});
+  }
+
+  void schedule() {
+    runner_->PostTask(new Thread::Task(
+        [weak_self = weak_from_this()](const DataObjectPtr&) -> int {
+          if (auto self = weak_self.lock(); self != nullptr) self->drain();
+          return 0;
+        },
+        QString("module/%1/events").arg(module_id_)));
+  }
+
+  void drain() {
+    for (int i = 0; i < kModuleEventBatch; i++) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (queue_.empty() || !open_) {
+        scheduled_ = false;
+        return;
+      }
+
+      auto queued = std::move(queue_.front());
+      queue_.pop_front();
+      const auto latency_us = SinceUs(queued.triggered_at);
+      lock.unlock();
+
+      const auto event_id = queued.event->GetIdentifier();
+      const auto exec_start = std::chrono::steady_clock::now();
+      int code = -1;
+      {
+        Thread::TraceSpan span(
+            QString("event/%1/module/exec/%2").arg(event_id).arg(module_id_),
+            "module");
+        try {
+          code = module_->Exec(queued.event);
+        } catch (...) {
+          LOG_W() << "module" << module_id_
+                  << "caught exception while executing event" << event_id;
+        }
+      }
+      const auto exec_us = SinceUs(exec_start);
+
+      if (code < 0) {
+        LOG_W() << "module " << module_id_ << "execution failed of event "
+                << event_id << ": exec return code: " << code;
+      }
+
+      lock.lock();
+      executed_++;
+      if (code < 0) failed_++;
+      total_latency_us_ += latency_us;
+      max_latency_us_ = std::max(max_latency_us_, latency_us);
+      total_exec_us_ += exec_us;
+      max_exec_us_ = std::max(max_exec_us_, exec_us);
+    }
+
+    // let the other tasks on the thread of the module run, then carry on
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (queue_.empty() || !open_) {
+      scheduled_ = false;
+      return;
+    }
+    lock.unlock();
+    schedule();
+  }
+};
+
+using ModuleEventLanePtr = std::shared_ptr<ModuleEventLane>;
+
 class GlobalModuleContext::Impl {
  public:
   explicit Impl() {
@@ -80,15 +335,17 @@ class GlobalModuleContext::Impl {
     return kGpgFrontendDefaultChannel;
   }
 
-  auto GetTaskRunner(ModuleRawPtr /*module*/) -> std::optional<TaskRunnerPtr> {
-    return Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
-        Thread::TaskRunnerGetter::kTaskRunnerType_Module);
+  auto GetTaskRunner(ModuleRawPtr module) -> std::optional<TaskRunnerPtr> {
+    if (module == nullptr) return {};
+    return GetTaskRunner(module->GetModuleIdentifier());
   }
 
-  auto GetTaskRunner(ModuleIdentifier /*module_id*/)
+  auto GetTaskRunner(const ModuleIdentifier& module_id)
       -> std::optional<TaskRunnerPtr> {
-    return Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
-        Thread::TaskRunnerGetter::kTaskRunnerType_Module);
+    // the runner of the thread the module lives on
+    auto lane = search_module_event_lane(module_id);
+    if (lane == nullptr) return {};
+    return lane->GetTaskRunner();
   }
 
   auto GetGlobalTaskRunner() -> std::optional<TaskRunnerPtr> {
@@ -114,16 +371,21 @@ class GlobalModuleContext::Impl {
     register_info->channel = acquire_new_unique_channel();
     register_info->integrated = integrated_module;
 
-    // move module to its task runner' thread
+    auto lane = std::make_shared<ModuleEventLane>(
+        module, module->GetModuleIdentifier());
+
+    // the module lives on the thread of its lane, which executes its events
     register_info->module->setParent(nullptr);
-    register_info->module->moveToThread(
-        Thread::TaskRunnerGetter::GetInstance()
-            .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Module)
-            ->GetThread());
+    register_info->module->moveToThread(lane->GetTaskRunner()->GetThread());
 
     // register the module with its identifier.
     module_register_table_[module->GetModuleIdentifier()] = register_info;
 
+    {
+      std::lock_guard<std::mutex> lock(module_event_lanes_lock_);
+      module_event_lanes_[module->GetModuleIdentifier()] = lane;
+    }
+
     if (module->Register() != 0) {
       LOG_W() << "module: " << module->GetModuleIdentifier()
               << " register failed.";
@@ -166,10 +428,19 @@ class GlobalModuleContext::Impl {
       return false;
     }
 
+    if (module_info->deactivating) {
+      LOG_W() << "module id:" << module_id
+              << " is still deactivating, activation abort...";
+      return false;
+    }
+
     // Activate the module if it is not already active.
     if (!module_info->activate) {
       module->Active();
       module_info->activate = true;
+      if (auto lane = search_module_event_lane(module_id); lane != nullptr) {
+        lane->Open();
+      }
 
       LOG_D() << "(*) module: " << module_id << "activated.";
     }
@@ -212,20 +483,38 @@ class GlobalModuleContext::Impl {
     }
 
     auto module_info = module_info_opt.value();
-    // activate the module if it is not already Deactivate.
-    if (module_info->activate && (module_info->module->Deactivate() == 0)) {
-      for (const auto& event_ids : module_info->listening_event_ids) {
-        auto& modules = module_events_table_[event_ids];
-        if (auto it = modules.find(module_id); it != modules.end()) {
-          modules.erase(it);
-        }
-      }
+    if (!module_info->activate || module_info->deactivating) return true;
 
-      module_info->listening_event_ids.clear();
-      module_info->activate = false;
+    auto lane = search_module_event_lane(module_id);
+    if (lane == nullptr) {
+      LOG_W() << "module id:" << module_id << " has no event lane";
+      return false;
     }
 
-    return !module_info->activate;
+    // the queued events are dropped, the running one isn't waited for. the
+    // module deactivates on its own thread once that event is done.
+    module_info->deactivating = true;
+    lane->Close();
+
+    lane->GetTaskRunner()->PostTask(new Thread::Task(
+        [this, module = module_info->module,
+         module_id](const DataObjectPtr&) -> int {
+          const auto code = module->Deactivate();
+
+          // the module tables belong to the module runner
+          Thread::TaskRunnerGetter::GetInstance()
+              .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Module)
+              ->PostTask(new Thread::Task(
+                  [this, module_id, code](const DataObjectPtr&) -> int {
+                    finish_deactivation(module_id, code == 0);
+                    return 0;
+                  },
+                  QString("module/%1/deactivated").arg(module_id)));
+          return code;
+        },
+        QString("module/%1/deactivate").arg(module_id)));
+
+    return true;
   }
 
   auto TriggerEvent(const EventReference& event) -> bool {
@@ -267,37 +556,35 @@ class GlobalModuleContext::Impl {
 
       // Retrieve the module's information
       auto module_info = module_info_opt.value();
-      auto module = module_info->module;
 
       // Check if the module is activated
       if (!module_info->activate) continue;
 
-      Thread::Task::TaskRunnable const exec_runnerable =
-          [module, event](DataObjectPtr) -> int { return module->Exec(event); };
-
-      Thread::Task::TaskCallback const exec_callback =
-          [listener_module_id, event_id](int code, DataObjectPtr) {
-            if (code < 0) {
-              // Log an error if the module execution fails
-              LOG_W() << "module " << listener_module_id
-                      << "execution failed of event " << event_id
-                      << ": exec return code: " << code;
-            }
-          };
-
-      Thread::TaskRunnerGetter::GetInstance()
-          .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Module)
-          ->PostTask(new Thread::Task(exec_runnerable,
-                                      QString("event/%1/module/exec/%2")
-                                          .arg(event_id)
-                                          .arg(listener_module_id),
-                                      nullptr, exec_callback));
+      // the lane of the module executes it, other modules aren't affected
+      auto lane = search_module_event_lane(listener_module_id);
+      if (lane != nullptr) lane->Post(event);
     }
 
     // Return true to indicate successful execution of all modules
     return true;
   }
 
+  auto SetModuleEventQueue(const ModuleIdentifier& module_id, int capacity,
+                           ModuleEventOverflowPolicy policy) -> bool {
+    auto lane = search_module_event_lane(module_id);
+    if (lane == nullptr) return false;
+
+    lane->Configure(capacity, policy);
+    return true;
+  }
+
+  auto GetModuleEventStats(const ModuleIdentifier& module_id)
+      -> std::optional<ModuleEventStats> {
+    auto lane = search_module_event_lane(module_id);
+    if (lane == nullptr) return {};
+    return lane->Stats();
+  }
+
   auto SearchEvent(const EventTriggerIdentifier& trigger_id)
       -> std::optional<EventReference> {
     if (module_on_triggering_events_table_.find(trigger_id) !=
@@ -349,6 +636,7 @@ class GlobalModuleContext::Impl {
     ModulePtr module;
     bool registered;
     bool activate;
+    bool deactivating;  ///< Deactivate() is pending on the module thread
     bool integrated;
     QStringList listening_event_ids;
   };
@@ -362,6 +650,10 @@ class GlobalModuleContext::Impl {
   std::map<EventTriggerIdentifier, EventReference>
       module_on_triggering_events_table_;
 
+  std::mutex module_event_lanes_lock_;
+  std::unordered_map<ModuleIdentifier, ModuleEventLanePtr>
+      module_event_lanes_;  ///< also read by other threads for the stats
+
   std::set<int> acquired_channel_;
   TaskRunnerPtr default_task_runner_;
   int registered_modules_ = 0;
@@ -378,6 +670,48 @@ class GlobalModuleContext::Impl {
     return random_channel;
   }
 
+  /**
+   * @brief called on the module runner once Deactivate() has returned
+   *
+   * @param module_id
+   * @param deactivated
+   */
+  void finish_deactivation(const ModuleIdentifier& module_id,
+                           bool deactivated) {
+    auto module_info_opt = search_module_register_table(module_id);
+    if (!module_info_opt.has_value()) return;
+
+    auto module_info = module_info_opt.value();
+    module_info->deactivating = false;
+
+    if (!deactivated) {
+      LOG_W() << "module id:" << module_id << " failed to deactivate";
+      if (auto lane = search_module_event_lane(module_id); lane != nullptr) {
+        lane->Open();
+      }
+      return;
+    }
+
+    for (const auto& event_ids : module_info->listening_event_ids) {
+      auto& modules = module_events_table_[event_ids];
+      if (auto it = modules.find(module_id); it != modules.end()) {
+        modules.erase(it);
+      }
+    }
+
+    module_info->listening_event_ids.clear();
+    module_info->activate = false;
+
+    LOG_D() << "(-) module: " << module_id << "deactivated.";
+  }
+
+  auto search_module_event_lane(const ModuleIdentifier& identifier)
+      -> ModuleEventLanePtr {
+    std::lock_guard<std::mutex> lock(module_event_lanes_lock_);
+    auto it = module_event_lanes_.find(identifier);
+    return it != module_event_lanes_.end() ? it->second : nullptr;
+  }
+
   // Function to search for a module in the register table.
   [[nodiscard]] auto search_module_register_table(
       const ModuleIdentifier& identifier) const
@@ -441,6 +775,17 @@ auto GlobalModuleContext::TriggerEvent(EventReference event) -> bool {
   return p_->TriggerEvent(event);
 }
 
+auto GlobalModuleContext::SetModuleEventQueue(
+    ModuleIdentifier module_id, int capacity,
+    ModuleEventOverflowPolicy policy) -> bool {
+  return p_->SetModuleEventQueue(module_id, capacity, policy);
+}
+
+auto GlobalModuleContext::GetModuleEventStats(ModuleIdentifier module_id)
+    -> std::optional<ModuleEventStats> {
+  return p_->GetModuleEventStats(module_id);
+}
+
 auto GlobalModuleContext::SearchEvent(EventTriggerIdentifier trigger_id)
     -> std::optional<EventReference> {
   return p_->SearchEvent(trigger_id);
@@ -51,6 +51,35 @@ using GRTPtr = std::shared_ptr<GlobalRegisterTable>;
 
 using TaskRunnerPtr = std::shared_ptr<Thread::TaskRunner>;
 
+constexpr int kModuleEventQueueCapacity = 256;  ///< default queue capacity
+
+/**
+ * @brief what happens to an event triggered for a module whose event queue
+ * is full
+ *
+ */
+enum class ModuleEventOverflowPolicy {
+  kDropNewest,  ///< drop the triggered event
+  kDropOldest,  ///< drop the oldest queued event
+  kCoalesce,    ///< replace a queued event of the same id, else drop oldest
+};
+
+/**
+ * @brief runtime statistics of the event queue of a module
+ *
+ */
+struct ModuleEventStats {
+  int queued = 0;             ///< events waiting for the module
+  int capacity = 0;           ///< capacity of the event queue
+  qint64 executed = 0;        ///< events executed since registration
+  qint64 failed = 0;          ///< executed events returning an error code
+  qint64 dropped = 0;         ///< events dropped by overflow or deactivation
+  qint64 avg_latency_us = 0;  ///< average time from trigger to execution
+  qint64 max_latency_us = 0;  ///< longest time from trigger to execution
+  qint64 avg_exec_us = 0;     ///< average execution time
+  qint64 max_exec_us = 0;     ///< longest execution time
+};
+
 class GPGFRONTEND_CORE_EXPORT GlobalModuleContext : public QObject {
   Q_OBJECT
  public:
@@ -64,6 +93,14 @@ class GPGFRONTEND_CORE_EXPORT GlobalModuleContext : public QObject {
 
   static auto GetDefaultChannel(ModuleRawPtr) -> int;
 
+  /**
+   * @brief every registered module lives on a thread of its own, which
+   * executes its events and its deactivation. Register() and Active() are
+   * called on the module runner before any event is delivered.
+   *
+   * @return std::optional<TaskRunnerPtr> the runner of that thread, nothing
+   * if the module isn't registered
+   */
   auto GetTaskRunner(ModuleRawPtr) -> std::optional<TaskRunnerPtr>;
 
   auto GetTaskRunner(ModuleIdentifier) -> std::optional<TaskRunnerPtr>;
@@ -74,12 +111,36 @@ class GPGFRONTEND_CORE_EXPORT GlobalModuleContext : public QObject {
 
   auto ActiveModule(ModuleIdentifier) -> bool;
 
+  /**
+   * @brief drop the queued events of the module and deactivate it on its
+   * thread once the running event is done, without waiting for it
+   *
+   * @return false if the module isn't registered
+   */
   auto DeactivateModule(ModuleIdentifier) -> bool;
 
   auto ListenEvent(ModuleIdentifier, EventIdentifier) -> bool;
 
   auto TriggerEvent(EventReference) -> bool;
 
+  /**
+   * @brief every module executes its events one after another on its own
+   * thread, this sets up the bounded queue in front of it. A dropped event
+   * is completed by its callback with "ret" set to -1.
+   *
+   * @return false if the module isn't registered
+   */
+  auto SetModuleEventQueue(ModuleIdentifier, int capacity,
+                           ModuleEventOverflowPolicy) -> bool;
+
+  /**
+   * @brief thread safe, may be called from any thread
+   *
+   * @return std::optional<ModuleEventStats>
+   */
+  auto GetModuleEventStats(ModuleIdentifier)
+      -> std::optional<ModuleEventStats>;
+
   auto SearchEvent(EventTriggerIdentifier) -> std::optional<EventReference>;
 
   auto GetModuleListening(ModuleIdentifier) -> QStringList;
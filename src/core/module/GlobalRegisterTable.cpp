@@ -28,7 +28,9 @@
 
 #include "GlobalRegisterTable.h"
 
+#include <algorithm>
 #include <any>
+#include <atomic>
 #include <optional>
 #include <shared_mutex>
 #include <vector>
@@ -39,21 +41,33 @@
 
 namespace GpgFrontend::Module {
 
-class GlobalRegisterTable::Impl {
- public:
-  struct RTNode {
-    QString name;
-    QString type = tr("NODE");
-    int version = 0;
-    const std::type_info* value_type = nullptr;
-    std::optional<std::any> value = std::nullopt;
-    QMap<QString, QSharedPointer<RTNode>> children;
-    QWeakPointer<RTNode> parent;
+using RTSegment = quint32;
+
+struct RTSubscriber {
+  QPointer<QObject> receiver;
+  LPCallback callback;
+  Namespace n;  ///< as subscribed, the callback always gets these
+  Key k;
+};
 
-    explicit RTNode(QString name, const QSharedPointer<RTNode>& parent)
-        : name(std::move(name)), parent(parent) {}
-  };
+struct RTNode {
+  QString name;
+  QString type = GlobalRegisterTable::tr("NODE");
+  std::atomic_int version = 0;
+  const std::type_info* value_type = nullptr;
+  std::optional<std::any> value = std::nullopt;
+  QMap<QString, QSharedPointer<RTNode>> children;  ///< published ones only
+  QHash<RTSegment, QSharedPointer<RTNode>> segments;  ///< all of them
+  QWeakPointer<RTNode> parent;
+  QContainer<RTSubscriber> subscribers;
+
+  explicit RTNode(QString name, const QSharedPointer<RTNode>& parent)
+      : name(std::move(name)), parent(parent) {}
+};
 
+class GlobalRegisterTable::Impl {
+ public:
+  using RTNode = Module::RTNode;
   using RTNodePtr = QSharedPointer<RTNode>;
 
   explicit Impl(GlobalRegisterTable* parent)
@@ -61,66 +75,54 @@ class GlobalRegisterTable::Impl {
         root_node_(SecureCreateQSharedObject<RTNode>("", nullptr)) {}
 
   auto PublishKV(const Namespace& n, const Key& k, std::any v) -> bool {
-    QStringList const segments = (n + "." + k).split('.');
     int version = 0;
-
+    QContainer<RTSubscriber> subscribers;
     {
       std::unique_lock lock(lock_);
+      version = update_leaf(fetch_node(n, k), v, subscribers);
+    }
 
-      auto current = root_node_;
-      for (const QString& segment : segments) {
-        auto it = current->children.find(segment);
-        if (it == current->children.end()) {
-          it = current->children.insert(
-              segment, SecureCreateQSharedObject<RTNode>(segment, current));
-        }
-        current = it.value();
-      }
+    notify(subscribers, version, v);
+    emit parent_->SignalPublish(n, k, version, v);
+    return true;
+  }
 
-      current->name = segments.back();
-      current->type = tr("LEAF");
-      current->value = v;
-      current->value_type = &v.type();
-      version = ++current->version;
+  auto PublishKV(const RTNodePtr& node, const Namespace& n, const Key& k,
+                 std::any v) -> bool {
+    int version = 0;
+    QContainer<RTSubscriber> subscribers;
+    {
+      std::unique_lock lock(lock_);
+      version = update_leaf(node, v, subscribers);
     }
 
+    notify(subscribers, version, v);
     emit parent_->SignalPublish(n, k, version, v);
     return true;
   }
 
   auto LookupKV(const Namespace& n, const Key& k) -> std::optional<std::any> {
-    QStringList const segments = (n + "." + k).split('.');
+    std::shared_lock const lock(lock_);
 
-    std::optional<std::any> rtn = std::nullopt;
-    {
-      std::shared_lock const lock(lock_);
+    auto* node = find_node(n, k);
+    if (node == nullptr) return std::nullopt;
+    return node->value;
+  }
 
-      auto current = root_node_;
-      for (const QString& segment : segments) {
-        auto it = current->children.find(segment);
-        if (it == current->children.end()) return std::nullopt;
-        current = it.value();
-      }
-      rtn = current->value;
-    }
-    return rtn;
+  auto LookupKV(const RTNodePtr& node) -> std::optional<std::any> {
+    std::shared_lock const lock(lock_);
+    return node->value;
   }
 
   auto ListChildKeys(const Namespace& n, const Key& k) -> QContainer<Key> {
-    QStringList const segments = (n + "." + k).split('.');
-
     QContainer<Key> rtn;
     {
       std::shared_lock lock(lock_);
 
-      auto current = root_node_;
-      for (const QString& segment : segments) {
-        auto it = current->children.find(segment);
-        if (it == current->children.end()) return {};
-        current = it.value();
-      }
+      auto* node = find_node(n, k);
+      if (node == nullptr) return {};
 
-      for (auto& key : current->children.keys()) rtn.push_back(key);
+      for (auto& key : node->children.keys()) rtn.push_back(key);
     }
     return rtn;
   }
@@ -128,13 +130,24 @@ class GlobalRegisterTable::Impl {
   auto ListenPublish(QObject* o, const Namespace& n, const Key& k,
                      LPCallback c) -> bool {
     if (o == nullptr) return false;
-    return QObject::connect(parent_, &GlobalRegisterTable::SignalPublish, o,
-                            [n, k, c](const Namespace& pn, const Key& pk,
-                                      int ver, std::any value) {
-                              if (pn == n && pk == k) {
-                                c(pn, pk, ver, std::move(value));
-                              }
-                            }) == nullptr;
+
+    std::unique_lock lock(lock_);
+    subscribe(fetch_node(n, k).get(), {o, std::move(c), n, k});
+    return true;
+  }
+
+  auto ListenPublish(QObject* o, const RTNodePtr& node, const Namespace& n,
+                     const Key& k, LPCallback c) -> bool {
+    if (o == nullptr) return false;
+
+    std::unique_lock lock(lock_);
+    subscribe(node.get(), {o, std::move(c), n, k});
+    return true;
+  }
+
+  auto FetchNode(const Namespace& n, const Key& k) -> RTNodePtr {
+    std::unique_lock lock(lock_);
+    return fetch_node(n, k);
   }
 
   auto RootRTNode() -> RTNodePtr { return root_node_; }
@@ -144,6 +157,154 @@ class GlobalRegisterTable::Impl {
   GlobalRegisterTable* parent_;
 
   RTNodePtr root_node_;
+  QHash<QString, RTSegment> segment_ids_;
+  QContainer<QString> segment_names_;
+
+  /**
+   * @brief visit the segments of n and k as if they were joined by a dot,
+   * without building the joined string or a list of parts. the segments
+   * borrow the buffers of n and k.
+   *
+   */
+  template <typename F>
+  static auto for_each_segment(const Namespace& n, const Key& k,
+                               F&& f) -> bool {
+    for (const auto* s : {&n, &k}) {
+      qsizetype begin = 0;
+      while (true) {
+        auto end = s->indexOf('.', begin);
+        auto size = (end < 0 ? s->size() : end) - begin;
+        if (!f(QString::fromRawData(s->constData() + begin, size))) {
+          return false;
+        }
+        if (end < 0) break;
+        begin = end + 1;
+      }
+    }
+    return true;
+  }
+
+  auto intern(const QString& segment) -> RTSegment {
+    auto it = segment_ids_.constFind(segment);
+    if (it != segment_ids_.cend()) return it.value();
+
+    // the segment may borrow the caller's buffer, keep a copy of our own
+    auto name = QString(segment.constData(), segment.size());
+    auto id = static_cast<RTSegment>(segment_names_.size());
+    segment_names_.push_back(name);
+    segment_ids_.insert(name, id);
+    return id;
+  }
+
+  /**
+   * @brief should be called with lock_ held, a segment which was never
+   * interned ends the walk before touching the tree.
+   *
+   */
+  auto find_node(const Namespace& n, const Key& k) -> RTNode* {
+    auto* current = root_node_.get();
+    auto found = for_each_segment(n, k, [&](const QString& segment) {
+      auto id = segment_ids_.constFind(segment);
+      if (id == segment_ids_.cend()) return false;
+
+      auto it = current->segments.constFind(id.value());
+      if (it == current->segments.cend()) return false;
+      current = it.value().get();
+      return true;
+    });
+    return found ? current : nullptr;
+  }
+
+  /**
+   * @brief should be called with lock_ held exclusively. the nodes created
+   * here stay hidden from the children of their parents, and so from
+   * ListChildKeys() and the tree model, until a value is published to them
+   * or below them.
+   *
+   */
+  auto fetch_node(const Namespace& n, const Key& k) -> RTNodePtr {
+    auto current = root_node_;
+    for_each_segment(n, k, [&](const QString& segment) {
+      auto id = intern(segment);
+
+      auto it = current->segments.constFind(id);
+      if (it != current->segments.cend()) {
+        current = it.value();
+        return true;
+      }
+
+      const auto& name = segment_names_[id];
+      auto node = SecureCreateQSharedObject<RTNode>(name, current);
+      current->segments.insert(id, node);
+      current = node;
+      return true;
+    });
+    return current;
+  }
+
+  /**
+   * @brief should be called with lock_ held exclusively, returns the new
+   * version and the live subscribers of the node.
+   *
+   */
+  static auto update_leaf(const RTNodePtr& node, const std::any& v,
+                          QContainer<RTSubscriber>& subscribers) -> int {
+    node->type = tr("LEAF");
+    node->value = v;
+    node->value_type = &v.type();
+    reveal(node);
+
+    prune_subscribers(node.get());
+    subscribers = node->subscribers;
+    return ++node->version;
+  }
+
+  /**
+   * @brief make the node and its hidden parents children of their parents
+   *
+   */
+  static void reveal(RTNodePtr node) {
+    for (auto parent = node->parent.toStrongRef(); parent != nullptr;
+         node = parent, parent = node->parent.toStrongRef()) {
+      if (parent->children.contains(node->name)) return;
+      parent->children.insert(node->name, node);
+    }
+  }
+
+  static void subscribe(RTNode* node, RTSubscriber subscriber) {
+    prune_subscribers(node);
+    node->subscribers.push_back(std::move(subscriber));
+  }
+
+  static void prune_subscribers(RTNode* node) {
+    auto& subscribers = node->subscribers;
+    subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                     [](const RTSubscriber& s) {
+                                       return s.receiver.isNull();
+                                     }),
+                      subscribers.end());
+  }
+
+  /**
+   * @brief deliver like an auto connection would: directly on the thread of
+   * the receiver, queued otherwise. every subscriber gets the namespace and
+   * key it subscribed with, which may split the path differently than the
+   * publisher did.
+   *
+   */
+  static void notify(const QContainer<RTSubscriber>& subscribers, int version,
+                     const std::any& v) {
+    for (const auto& subscriber : subscribers) {
+      auto* receiver = subscriber.receiver.data();
+      if (receiver == nullptr) continue;
+
+      QMetaObject::invokeMethod(receiver, [c = subscriber.callback,
+                                           n = subscriber.n, k = subscriber.k,
+                                           version, v]() {
+        c(n, k, version, v);
+      });
+    }
+  }
 };
 
 class GlobalRegisterTableTreeModel::Impl {
@@ -305,6 +466,41 @@ auto GlobalRegisterTable::ListChildKeys(Namespace n, Key k) -> QContainer<Key> {
   return p_->ListChildKeys(n, k);
 }
 
+auto GlobalRegisterTable::ResolveKey(Namespace n, Key k) -> RTKey {
+  RTKey key;
+  key.node_ = p_->FetchNode(n, k);
+  key.n_ = std::move(n);
+  key.k_ = std::move(k);
+  return key;
+}
+
+auto GlobalRegisterTable::PublishKV(const RTKey& key, std::any v) -> bool {
+  if (!key.IsValid()) return false;
+  return p_->PublishKV(key.node_, key.n_, key.k_, std::move(v));
+}
+
+auto GlobalRegisterTable::LookupKV(const RTKey& key)
+    -> std::optional<std::any> {
+  if (!key.IsValid()) return std::nullopt;
+  return p_->LookupKV(key.node_);
+}
+
+auto GlobalRegisterTable::ListenPublish(QObject* o, const RTKey& key,
+                                        LPCallback c) -> bool {
+  if (!key.IsValid()) return false;
+  return p_->ListenPublish(o, key.node_, key.n_, key.k_, std::move(c));
+}
+
+auto RTKey::IsValid() const -> bool { return node_ != nullptr; }
+
+auto RTKey::GetNamespace() const -> Namespace { return n_; }
+
+auto RTKey::GetKey() const -> Key { return k_; }
+
+auto RTKey::GetVersion() const -> int {
+  return node_ == nullptr ? 0 : node_->version.load();
+}
+
 GlobalRegisterTableTreeModel::GlobalRegisterTableTreeModel(
     GlobalRegisterTable* grt, QObject* parent)
     : QAbstractItemModel(parent),
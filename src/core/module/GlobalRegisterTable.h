@@ -41,6 +41,48 @@ using Namespace = QString;
 using Key = QString;
 using LPCallback = std::function<void(Namespace, Key, int, std::any)>;
 
+struct RTNode;
+
+/**
+ * @brief a precompiled path of the register table. it pins the node the path
+ * resolves to, so publishing, looking up and listening through it skip
+ * parsing the path and walking the tree.
+ *
+ */
+class GPGFRONTEND_CORE_EXPORT RTKey {
+ public:
+  RTKey() = default;
+
+  [[nodiscard]] auto IsValid() const -> bool;
+
+  [[nodiscard]] auto GetNamespace() const -> Namespace;
+
+  [[nodiscard]] auto GetKey() const -> Key;
+
+  /**
+   * @brief the version of the node, it changes on every publish and can be
+   * read without taking the lock of the table.
+   *
+   * @return int
+   */
+  [[nodiscard]] auto GetVersion() const -> int;
+
+ private:
+  friend class GlobalRegisterTable;
+
+  Namespace n_;
+  Key k_;
+  QSharedPointer<RTNode> node_;
+};
+
+/**
+ * @brief a tree of values shared by the core and the modules. A namespace
+ * and a key name a path of dot separated segments, so ("a", "b.c") and
+ * ("a.b", "c") are the same entry. A node only shows up in ListChildKeys()
+ * and the tree model once a value is published to it or below it, looking
+ * up, listening or resolving a key doesn't make it visible.
+ *
+ */
 class GlobalRegisterTable : public QObject {
   Q_OBJECT
  public:
@@ -54,10 +96,30 @@ class GlobalRegisterTable : public QObject {
 
   auto LookupKV(Namespace, Key) -> std::optional<std::any>;
 
+  /**
+   * @brief the callback runs on the thread of the receiver whenever a value
+   * is published to the path, however the publisher split it. It gets the
+   * namespace and key given here.
+   *
+   * @return false if there is no receiver
+   */
   auto ListenPublish(QObject *, Namespace, Key, LPCallback) -> bool;
 
   auto ListChildKeys(Namespace n, Key k) -> QContainer<Key>;
 
+  /**
+   * @brief resolve a path once, creating its node if it does not exist yet.
+   *
+   * @return RTKey
+   */
+  auto ResolveKey(Namespace, Key) -> RTKey;
+
+  auto PublishKV(const RTKey &, std::any) -> bool;
+
+  auto LookupKV(const RTKey &) -> std::optional<std::any>;
+
+  auto ListenPublish(QObject *, const RTKey &, LPCallback) -> bool;
+
  signals:
   void SignalPublish(Namespace, Key, int, std::any);
 
@@ -175,6 +175,16 @@ class ModuleManager::Impl {
     return gmc_->SearchEvent(std::move(trigger_id));
   }
 
+  auto SetModuleEventQueue(const ModuleIdentifier& module_id, int capacity,
+                           ModuleEventOverflowPolicy policy) -> bool {
+    return gmc_->SetModuleEventQueue(module_id, capacity, policy);
+  }
+
+  auto GetModuleEventStats(const ModuleIdentifier& module_id)
+      -> std::optional<ModuleEventStats> {
+    return gmc_->GetModuleEventStats(module_id);
+  }
+
   auto GetModuleListening(ModuleIdentifier module_id) -> QStringList {
     return gmc_->GetModuleListening(std::move(module_id));
   }
@@ -222,6 +232,22 @@ class ModuleManager::Impl {
     return grt_->ListChildKeys(n, k);
   }
 
+  auto ResolveRTKey(Namespace n, Key k) -> RTKey {
+    return grt_->ResolveKey(std::move(n), std::move(k));
+  }
+
+  auto UpsertRTValue(const RTKey& key, std::any v) -> bool {
+    return grt_->PublishKV(key, std::move(v));
+  }
+
+  auto RetrieveRTValue(const RTKey& key) -> std::optional<std::any> {
+    return grt_->LookupKV(key);
+  }
+
+  auto ListenPublish(QObject* o, const RTKey& key, LPCallback c) -> bool {
+    return grt_->ListenPublish(o, key, std::move(c));
+  }
+
   auto IsModuleActivated(ModuleIdentifier id) -> bool {
     return gmc_->IsModuleActivated(id);
   }
@@ -311,6 +337,17 @@ auto ModuleManager::SearchEvent(EventTriggerIdentifier trigger_id)
   return p_->SearchEvent(std::move(trigger_id));
 }
 
+auto ModuleManager::SetModuleEventQueue(
+    ModuleIdentifier id, int capacity,
+    ModuleEventOverflowPolicy policy) -> bool {
+  return p_->SetModuleEventQueue(id, capacity, policy);
+}
+
+auto ModuleManager::GetModuleEventStats(ModuleIdentifier id)
+    -> std::optional<ModuleEventStats> {
+  return p_->GetModuleEventStats(id);
+}
+
 void ModuleManager::ActiveModule(ModuleIdentifier id) {
   return p_->ActiveModule(id);
 }
@@ -343,6 +380,24 @@ auto ModuleManager::ListRTChildKeys(const QString& n,
   return p_->ListRTChildKeys(n, k);
 }
 
+auto ModuleManager::ResolveRTKey(Namespace n, Key k) -> RTKey {
+  return p_->ResolveRTKey(std::move(n), std::move(k));
+}
+
+auto ModuleManager::UpsertRTValue(const RTKey& key, std::any v) -> bool {
+  return p_->UpsertRTValue(key, std::move(v));
+}
+
+auto ModuleManager::RetrieveRTValue(const RTKey& key)
+    -> std::optional<std::any> {
+  return p_->RetrieveRTValue(key);
+}
+
+auto ModuleManager::ListenRTPublish(QObject* o, const RTKey& key,
+                                    LPCallback c) -> bool {
+  return p_->ListenPublish(o, key, std::move(c));
+}
+
 auto ModuleManager::IsModuleActivated(ModuleIdentifier id) -> bool {
   return p_->IsModuleActivated(id);
 }
@@ -28,11 +28,14 @@
 
 #pragma once
 
+#include <functional>
+#include <mutex>
 #include <vector>
 
 #include "core/function/SecureMemoryAllocator.h"
 #include "core/function/basic/GpgFunctionObject.h"
 #include "core/module/Event.h"
+#include "core/module/GlobalModuleContext.h"
 #include "core/utils/MemoryUtils.h"
 
 namespace GpgFrontend::Thread {
@@ -87,6 +90,12 @@ class GPGFRONTEND_CORE_EXPORT ModuleManager
 
   auto SearchEvent(EventTriggerIdentifier) -> std::optional<EventReference>;
 
+  auto SetModuleEventQueue(ModuleIdentifier, int capacity,
+                           ModuleEventOverflowPolicy) -> bool;
+
+  auto GetModuleEventStats(ModuleIdentifier)
+      -> std::optional<ModuleEventStats>;
+
   auto GetModuleListening(ModuleIdentifier) -> QStringList;
 
   void ActiveModule(ModuleIdentifier);
@@ -103,6 +112,14 @@ class GPGFRONTEND_CORE_EXPORT ModuleManager
 
   auto ListRTChildKeys(const QString&, const QString&) -> QContainer<Key>;
 
+  auto ResolveRTKey(Namespace, Key) -> RTKey;
+
+  auto UpsertRTValue(const RTKey&, std::any) -> bool;
+
+  auto RetrieveRTValue(const RTKey&) -> std::optional<std::any>;
+
+  auto ListenRTPublish(QObject*, const RTKey&, LPCallback) -> bool;
+
   auto GRT() -> GlobalRegisterTable*;
 
  private:
@@ -203,4 +220,64 @@ auto RetrieveRTValueTypedOrDefault(const QString& namespace_,
   return defaultValue;
 }
 
+/**
+ * @brief a typed handle of a runtime value. the key is resolved once, and the
+ * value, converted by the parser, is cached until the version of its node
+ * changes, so repeated reads skip the lookup, the std::any copy and the
+ * conversion.
+ *
+ * @tparam T the type the value is published with
+ * @tparam V the type the value is converted to
+ */
+template <typename T, typename V = T>
+class RTHandle {
+ public:
+  using Parser = std::function<V(const T&)>;
+
+  RTHandle(Namespace n, Key k, T default_value,
+           Parser parser = [](const T& v) -> V { return V(v); })
+      : n_(std::move(n)),
+        k_(std::move(k)),
+        default_value_(std::move(default_value)),
+        parser_(std::move(parser)) {}
+
+  /**
+   * @brief the converted value, or the converted default value when the key
+   * is not published or has another type.
+   *
+   * @return V
+   */
+  auto Get() -> V {
+    std::lock_guard<std::mutex> const lock(mutex_);
+
+    if (!key_.IsValid()) {
+      key_ = ModuleManager::GetInstance().ResolveRTKey(n_, k_);
+    }
+
+    // read the version first, a newer value only leads to another refresh
+    const auto version = key_.GetVersion();
+    if (cached_value_ && version == cached_version_) return *cached_value_;
+
+    auto any_value = ModuleManager::GetInstance().RetrieveRTValue(key_);
+    if (any_value && any_value->type() == typeid(T)) {
+      cached_value_ = parser_(std::any_cast<T>(*any_value));
+    } else {
+      cached_value_ = parser_(default_value_);
+    }
+    cached_version_ = version;
+    return *cached_value_;
+  }
+
+ private:
+  Namespace n_;
+  Key k_;
+  T default_value_;
+  Parser parser_;
+
+  std::mutex mutex_;
+  RTKey key_;
+  int cached_version_ = 0;
+  std::optional<V> cached_value_;
+};
+
 }  // namespace GpgFrontend::Module
\ No newline at end of file
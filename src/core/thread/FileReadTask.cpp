@@ -30,7 +30,7 @@
 
 namespace GpgFrontend::UI {
 
-constexpr size_t kBufferSize = 8192;
+constexpr size_t kBufferSize = 256 * 1024;
 
 FileReadTask::FileReadTask(QString path)
     : Task("file_read_task"), read_file_path_(std::move(path)) {
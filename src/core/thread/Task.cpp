@@ -30,6 +30,7 @@
 
 #include <qscopedpointer.h>
 
+#include "core/thread/TaskTracer.h"
 #include "utils/MemoryUtils.h"
 
 namespace GpgFrontend::Thread {
@@ -114,6 +115,75 @@ class Task::Impl {
    */
   [[nodiscard]] auto GetRTN() const { return this->rtn_; }
 
+  /**
+   * @brief Set the Dispatcher object
+   *
+   * @param dispatcher
+   */
+  void SetDispatcher(TaskDispatcher dispatcher) {
+    dispatcher_ = std::move(dispatcher);
+  }
+
+  /**
+   * @brief the dispatcher is used only once
+   *
+   * @return TaskDispatcher
+   */
+  auto TakeDispatcher() -> TaskDispatcher {
+    return std::exchange(dispatcher_, nullptr);
+  }
+
+  /**
+   * @brief the task is posted, it waits for its runner from now on
+   *
+   */
+  void TraceQueued() {
+    auto &tracer = TaskTracer::GetInstance();
+    if (!tracer.IsEnabled() || queued_us_ >= 0) return;
+
+    queued_us_ = tracer.NowUs();
+    tracer.AddAsyncBegin(name_, "task", uuid_, queued_us_,
+                         {{"task", GetFullID()}});
+    tracer.AddAsyncBegin("queue", "task", uuid_, queued_us_);
+  }
+
+  /**
+   * @brief
+   *
+   * @param begin_us
+   * @param end_us
+   * @param rtn
+   */
+  void TraceRun(qint64 begin_us, qint64 end_us, int rtn) {
+    auto &tracer = TaskTracer::GetInstance();
+
+    QJsonObject args{{"task", GetFullID()}, {"rtn", rtn}};
+    if (queued_us_ >= 0) {
+      tracer.AddAsyncEnd("queue", "task", uuid_, begin_us);
+      args["queue_wait_us"] = begin_us - queued_us_;
+    }
+    tracer.AddComplete(name_, "task.run", begin_us, end_us, args);
+
+    // a task holding on its life cycle has no callback
+    if (queued_us_ >= 0 && !parent_->autoDelete()) {
+      tracer.AddAsyncEnd(name_, "task", uuid_, end_us);
+    }
+  }
+
+  /**
+   * @brief
+   *
+   * @param begin_us
+   * @param end_us
+   */
+  void TraceCallback(qint64 begin_us, qint64 end_us) {
+    auto &tracer = TaskTracer::GetInstance();
+
+    tracer.AddComplete(name_, "task.callback", begin_us, end_us,
+                       {{"task", GetFullID()}});
+    if (queued_us_ >= 0) tracer.AddAsyncEnd(name_, "task", uuid_, end_us);
+  }
+
  private:
   Task *const parent_;
   const QString uuid_;
@@ -123,6 +193,8 @@ class Task::Impl {
   int rtn_ = Task::kInitialRTN;          ///<
   QThread *callback_thread_ = nullptr;   ///<
   DataObjectPtr data_object_ = nullptr;  ///<
+  TaskDispatcher dispatcher_;            ///<
+  qint64 queued_us_ = -1;                ///< -1 if the task isn't traced
 
   void init() {
     //
@@ -140,6 +212,9 @@ class Task::Impl {
               // set task returning code
               SetRTN(rtn);
 
+              auto &tracer = TaskTracer::GetInstance();
+              const auto begin_us = tracer.IsEnabled() ? tracer.NowUs() : -1;
+
               try {
                 if (callback_) {
                   callback_(rtn_, data_object_);
@@ -149,6 +224,8 @@ class Task::Impl {
                         << "callback caught exception, rtn: " << rtn;
               }
 
+              if (begin_us >= 0) TraceCallback(begin_us, tracer.NowUs());
+
               LOG_D() << "task" << this->name_
                       << "sending task end signal, rtn:" << rtn;
               emit parent_->SignalTaskEnd();
@@ -194,7 +271,20 @@ void Task::HoldOnLifeCycle(bool hold_on) { p_->HoldOnLifeCycle(hold_on); }
 
 void Task::setRTN(int rtn) { p_->SetRTN(rtn); }
 
-void Task::SafelyRun() { emit SignalRun(); }
+void Task::SafelyRun() {
+  p_->TraceQueued();
+  if (auto dispatcher = p_->TakeDispatcher(); dispatcher) {
+    dispatcher(this);
+    return;
+  }
+  emit SignalRun();
+}
+
+void Task::set_dispatcher(TaskDispatcher dispatcher) {
+  p_->SetDispatcher(std::move(dispatcher));
+}
+
+void Task::trace_queued() { p_->TraceQueued(); }
 
 int Task::Run() { return p_->Run(); }
 
@@ -217,6 +307,10 @@ auto Task::TaskHandler::GetTask() -> Task * {
 
 void Task::slot_exception_safe_run() noexcept {
   auto rtn = p_->GetRTN();
+
+  auto &tracer = TaskTracer::GetInstance();
+  const auto begin_us = tracer.IsEnabled() ? tracer.NowUs() : -1;
+
   try {
     // Run() will set rtn by itself
     rtn = this->Run();
@@ -225,6 +319,8 @@ void Task::slot_exception_safe_run() noexcept {
     LOG_W() << "exception was caught at task: {}" << GetFullID();
   }
 
+  if (begin_us >= 0) p_->TraceRun(begin_us, tracer.NowUs(), rtn);
+
   // raise signal to anounce after runnable returned
   if (this->autoDelete()) emit this->SignalTaskShouldEnd(rtn);
 }
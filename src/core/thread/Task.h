@@ -43,6 +43,7 @@ class GPGFRONTEND_CORE_EXPORT Task : public QObject, public QRunnable {
 
   using TaskRunnable = std::function<int(DataObjectPtr)>;        ///<
   using TaskCallback = std::function<void(int, DataObjectPtr)>;  ///<
+  using TaskDispatcher = std::function<void(Task*)>;             ///<
   static const int kInitialRTN = -99;
 
   class TaskHandler {
@@ -170,6 +171,21 @@ class GPGFRONTEND_CORE_EXPORT Task : public QObject, public QRunnable {
   class Impl;
   SecureUniquePtr<Impl> p_;
 
+  /**
+   * @brief the first SafelyRun() hands the task over to the dispatcher
+   * instead of running it, used by the pooled task runners.
+   *
+   * @param dispatcher
+   */
+  void set_dispatcher(TaskDispatcher dispatcher);
+
+  /**
+   * @brief the task waits for its runner from now on, used by the pooled
+   * task runners, which hand it to the executor without SafelyRun().
+   *
+   */
+  void trace_queued();
+
   void run() override;
 };
 }  // namespace GpgFrontend::Thread
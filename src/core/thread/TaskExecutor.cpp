@@ -0,0 +1,398 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "core/thread/TaskExecutor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+
+#include "core/thread/Task.h"
+#include "core/utils/MemoryUtils.h"
+
+namespace GpgFrontend::Thread {
+
+namespace {
+
+/// lane and concurrency slot of the task running on this thread
+thread_local int tls_running_lane = -1;
+thread_local int tls_running_slot = -1;
+
+auto NowUs() -> qint64 {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+class TaskExecutor::Impl {
+ public:
+  Impl(int worker_count, const QContainer<int>& lane_priorities)
+      : lane_priorities_(lane_priorities) {
+    int lane_count = 0;
+    for (const auto lane : lane_priorities_) {
+      lane_count = std::max(lane_count, lane + 1);
+    }
+    lanes_.resize(lane_count);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < std::max(1, worker_count); i++) {
+      create_worker_locked(-1);
+    }
+  }
+
+  ~Impl() { Stop(); }
+
+  void Submit(Task* task, int lane) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      LOG_W() << "task executor is stopped, drop task:" << task->GetFullID();
+      delete task;
+      return;
+    }
+
+    const auto item = Item{task, lane, NowUs()};
+
+    // keep the tasks spawned by a worker close to it, others may steal them
+    auto* worker = current_worker_locked();
+    if (worker != nullptr && worker->bound_lane < 0) {
+      worker->local[lane].push_back(item);
+    } else {
+      lanes_[lane].queue.push_back(item);
+    }
+    lanes_[lane].queued++;
+
+    wake_idle_worker_locked();
+    ensure_progress_locked();
+  }
+
+  void SetLaneConcurrency(int lane, int max_concurrency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lanes_[lane].max_concurrency = std::max(1, max_concurrency);
+    wake_idle_worker_locked();
+  }
+
+  auto GetLaneConcurrency(int lane) -> int {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lanes_[lane].max_concurrency;
+  }
+
+  auto GetLaneStats(int lane) -> TaskLaneStats {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& l = lanes_[lane];
+
+    TaskLaneStats stats;
+    stats.queue_depth = l.queued;
+    stats.running = l.running;
+    stats.completed = l.completed;
+    stats.max_wait_us = l.max_wait_us;
+    if (l.started > 0) stats.avg_wait_us = l.total_wait_us / l.started;
+    if (l.completed > 0) stats.avg_run_us = l.total_run_us / l.completed;
+    return stats;
+  }
+
+  void Stop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopped_) return;
+    stopped_ = true;
+
+    // drop all the tasks which haven't started yet
+    int dropped = 0;
+    for (auto& lane : lanes_) {
+      dropped += static_cast<int>(lane.queue.size());
+      for (const auto& item : lane.queue) delete item.task;
+      lane.queue.clear();
+    }
+    for (auto& worker : workers_) {
+      for (auto& local : worker->local) {
+        dropped += static_cast<int>(local.size());
+        for (const auto& item : local) delete item.task;
+        local.clear();
+      }
+    }
+    if (dropped > 0) {
+      LOG_W() << "task executor dropped pending tasks:" << dropped;
+    }
+    lock.unlock();
+
+    for (auto& worker : workers_) {
+      worker->thread->quit();
+      worker->thread->wait();
+      delete worker->waker;
+      delete worker->thread;
+    }
+  }
+
+ private:
+  struct Item {
+    Task* task;
+    int lane;
+    qint64 submit_at;
+  };
+
+  struct Worker {
+    int index;
+    int bound_lane;  ///< -1 for core workers, the lane of a rescue worker
+    QThread* thread;
+    QObject* waker;  ///< lives in the worker thread, target of wake-ups
+    std::vector<std::deque<Item>> local;  ///< tasks spawned by this worker
+    bool busy = false;
+    bool idle = true;
+  };
+
+  struct Lane {
+    std::deque<Item> queue;  ///< tasks submitted from other threads
+    int queued = 0;          ///< waiting tasks, including the local ones
+    int running = 0;
+    int max_concurrency = std::numeric_limits<int>::max();
+    Worker* rescue = nullptr;
+    std::vector<bool> slots;  ///< concurrency slots taken by running tasks
+    qint64 started = 0;
+    qint64 completed = 0;
+    qint64 total_wait_us = 0;
+    qint64 max_wait_us = 0;
+    qint64 total_run_us = 0;
+  };
+
+  std::mutex mutex_;
+  const QContainer<int> lane_priorities_;
+  std::vector<Lane> lanes_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  bool stopped_ = false;
+
+  auto create_worker_locked(int bound_lane) -> Worker* {
+    auto worker = std::make_unique<Worker>();
+    worker->index = static_cast<int>(workers_.size());
+    worker->bound_lane = bound_lane;
+    worker->local.resize(lanes_.size());
+
+    worker->thread = new QThread();
+    worker->thread->setObjectName(
+        QString("gf_task_worker_%1").arg(worker->index));
+    worker->waker = new QObject();
+    worker->waker->moveToThread(worker->thread);
+    worker->thread->start();
+
+    workers_.push_back(std::move(worker));
+    return workers_.back().get();
+  }
+
+  auto current_worker_locked() -> Worker* {
+    auto* thread = QThread::currentThread();
+    for (const auto& worker : workers_) {
+      if (worker->thread == thread) return worker.get();
+    }
+    return nullptr;
+  }
+
+  void wake_locked(Worker* worker) {
+    if (!worker->idle) return;
+    worker->idle = false;
+
+    QMetaObject::invokeMethod(
+        worker->waker, [this, worker]() { drain(worker); },
+        Qt::QueuedConnection);
+  }
+
+  void wake_idle_worker_locked() {
+    for (const auto& worker : workers_) {
+      if (worker->bound_lane < 0 && worker->idle) {
+        wake_locked(worker.get());
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief A lane with waiting tasks but nothing running must not starve
+   * behind the other lanes, e.g. an archive task blocking on a gpg task. If
+   * no core worker is idle, the lane gets a rescue worker of its own, which
+   * gives every lane the progress guarantee of a dedicated thread.
+   *
+   */
+  void ensure_progress_locked() {
+    for (size_t i = 0; i < lanes_.size(); i++) {
+      auto& lane = lanes_[i];
+      if (lane.queued == 0 || lane.running != 0) continue;
+
+      auto idle_worker = std::find_if(
+          workers_.begin(), workers_.end(), [](const auto& worker) {
+            return worker->bound_lane < 0 && worker->idle;
+          });
+      if (idle_worker != workers_.end()) {
+        wake_locked(idle_worker->get());
+        continue;
+      }
+
+      if (lane.rescue == nullptr) {
+        lane.rescue = create_worker_locked(static_cast<int>(i));
+        LOG_D() << "task executor started rescue worker for lane:" << i;
+      }
+      wake_locked(lane.rescue);
+    }
+  }
+
+  auto take_from_lane_locked(Worker* worker, int lane_index)
+      -> std::optional<Item> {
+    auto& lane = lanes_[lane_index];
+    if (lane.queued == 0 || lane.running >= lane.max_concurrency) return {};
+
+    std::optional<Item> item;
+    if (auto& local = worker->local[lane_index]; !local.empty()) {
+      item = local.back();
+      local.pop_back();
+    } else if (!lane.queue.empty()) {
+      item = lane.queue.front();
+      lane.queue.pop_front();
+    } else {
+      // steal the oldest task of another worker
+      for (const auto& other : workers_) {
+        auto& other_local = other->local[lane_index];
+        if (other.get() == worker || other_local.empty()) continue;
+        item = other_local.front();
+        other_local.pop_front();
+        break;
+      }
+    }
+
+    if (!item.has_value()) return {};
+    lane.queued--;
+    lane.running++;
+    return item;
+  }
+
+  /**
+   * @brief the lowest free slot, never above the concurrency limit of the
+   * lane as only that many tasks of it run at once.
+   *
+   */
+  static auto acquire_slot_locked(Lane& lane) -> int {
+    auto it = std::find(lane.slots.begin(), lane.slots.end(), false);
+    if (it == lane.slots.end()) it = lane.slots.insert(it, false);
+    *it = true;
+    return static_cast<int>(std::distance(lane.slots.begin(), it));
+  }
+
+  auto take_locked(Worker* worker) -> std::optional<Item> {
+    if (worker->bound_lane >= 0) {
+      return take_from_lane_locked(worker, worker->bound_lane);
+    }
+
+    for (const auto lane : lane_priorities_) {
+      if (auto item = take_from_lane_locked(worker, lane); item.has_value()) {
+        return item;
+      }
+    }
+    return {};
+  }
+
+  /**
+   * @brief run one task on the worker, called in the worker thread
+   *
+   * @param worker
+   */
+  void drain(Worker* worker) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // a running task spins a nested event loop, never start another one here
+    if (worker->busy || stopped_) return;
+
+    auto item = take_locked(worker);
+    if (!item.has_value()) {
+      worker->idle = true;
+      return;
+    }
+
+    worker->busy = true;
+    ensure_progress_locked();
+
+    auto& lane = lanes_[item->lane];
+    const auto start = NowUs();
+    const auto slot = acquire_slot_locked(lane);
+    lane.started++;
+    lane.total_wait_us += start - item->submit_at;
+    lane.max_wait_us = std::max(lane.max_wait_us, start - item->submit_at);
+    lock.unlock();
+
+    // the task has no thread affinity, so it could be pulled to this thread
+    item->task->moveToThread(worker->thread);
+    tls_running_lane = item->lane;
+    tls_running_slot = slot;
+    item->task->SafelyRun();
+    tls_running_lane = -1;
+    tls_running_slot = -1;
+
+    lock.lock();
+    lane.slots[slot] = false;
+    lane.running--;
+    lane.completed++;
+    lane.total_run_us += NowUs() - start;
+    worker->busy = false;
+
+    // the lane may accept one more task now
+    if (lane.queued > 0) wake_idle_worker_locked();
+    ensure_progress_locked();
+
+    // go back to the event loop before taking the next task
+    QMetaObject::invokeMethod(
+        worker->waker, [this, worker]() { drain(worker); },
+        Qt::QueuedConnection);
+  }
+};
+
+TaskExecutor::TaskExecutor(int worker_count,
+                           const QContainer<int>& lane_priorities)
+    : p_(SecureCreateUniqueObject<Impl>(worker_count, lane_priorities)) {}
+
+TaskExecutor::~TaskExecutor() = default;
+
+void TaskExecutor::Submit(Task* task, int lane) { p_->Submit(task, lane); }
+
+void TaskExecutor::SetLaneConcurrency(int lane, int max_concurrency) {
+  p_->SetLaneConcurrency(lane, max_concurrency);
+}
+
+auto TaskExecutor::GetLaneConcurrency(int lane) -> int {
+  return p_->GetLaneConcurrency(lane);
+}
+
+auto TaskExecutor::GetLaneStats(int lane) -> TaskLaneStats {
+  return p_->GetLaneStats(lane);
+}
+
+auto TaskExecutor::CurrentLaneSlot(int lane) -> int {
+  return tls_running_lane == lane ? tls_running_slot : -1;
+}
+
+void TaskExecutor::Stop() { p_->Stop(); }
+
+}  // namespace GpgFrontend::Thread
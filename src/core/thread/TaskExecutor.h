@@ -0,0 +1,133 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include "core/GpgFrontendCore.h"
+#include "core/function/SecureMemoryAllocator.h"
+#include "core/typedef/CoreTypedef.h"
+
+namespace GpgFrontend::Thread {
+
+class Task;
+
+/**
+ * @brief runtime statistics of a lane of the task executor
+ *
+ */
+struct TaskLaneStats {
+  int queue_depth = 0;     ///< tasks waiting for a worker
+  int running = 0;         ///< tasks running right now
+  qint64 completed = 0;    ///< tasks finished since startup
+  qint64 avg_wait_us = 0;  ///< average time from submit to start
+  qint64 max_wait_us = 0;  ///< longest time from submit to start
+  qint64 avg_run_us = 0;   ///< average run time
+};
+
+/**
+ * @brief A fixed-size pool of worker threads shared by all the pooled task
+ * runners. Every task runner type is mapped to a lane, lanes are served in
+ * priority order and can be limited in concurrency.
+ *
+ * Tasks submitted from a worker go to the worker's own deque, the owner
+ * pops the newest one while idle workers steal the oldest ones. Tasks
+ * submitted from other threads go to the lane's shared queue.
+ *
+ * Each worker runs a Qt event loop, so queued signals and deleteLater()
+ * keep working for the tasks running on it.
+ */
+class TaskExecutor {
+ public:
+  /**
+   * @brief Construct a new Task Executor object
+   *
+   * @param worker_count count of core workers
+   * @param lane_priorities lanes from the highest to the lowest priority
+   */
+  TaskExecutor(int worker_count, const QContainer<int>& lane_priorities);
+
+  /**
+   * @brief Destroy the Task Executor object
+   *
+   */
+  ~TaskExecutor();
+
+  /**
+   * @brief submit a task, the task must not have any thread affinity.
+   *
+   * @param task
+   * @param lane
+   */
+  void Submit(Task* task, int lane);
+
+  /**
+   * @brief limit how many tasks of a lane run at the same time
+   *
+   * @param lane
+   * @param max_concurrency
+   */
+  void SetLaneConcurrency(int lane, int max_concurrency);
+
+  /**
+   * @brief Get the Lane Concurrency object
+   *
+   * @param lane
+   * @return int
+   */
+  auto GetLaneConcurrency(int lane) -> int;
+
+  /**
+   * @brief Get the Lane Stats object
+   *
+   * @param lane
+   * @return TaskLaneStats
+   */
+  auto GetLaneStats(int lane) -> TaskLaneStats;
+
+  /**
+   * @brief the concurrency slot held by the task of the lane running on the
+   * calling thread. slots are numbered from 0 and stay below the highest
+   * concurrency limit the lane ever had.
+   *
+   * @param lane
+   * @return int -1 if the calling thread doesn't run a task of the lane
+   */
+  static auto CurrentLaneSlot(int lane) -> int;
+
+  /**
+   * @brief stop all workers, tasks still queued are dropped
+   *
+   */
+  void Stop();
+
+ private:
+  class Impl;
+  SecureUniquePtr<Impl> p_;
+};
+
+}  // namespace GpgFrontend::Thread
@@ -28,7 +28,10 @@
 
 #include "core/thread/TaskRunner.h"
 
+#include <mutex>
+
 #include "core/thread/Task.h"
+#include "core/thread/TaskExecutor.h"
 
 namespace GpgFrontend::Thread {
 
@@ -36,6 +39,9 @@ class TaskRunner::Impl : public QThread {
  public:
   Impl() : QThread(nullptr) {}
 
+  Impl(std::shared_ptr<TaskExecutor> executor, int lane)
+      : QThread(nullptr), executor_(std::move(executor)), lane_(lane) {}
+
   void PostTask(Task* task) {
     if (task == nullptr) {
       FLOG_W("task posted is null");
@@ -43,8 +49,16 @@ class TaskRunner::Impl : public QThread {
     }
 
     task->setParent(nullptr);
-    task->moveToThread(this);
+    if (IsPooled()) {
+      // the worker running it will pull it to its thread, the wait in the
+      // queue starts now and not when the worker gets to SafelyRun()
+      task->moveToThread(nullptr);
+      task->trace_queued();
+      executor_->Submit(task, lane_);
+      return;
+    }
 
+    task->moveToThread(this);
     task->SafelyRun();
   }
 
@@ -53,7 +67,15 @@ class TaskRunner::Impl : public QThread {
                     DataObjectPtr params) -> Task::TaskHandler {
     auto* raw_task = new Task(runnerable, name, std::move(params), cb);
     raw_task->setParent(nullptr);
-    raw_task->moveToThread(this);
+    if (IsPooled()) {
+      raw_task->moveToThread(nullptr);
+      raw_task->set_dispatcher(
+          [executor = executor_, lane = lane_](Task* task) {
+            executor->Submit(task, lane);
+          });
+    } else {
+      raw_task->moveToThread(this);
+    }
 
     connect(raw_task, &Task::SignalRun, this, [this, raw_task]() {
       pending_tasks_[raw_task->GetFullID()] = raw_task;
@@ -77,6 +99,12 @@ class TaskRunner::Impl : public QThread {
       return;
     }
 
+    // the workers of the executor already run tasks concurrently
+    if (IsPooled()) {
+      PostTask(task);
+      return;
+    }
+
     auto* concurrent_thread = new QThread(this);
 
     task->setParent(nullptr);
@@ -91,17 +119,61 @@ class TaskRunner::Impl : public QThread {
     task->SafelyRun();
   }
 
-  void PostScheduleTask(Task* task, size_t seconds) {
-    if (task == nullptr) return;
-    // TODO
+  auto PostScheduleTask(Task* task,
+                        std::chrono::milliseconds delay) -> TaskScheduleID {
+    if (task == nullptr) {
+      FLOG_W("task posted is null");
+      return -1;
+    }
+    return get_scheduler()->Schedule(task, delay);
+  }
+
+  auto PostPeriodicTask(const QString& name, const Task::TaskRunnable& runnable,
+                        std::chrono::milliseconds interval,
+                        std::chrono::milliseconds delay) -> TaskScheduleID {
+    return get_scheduler()->SchedulePeriodic(
+        name, runnable, interval, delay.count() < 0 ? interval : delay);
   }
 
+  auto CancelScheduleTask(TaskScheduleID id) -> bool {
+    std::lock_guard<std::mutex> lock(scheduler_lock_);
+    return scheduler_ != nullptr && scheduler_->Cancel(id);
+  }
+
+  void StopScheduler() {
+    std::lock_guard<std::mutex> lock(scheduler_lock_);
+    if (scheduler_ != nullptr) scheduler_->Stop();
+  }
+
+  [[nodiscard]] auto IsPooled() const -> bool { return executor_ != nullptr; }
+
  private:
   QMap<QString, Task*> pending_tasks_;
+  std::shared_ptr<TaskExecutor> executor_;
+  int lane_ = 0;
+  std::mutex scheduler_lock_;
+  std::unique_ptr<TaskScheduler> scheduler_;
+
+  /**
+   * @brief the scheduler thread is started by the first scheduled task
+   *
+   * @return TaskScheduler*
+   */
+  auto get_scheduler() -> TaskScheduler* {
+    std::lock_guard<std::mutex> lock(scheduler_lock_);
+    if (scheduler_ == nullptr) {
+      scheduler_ = std::make_unique<TaskScheduler>(
+          [this](Task* task) { PostTask(task); });
+    }
+    return scheduler_.get();
+  }
 };
 
 TaskRunner::TaskRunner() : p_(SecureCreateUniqueObject<Impl>()) {}
 
+TaskRunner::TaskRunner(std::shared_ptr<TaskExecutor> executor, int lane)
+    : p_(SecureCreateUniqueObject<Impl>(std::move(executor), lane)) {}
+
 TaskRunner::~TaskRunner() {
   if (p_->isRunning()) {
     Stop();
@@ -119,20 +191,45 @@ void TaskRunner::PostConcurrentTask(Task* task) {
   p_->PostConcurrentTask(task);
 }
 
-void TaskRunner::PostScheduleTask(Task* task, size_t seconds) {
-  p_->PostScheduleTask(task, seconds);
+auto TaskRunner::PostScheduleTask(Task* task,
+                                  size_t seconds) -> TaskScheduleID {
+  return p_->PostScheduleTask(task, std::chrono::seconds(seconds));
 }
 
-void TaskRunner::Start() { p_->start(); }
+auto TaskRunner::PostScheduleTask(
+    Task* task, std::chrono::milliseconds delay) -> TaskScheduleID {
+  return p_->PostScheduleTask(task, delay);
+}
+
+auto TaskRunner::PostPeriodicTask(
+    const QString& name, const Task::TaskRunnable& runnable,
+    std::chrono::milliseconds interval,
+    std::chrono::milliseconds delay) -> TaskScheduleID {
+  return p_->PostPeriodicTask(name, runnable, interval, delay);
+}
+
+auto TaskRunner::CancelScheduleTask(TaskScheduleID id) -> bool {
+  return p_->CancelScheduleTask(id);
+}
+
+void TaskRunner::Start() {
+  // the workers are owned by the executor
+  if (p_->IsPooled()) return;
+  p_->start();
+}
 
 void TaskRunner::Stop() {
+  p_->StopScheduler();
+  if (p_->IsPooled()) return;
   p_->quit();
   p_->wait();
 }
 
 auto TaskRunner::GetThread() -> QThread* { return p_.get(); }
 
-auto TaskRunner::IsRunning() -> bool { return p_->isRunning(); }
+auto TaskRunner::IsRunning() -> bool {
+  return p_->IsPooled() || p_->isRunning();
+}
 
 auto TaskRunner::RegisterTask(const QString& name,
                               const Task::TaskRunnable& runnable,
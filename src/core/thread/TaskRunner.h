@@ -31,9 +31,12 @@
 #include "core/GpgFrontendCore.h"
 #include "core/function/SecureMemoryAllocator.h"
 #include "core/thread/Task.h"
+#include "core/thread/TaskScheduler.h"
 
 namespace GpgFrontend::Thread {
 
+class TaskExecutor;
+
 class GPGFRONTEND_CORE_EXPORT TaskRunner : public QObject {
   Q_OBJECT
  public:
@@ -43,6 +46,15 @@ class GPGFRONTEND_CORE_EXPORT TaskRunner : public QObject {
    */
   TaskRunner();
 
+  /**
+   * @brief Construct a new pooled Task Runner object, its tasks run on the
+   * workers of the executor instead of a thread of its own.
+   *
+   * @param executor
+   * @param lane
+   */
+  TaskRunner(std::shared_ptr<TaskExecutor> executor, int lane);
+
   /**
    * @brief Destroy the Task Runner object
    *
@@ -62,7 +74,8 @@ class GPGFRONTEND_CORE_EXPORT TaskRunner : public QObject {
   void Stop();
 
   /**
-   * @brief Get the Thread object
+   * @brief Get the Thread object, only meaningful for a runner which owns
+   * its thread.
    *
    * @return QThread*
    */
@@ -109,12 +122,45 @@ class GPGFRONTEND_CORE_EXPORT TaskRunner : public QObject {
   void PostConcurrentTask(Task* task);
 
   /**
-   * @brief
+   * @brief post the task to this runner after a delay
    *
    * @param task
    * @param seconds
+   * @return TaskScheduleID
+   */
+  auto PostScheduleTask(Task* task, size_t seconds) -> TaskScheduleID;
+
+  /**
+   * @brief post the task to this runner after a delay
+   *
+   * @param task
+   * @param delay
+   * @return TaskScheduleID
+   */
+  auto PostScheduleTask(Task* task,
+                        std::chrono::milliseconds delay) -> TaskScheduleID;
+
+  /**
+   * @brief post a new task of the runnable to this runner every interval
+   *
+   * @param name
+   * @param runnable
+   * @param interval
+   * @param delay of the first run, the interval if negative
+   * @return TaskScheduleID
+   */
+  auto PostPeriodicTask(const QString& name, const Task::TaskRunnable& runnable,
+                        std::chrono::milliseconds interval,
+                        std::chrono::milliseconds delay =
+                            std::chrono::milliseconds(-1)) -> TaskScheduleID;
+
+  /**
+   * @brief cancel a delayed or periodic task
+   *
+   * @param id
+   * @return true if the task was still scheduled
    */
-  void PostScheduleTask(Task* task, size_t seconds);
+  auto CancelScheduleTask(TaskScheduleID id) -> bool;
 
  private:
   class Impl;
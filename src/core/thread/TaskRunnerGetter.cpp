@@ -41,24 +41,73 @@ TaskRunnerGetter::TaskRunnerGetter(int)
 auto TaskRunnerGetter::GetTaskRunner(TaskRunnerType runner_type)
     -> TaskRunnerPtr {
   std::lock_guard<std::mutex> lock_guard(task_runners_map_lock_);
+
   while (true) {
     auto it = task_runners_.find(runner_type);
     if (it != task_runners_.end()) {
       return it->second;
     }
 
-    auto runner = GpgFrontend::SecureCreateSharedObject<TaskRunner>();
+    // the module tables are only touched on the thread of the module runner,
+    // in the order of the tasks posted to it
+    auto runner = runner_type == kTaskRunnerType_Module
+                      ? GpgFrontend::SecureCreateSharedObject<TaskRunner>()
+                      : GpgFrontend::SecureCreateSharedObject<TaskRunner>(
+                            get_executor(), runner_type);
     task_runners_[runner_type] = runner;
     runner->Start();
   }
 }
 
+void TaskRunnerGetter::SetGpgWorkerCount(int count) {
+  std::lock_guard<std::mutex> lock_guard(task_runners_map_lock_);
+  gpg_worker_count_ = std::max(1, count);
+  if (executor_ != nullptr) {
+    executor_->SetLaneConcurrency(kTaskRunnerType_GPG, gpg_worker_count_);
+  }
+}
+
+auto TaskRunnerGetter::GetGpgWorkerCount() -> int {
+  std::lock_guard<std::mutex> lock_guard(task_runners_map_lock_);
+  return gpg_worker_count_;
+}
+
+auto TaskRunnerGetter::GetGpgLaneSlot() -> int {
+  return TaskExecutor::CurrentLaneSlot(kTaskRunnerType_GPG);
+}
+
+auto TaskRunnerGetter::GetTaskRunnerStats(TaskRunnerType runner_type)
+    -> TaskLaneStats {
+  std::lock_guard<std::mutex> lock_guard(task_runners_map_lock_);
+  if (executor_ == nullptr || runner_type == kTaskRunnerType_Module) return {};
+  return executor_->GetLaneStats(runner_type);
+}
+
+auto TaskRunnerGetter::get_executor() -> std::shared_ptr<TaskExecutor> {
+  if (executor_ != nullptr) return executor_;
+
+  const auto worker_count = std::max(2, QThread::idealThreadCount());
+  executor_ = GpgFrontend::SecureCreateSharedObject<TaskExecutor>(
+      worker_count,
+      QContainer<int>{kTaskRunnerType_GPG, kTaskRunnerType_IO,
+                      kTaskRunnerType_Network,
+                      kTaskRunnerType_External_Process,
+                      kTaskRunnerType_Default});
+  executor_->SetLaneConcurrency(kTaskRunnerType_GPG, gpg_worker_count_);
+
+  LOG_D() << "task executor started, workers:" << worker_count
+          << "gpg concurrency:" << gpg_worker_count_;
+  return executor_;
+}
+
 void TaskRunnerGetter::StopAllTeakRunner() {
   for (const auto& [key, value] : task_runners_) {
     if (value->IsRunning()) {
       value->Stop();
     }
   }
+
+  if (executor_ != nullptr) executor_->Stop();
 }
 
-}  // namespace GpgFrontend::Thread
\ No newline at end of file
+}  // namespace GpgFrontend::Thread
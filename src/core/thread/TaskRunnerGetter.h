@@ -32,6 +32,7 @@
 
 #include "core/GpgFrontendCore.h"
 #include "core/function/basic/GpgFunctionObject.h"
+#include "core/thread/TaskExecutor.h"
 #include "core/thread/TaskRunner.h"
 
 namespace GpgFrontend::Thread {
@@ -53,14 +54,61 @@ class GPGFRONTEND_CORE_EXPORT TaskRunnerGetter
   explicit TaskRunnerGetter(
       int channel = SingletonFunctionObject::GetDefaultChannel());
 
+  /**
+   * @brief Get the Task Runner object. Except kTaskRunnerType_Module, which
+   * keeps a thread of its own for the module tables, all runners post their
+   * tasks to a lane of the shared task executor.
+   *
+   * @param runner_type
+   * @return TaskRunnerPtr
+   */
   auto GetTaskRunner(TaskRunnerType runner_type = kTaskRunnerType_Default)
       -> TaskRunnerPtr;
 
+  /**
+   * @brief Set how many gpg tasks may run at the same time
+   *
+   * @param count
+   */
+  void SetGpgWorkerCount(int count);
+
+  /**
+   * @brief Get the count of gpg workers
+   *
+   * @return int
+   */
+  auto GetGpgWorkerCount() -> int;
+
+  /**
+   * @brief Get the concurrency slot of the gpg task running on the calling
+   * thread, below the count of gpg workers.
+   *
+   * @return int slot, -1 if the calling thread doesn't run a gpg task
+   */
+  auto GetGpgLaneSlot() -> int;
+
+  /**
+   * @brief Get the queue depth and latency stats of a task runner
+   *
+   * @param runner_type
+   * @return TaskLaneStats
+   */
+  auto GetTaskRunnerStats(TaskRunnerType runner_type) -> TaskLaneStats;
+
   void StopAllTeakRunner();
 
  private:
   std::map<TaskRunnerType, TaskRunnerPtr> task_runners_;
+  std::shared_ptr<TaskExecutor> executor_;
+  int gpg_worker_count_ = 1;
   std::mutex task_runners_map_lock_;
+
+  /**
+   * @brief
+   *
+   * @return std::shared_ptr<TaskExecutor>
+   */
+  auto get_executor() -> std::shared_ptr<TaskExecutor>;
 };
 
 }  // namespace GpgFrontend::Thread
@@ -0,0 +1,257 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "core/thread/TaskScheduler.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+
+#include "core/utils/MemoryUtils.h"
+
+namespace GpgFrontend::Thread {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kTickDuration = std::chrono::milliseconds(10);
+constexpr qint64 kWheelSize = 512;
+
+}  // namespace
+
+class TaskScheduler::Impl : public QThread {
+ public:
+  explicit Impl(TaskPoster poster)
+      : QThread(nullptr), poster_(std::move(poster)), epoch_(Clock::now()) {
+    setObjectName("gf_task_scheduler");
+    wheel_.resize(kWheelSize);
+    start();
+  }
+
+  ~Impl() override { Stop(); }
+
+  auto Schedule(Task* task, std::chrono::milliseconds delay)
+      -> TaskScheduleID {
+    if (task == nullptr) return -1;
+
+    // the scheduler thread posts it later
+    task->setParent(nullptr);
+    task->moveToThread(this);
+
+    Entry entry;
+    entry.task = task;
+    return insert(std::move(entry), delay);
+  }
+
+  auto SchedulePeriodic(const QString& name,
+                        const Task::TaskRunnable& runnable,
+                        std::chrono::milliseconds interval,
+                        std::chrono::milliseconds delay) -> TaskScheduleID {
+    Entry entry;
+    entry.name = name;
+    entry.runnable = runnable;
+    entry.interval_ticks = to_ticks(interval);
+    return insert(std::move(entry), delay);
+  }
+
+  auto Cancel(TaskScheduleID id) -> bool {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end()) return false;
+
+    // the task belongs to the scheduler thread, let it delete the task
+    if (it->second.task != nullptr) cancelled_tasks_.push_back(it->second.task);
+    entries_.erase(it);
+    cond_.notify_one();
+    return true;
+  }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopped_) return;
+      stopped_ = true;
+      cond_.notify_one();
+    }
+    wait();
+
+    // the thread is finished, so its tasks can be deleted here
+    for (auto& [id, entry] : entries_) delete entry.task;
+    for (auto* task : cancelled_tasks_) delete task;
+    entries_.clear();
+    cancelled_tasks_.clear();
+  }
+
+ protected:
+  void run() override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_) {
+      delete_cancelled_tasks_locked();
+
+      // nothing to wait for, sleep until something is scheduled
+      if (entries_.empty()) {
+        cond_.wait(lock, [this]() {
+          return stopped_ || !entries_.empty() || !cancelled_tasks_.empty();
+        });
+        continue;
+      }
+
+      const auto next_tick = epoch_ + kTickDuration * (current_tick_ + 1);
+      if (Clock::now() < next_tick) {
+        cond_.wait_until(lock, next_tick);
+        continue;
+      }
+
+      QContainer<Task*> due_tasks;
+      while (current_tick_ < now_tick()) {
+        current_tick_++;
+        collect_due_tasks_locked(due_tasks);
+      }
+
+      lock.unlock();
+      for (auto* task : due_tasks) poster_(task);
+      lock.lock();
+    }
+  }
+
+ private:
+  struct Entry {
+    Task* task = nullptr;         ///< one-shot task
+    QString name;                 ///< name of the periodic tasks
+    Task::TaskRunnable runnable;  ///< runnable of the periodic tasks
+    qint64 interval_ticks = 0;    ///< 0 for one-shot tasks
+    qint64 rounds = 0;            ///< full turns of the wheel left
+  };
+
+  TaskPoster poster_;
+  const Clock::time_point epoch_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<QContainer<TaskScheduleID>> wheel_;
+  std::unordered_map<TaskScheduleID, Entry> entries_;
+  QContainer<Task*> cancelled_tasks_;
+  qint64 current_tick_ = 0;
+  TaskScheduleID next_id_ = 1;
+  bool stopped_ = false;
+
+  static auto to_ticks(std::chrono::milliseconds duration) -> qint64 {
+    const auto tick_ms = kTickDuration.count();
+    return std::max<qint64>(1, (duration.count() + tick_ms - 1) / tick_ms);
+  }
+
+  [[nodiscard]] auto now_tick() const -> qint64 {
+    return (Clock::now() - epoch_) / kTickDuration;
+  }
+
+  auto insert(Entry entry, std::chrono::milliseconds delay) -> TaskScheduleID {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      delete entry.task;
+      return -1;
+    }
+
+    // the wheel doesn't turn while empty, catch up before inserting
+    if (entries_.empty()) current_tick_ = std::max(current_tick_, now_tick());
+
+    // the wheel may lag behind a little while posting due tasks, and the
+    // current tick has partly passed, so never fire before the delay
+    const auto id = next_id_++;
+    const auto ticks = to_ticks(delay) + 1 +
+                       std::max<qint64>(0, now_tick() - current_tick_);
+    entries_.emplace(id, std::move(entry));
+    place_locked(id, ticks);
+
+    cond_.notify_one();
+    return id;
+  }
+
+  void place_locked(TaskScheduleID id, qint64 ticks) {
+    const auto target_tick = current_tick_ + ticks;
+    entries_[id].rounds = (ticks - 1) / kWheelSize;
+    wheel_[target_tick % kWheelSize].push_back(id);
+  }
+
+  void collect_due_tasks_locked(QContainer<Task*>& due_tasks) {
+    auto slot = std::move(wheel_[current_tick_ % kWheelSize]);
+    wheel_[current_tick_ % kWheelSize].clear();
+
+    for (const auto id : slot) {
+      // cancelled
+      auto it = entries_.find(id);
+      if (it == entries_.end()) continue;
+
+      auto& entry = it->second;
+      if (entry.rounds > 0) {
+        entry.rounds--;
+        wheel_[current_tick_ % kWheelSize].push_back(id);
+        continue;
+      }
+
+      if (entry.interval_ticks > 0) {
+        due_tasks.push_back(new Task(entry.runnable, entry.name));
+        place_locked(id, entry.interval_ticks);
+        continue;
+      }
+
+      due_tasks.push_back(entry.task);
+      entries_.erase(it);
+    }
+  }
+
+  void delete_cancelled_tasks_locked() {
+    for (auto* task : cancelled_tasks_) delete task;
+    cancelled_tasks_.clear();
+  }
+};
+
+TaskScheduler::TaskScheduler(TaskPoster poster)
+    : p_(SecureCreateUniqueObject<Impl>(std::move(poster))) {}
+
+TaskScheduler::~TaskScheduler() = default;
+
+auto TaskScheduler::Schedule(Task* task, std::chrono::milliseconds delay)
+    -> TaskScheduleID {
+  return p_->Schedule(task, delay);
+}
+
+auto TaskScheduler::SchedulePeriodic(const QString& name,
+                                     const Task::TaskRunnable& runnable,
+                                     std::chrono::milliseconds interval,
+                                     std::chrono::milliseconds delay)
+    -> TaskScheduleID {
+  return p_->SchedulePeriodic(name, runnable, interval, delay);
+}
+
+auto TaskScheduler::Cancel(TaskScheduleID id) -> bool {
+  return p_->Cancel(id);
+}
+
+void TaskScheduler::Stop() { p_->Stop(); }
+
+}  // namespace GpgFrontend::Thread
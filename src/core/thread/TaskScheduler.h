@@ -0,0 +1,109 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "core/GpgFrontendCore.h"
+#include "core/function/SecureMemoryAllocator.h"
+#include "core/thread/Task.h"
+
+namespace GpgFrontend::Thread {
+
+using TaskScheduleID = qint64;
+
+/**
+ * @brief A hashed timer wheel driven by a thread of its own. Due tasks are
+ * handed over to the poster, which posts them to a task runner. The thread
+ * sleeps until the next tick while anything is scheduled and without any
+ * timeout otherwise.
+ *
+ */
+class GPGFRONTEND_CORE_EXPORT TaskScheduler {
+ public:
+  using TaskPoster = std::function<void(Task*)>;
+
+  /**
+   * @brief Construct a new Task Scheduler object
+   *
+   * @param poster
+   */
+  explicit TaskScheduler(TaskPoster poster);
+
+  /**
+   * @brief Destroy the Task Scheduler object
+   *
+   */
+  ~TaskScheduler();
+
+  /**
+   * @brief run the task once after the delay. The task must belong to the
+   * calling thread, the scheduler takes its ownership.
+   *
+   * @param task
+   * @param delay
+   * @return TaskScheduleID
+   */
+  auto Schedule(Task* task, std::chrono::milliseconds delay) -> TaskScheduleID;
+
+  /**
+   * @brief run a new task of the runnable every interval, starting after the
+   * delay, until it is cancelled. Runs may overlap if a run takes longer
+   * than the interval.
+   *
+   * @param name
+   * @param runnable
+   * @param interval
+   * @param delay
+   * @return TaskScheduleID
+   */
+  auto SchedulePeriodic(const QString& name, const Task::TaskRunnable& runnable,
+                        std::chrono::milliseconds interval,
+                        std::chrono::milliseconds delay) -> TaskScheduleID;
+
+  /**
+   * @brief cancel a scheduled task which isn't due yet
+   *
+   * @param id
+   * @return true if the task was still scheduled
+   */
+  auto Cancel(TaskScheduleID id) -> bool;
+
+  /**
+   * @brief stop the thread, tasks still scheduled are dropped
+   *
+   */
+  void Stop();
+
+ private:
+  class Impl;
+  SecureUniquePtr<Impl> p_;
+};
+
+}  // namespace GpgFrontend::Thread
@@ -0,0 +1,227 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "core/thread/TaskTracer.h"
+
+#include <chrono>
+#include <mutex>
+
+namespace GpgFrontend::Thread {
+
+namespace {
+
+// about 200 bytes each, the rest is counted but dropped
+constexpr size_t kMaxTraceEvents = 1000000;
+
+struct TraceEvent {
+  char phase;  ///< X: complete, b/e: async begin/end, M: metadata
+  QString name;
+  const char* category;
+  qint64 ts_us;
+  qint64 dur_us;
+  int tid;
+  QString id;
+  QJsonObject args;
+};
+
+}  // namespace
+
+class TaskTracer::Impl {
+ public:
+  void Start(const QString& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    path_ = path;
+    start_ = std::chrono::steady_clock::now();
+    events_.clear();
+    dropped_ = 0;
+    enabled_.store(true, std::memory_order_release);
+
+    LOG_I() << "task tracing started, trace file:" << path;
+  }
+
+  [[nodiscard]] auto IsEnabled() const -> bool {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto NowUs() const -> qint64 {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start_)
+        .count();
+  }
+
+  void Add(TraceEvent event) {
+    if (!IsEnabled()) return;
+    event.tid = current_tid();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (events_.size() >= kMaxTraceEvents) {
+      dropped_++;
+      return;
+    }
+    events_.push_back(std::move(event));
+  }
+
+  auto Flush() -> bool {
+    if (!enabled_.exchange(false)) return false;
+
+    std::vector<TraceEvent> events;
+    qint64 dropped;
+    QString path;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      events.swap(events_);
+      dropped = dropped_;
+      path = path_;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      LOG_W() << "cannot open trace file:" << path;
+      return false;
+    }
+
+    QJsonObject other_data;
+    other_data["dropped_events"] = dropped;
+
+    // streamed event by event, a trace may hold a lot of them
+    file.write("{\"displayTimeUnit\":\"ms\",\"otherData\":");
+    file.write(QJsonDocument(other_data).toJson(QJsonDocument::Compact));
+    file.write(",\"traceEvents\":[\n");
+
+    const auto pid = QCoreApplication::applicationPid();
+    for (size_t i = 0; i < events.size(); i++) {
+      const auto& event = events[i];
+
+      QJsonObject object;
+      object["ph"] = QString(QChar(event.phase));
+      object["name"] = event.name;
+      object["pid"] = pid;
+      object["tid"] = event.tid;
+      if (event.category != nullptr) object["cat"] = event.category;
+      if (event.phase != 'M') object["ts"] = event.ts_us;
+      if (event.phase == 'X') object["dur"] = event.dur_us;
+      if (!event.id.isEmpty()) object["id"] = event.id;
+      if (!event.args.isEmpty()) object["args"] = event.args;
+
+      file.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+      file.write(i + 1 < events.size() ? ",\n" : "\n");
+    }
+    file.write("]}\n");
+
+    LOG_I() << "task trace written, events:" << events.size()
+            << "dropped:" << dropped << "file:" << path;
+    return file.error() == QFileDevice::NoError;
+  }
+
+ private:
+  std::atomic_bool enabled_ = false;
+  std::mutex mutex_;
+  QString path_;
+  std::chrono::steady_clock::time_point start_;
+  std::vector<TraceEvent> events_;
+  qint64 dropped_ = 0;
+  std::atomic_int next_tid_ = 0;
+
+  /**
+   * @brief a small id for the current thread, the name of it is recorded the
+   * first time.
+   *
+   * @return int
+   */
+  auto current_tid() -> int {
+    thread_local int tid = 0;
+    if (tid != 0) return tid;
+
+    tid = ++next_tid_;
+
+    auto* thread = QThread::currentThread();
+    auto name = thread->objectName();
+    if (QCoreApplication::instance() != nullptr &&
+        thread == QCoreApplication::instance()->thread()) {
+      name = "main";
+    }
+    if (name.isEmpty()) name = QString("thread %1").arg(tid);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(
+        {'M', "thread_name", nullptr, 0, 0, tid, {}, {{"name", name}}});
+    return tid;
+  }
+};
+
+auto TaskTracer::GetInstance() -> TaskTracer& {
+  static TaskTracer instance;
+  return instance;
+}
+
+TaskTracer::TaskTracer() : p_(std::make_unique<Impl>()) {}
+
+TaskTracer::~TaskTracer() = default;
+
+void TaskTracer::Start(const QString& path) { p_->Start(path); }
+
+auto TaskTracer::IsEnabled() const -> bool { return p_->IsEnabled(); }
+
+auto TaskTracer::NowUs() const -> qint64 { return p_->NowUs(); }
+
+void TaskTracer::AddComplete(const QString& name, const char* category,
+                             qint64 begin_us, qint64 end_us,
+                             const QJsonObject& args) {
+  p_->Add({'X', name, category, begin_us, end_us - begin_us, 0, {}, args});
+}
+
+void TaskTracer::AddAsyncBegin(const QString& name, const char* category,
+                               const QString& id, qint64 ts_us,
+                               const QJsonObject& args) {
+  p_->Add({'b', name, category, ts_us, 0, 0, id, args});
+}
+
+void TaskTracer::AddAsyncEnd(const QString& name, const char* category,
+                             const QString& id, qint64 ts_us) {
+  p_->Add({'e', name, category, ts_us, 0, 0, id, {}});
+}
+
+auto TaskTracer::Flush() -> bool { return p_->Flush(); }
+
+TraceSpan::TraceSpan(const QString& name, const char* category)
+    : category_(category) {
+  auto& tracer = TaskTracer::GetInstance();
+  if (!tracer.IsEnabled()) return;
+
+  name_ = name;
+  begin_us_ = tracer.NowUs();
+}
+
+TraceSpan::~TraceSpan() {
+  if (begin_us_ < 0) return;
+
+  auto& tracer = TaskTracer::GetInstance();
+  tracer.AddComplete(name_, category_, begin_us_, tracer.NowUs());
+}
+
+}  // namespace GpgFrontend::Thread
@@ -0,0 +1,133 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include "core/GpgFrontendCore.h"
+
+namespace GpgFrontend::Thread {
+
+/**
+ * @brief records the lifecycle of the tasks and the spans inside them, and
+ * writes them as a chrome trace event file, which can be opened by
+ * chrome://tracing or ui.perfetto.dev.
+ *
+ * Recording is off unless Start() is called, then every record is a single
+ * atomic load.
+ */
+class GPGFRONTEND_CORE_EXPORT TaskTracer {
+ public:
+  /**
+   * @brief Get the Instance object
+   *
+   * @return TaskTracer&
+   */
+  static auto GetInstance() -> TaskTracer&;
+
+  /**
+   * @brief start recording, the events are written to path by Flush()
+   *
+   * @param path
+   */
+  void Start(const QString& path);
+
+  /**
+   * @brief
+   *
+   * @return true if recording
+   */
+  [[nodiscard]] auto IsEnabled() const -> bool;
+
+  /**
+   * @brief microseconds since the recording started
+   *
+   * @return qint64
+   */
+  [[nodiscard]] auto NowUs() const -> qint64;
+
+  /**
+   * @brief a span on the timeline of the current thread
+   *
+   */
+  void AddComplete(const QString& name, const char* category,
+                   qint64 begin_us, qint64 end_us,
+                   const QJsonObject& args = {});
+
+  /**
+   * @brief begin an async span, which may end at another thread. the spans
+   * with the same id and category are nested.
+   *
+   */
+  void AddAsyncBegin(const QString& name, const char* category,
+                     const QString& id, qint64 ts_us,
+                     const QJsonObject& args = {});
+
+  /**
+   * @brief end an async span begun by AddAsyncBegin()
+   *
+   */
+  void AddAsyncEnd(const QString& name, const char* category,
+                   const QString& id, qint64 ts_us);
+
+  /**
+   * @brief stop recording and write all events to the file
+   *
+   * @return true if the file was written
+   */
+  auto Flush() -> bool;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> p_;
+
+  TaskTracer();
+
+  ~TaskTracer();
+};
+
+/**
+ * @brief records a span from its construction to its destruction
+ *
+ */
+class GPGFRONTEND_CORE_EXPORT TraceSpan {
+ public:
+  TraceSpan(const QString& name, const char* category);
+
+  ~TraceSpan();
+
+  TraceSpan(const TraceSpan&) = delete;
+
+  auto operator=(const TraceSpan&) -> TraceSpan& = delete;
+
+ private:
+  QString name_;
+  const char* category_;
+  qint64 begin_us_ = -1;
+};
+
+}  // namespace GpgFrontend::Thread
@@ -31,21 +31,52 @@
 #include "core/module/ModuleManager.h"
 #include "core/thread/Task.h"
 #include "core/thread/TaskRunnerGetter.h"
+#include "core/thread/TaskTracer.h"
 #include "core/utils/CommonUtils.h"
 #include "model/DataObject.h"
 
 namespace GpgFrontend {
 
+namespace {
+
+struct GnuPGVersion {
+  QString text;
+  QContainer<int> parts;
+};
+
+/**
+ * @brief check the version of gnupg against the minimal version of an
+ * operation, the running version is parsed once per publish. an unknown
+ * version is taken as supported.
+ *
+ */
+auto IsGnuPGVersionSupported(const QString& operation,
+                             const QString& minial_version) -> bool {
+  static Module::RTHandle<QString, GnuPGVersion> gnupg_version(
+      "core", "gpgme.ctx.gnupg_version", QString{},
+      [](const QString& v) -> GnuPGVersion {
+        return {v, GFParseSoftwareVersion(v)};
+      });
+
+  const auto version = gnupg_version.Get();
+  if (version.text.isEmpty()) return true;
+
+  if (GFCompareSoftwareVersion(version.parts,
+                               GFParseSoftwareVersion(minial_version)) < 0) {
+    LOG_W() << "operation" << operation
+            << " not support for gnupg version: " << version.text;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 auto RunGpgOperaAsync(const GpgOperaRunnable& runnable,
                       const GpgOperationCallback& callback,
                       const QString& operation, const QString& minial_version)
     -> Thread::Task::TaskHandler {
-  const auto gnupg_version = Module::RetrieveRTValueTypedOrDefault<>(
-      "core", "gpgme.ctx.gnupg_version", minial_version);
-
-  if (GFCompareSoftwareVersion(gnupg_version, minial_version) < 0) {
-    LOG_W() << "operation" << operation
-            << " not support for gnupg version: " << gnupg_version;
+  if (!IsGnuPGVersionSupported(operation, minial_version)) {
     callback(GPG_ERR_NOT_SUPPORTED, TransferParams());
     return Thread::Task::TaskHandler(nullptr);
   }
@@ -57,7 +88,11 @@ auto RunGpgOperaAsync(const GpgOperaRunnable& runnable,
               operation,
               [=](const DataObjectPtr& data_object) -> int {
                 auto custom_data_object = TransferParams();
-                auto err = runnable(custom_data_object);
+                GpgError err;
+                {
+                  Thread::TraceSpan span(operation, "gpg");
+                  err = runnable(custom_data_object);
+                }
                 data_object->Swap({err, custom_data_object});
                 return 0;
               },
@@ -78,16 +113,13 @@ auto RunGpgOperaAsync(const GpgOperaRunnable& runnable,
 auto RunGpgOperaSync(const GpgOperaRunnable& runnable, const QString& operation,
                      const QString& minial_version)
     -> std::tuple<GpgError, DataObjectPtr> {
-  const auto gnupg_version = Module::RetrieveRTValueTypedOrDefault<>(
-      "core", "gpgme.ctx.gnupg_version", minial_version);
-
-  if (GFCompareSoftwareVersion(gnupg_version, minial_version) < 0) {
-    LOG_W() << "operation" << operation
-            << " not support for gnupg version: " << gnupg_version;
+  if (!IsGnuPGVersionSupported(operation, minial_version)) {
     return {GPG_ERR_NOT_SUPPORTED, TransferParams()};
   }
 
   auto data_object = TransferParams();
+
+  Thread::TraceSpan span(operation, "gpg");
   auto err = runnable(data_object);
   return {err, data_object};
 }
@@ -102,7 +134,11 @@ auto RunIOOperaAsync(const OperaRunnable& runnable,
               operation,
               [=](const DataObjectPtr& data_object) -> int {
                 auto custom_data_object = TransferParams();
-                GpgError err = runnable(custom_data_object);
+                GpgError err;
+                {
+                  Thread::TraceSpan span(operation, "io");
+                  err = runnable(custom_data_object);
+                }
 
                 data_object->Swap({err, custom_data_object});
                 return 0;
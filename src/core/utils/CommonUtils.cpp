@@ -46,29 +46,30 @@ auto BeautifyFingerprint(QString fingerprint) -> QString {
 }
 
 auto GFCompareSoftwareVersion(const QString& a, const QString& b) -> int {
-  auto remove_prefix = [](const QString& version) {
-    return version.startsWith('v') ? version.mid(1) : version;
-  };
+  return GFCompareSoftwareVersion(GFParseSoftwareVersion(a),
+                                  GFParseSoftwareVersion(b));
+}
 
-  auto real_version_a = remove_prefix(a);
-  auto real_version_b = remove_prefix(b);
+auto GFParseSoftwareVersion(const QString& version) -> QContainer<int> {
+  auto real_version = version.startsWith('v') ? version.mid(1) : version;
 
-  QStringList split_a = real_version_a.split('.');
-  QStringList split_b = real_version_b.split('.');
+  QContainer<int> rtn;
+  for (const auto& part : real_version.split('.')) rtn.push_back(part.toInt());
+  return rtn;
+}
 
-  const auto min_depth = std::min(split_a.size(), split_b.size());
+auto GFCompareSoftwareVersion(const QContainer<int>& a,
+                              const QContainer<int>& b) -> int {
+  const auto min_depth = std::min(a.size(), b.size());
 
   for (int i = 0; i < min_depth; ++i) {
-    int const num_a = split_a[i].toInt();
-    int const num_b = split_b[i].toInt();
-
-    if (num_a != num_b) {
-      return (num_a > num_b) ? 1 : -1;
+    if (a[i] != b[i]) {
+      return (a[i] > b[i]) ? 1 : -1;
     }
   }
 
-  if (split_a.size() != split_b.size()) {
-    return (split_a.size() > split_b.size()) ? 1 : -1;
+  if (a.size() != b.size()) {
+    return (a.size() > b.size()) ? 1 : -1;
   }
 
   return 0;
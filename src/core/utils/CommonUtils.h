@@ -51,6 +51,24 @@ auto GPGFRONTEND_CORE_EXPORT BeautifyFingerprint(QString fingerprint)
 auto GPGFRONTEND_CORE_EXPORT GFCompareSoftwareVersion(const QString &a,
                                                       const QString &b) -> int;
 
+/**
+ * @brief split a version string like "v2.4.5" into its numeric parts
+ *
+ * @return QContainer<int>
+ */
+auto GPGFRONTEND_CORE_EXPORT GFParseSoftwareVersion(const QString &)
+    -> QContainer<int>;
+
+/**
+ * @brief compare two versions parsed by GFParseSoftwareVersion
+ *
+ * @param a
+ * @param b
+ * @return int
+ */
+auto GPGFRONTEND_CORE_EXPORT GFCompareSoftwareVersion(
+    const QContainer<int> &a, const QContainer<int> &b) -> int;
+
 /**
  * @brief
  *
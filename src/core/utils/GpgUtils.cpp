@@ -28,6 +28,8 @@
 
 #include "GpgUtils.h"
 
+#include <mutex>
+
 #include "core/function/GlobalSettingStation.h"
 #include "core/model/GpgKey.h"
 #include "core/model/KeyDatabaseInfo.h"
@@ -177,22 +179,15 @@ auto SetExtensionOfOutputFileForArchive(const QString& path, GpgOperation opera,
 }
 
 static QContainer<KeyDatabaseInfo> gpg_key_database_info_cache;
+static std::mutex gpg_key_database_info_cache_lock;
 
 auto GPGFRONTEND_CORE_EXPORT GetGpgKeyDatabaseInfos()
     -> QContainer<KeyDatabaseInfo> {
+  std::lock_guard<std::mutex> lock(gpg_key_database_info_cache_lock);
   if (!gpg_key_database_info_cache.empty()) return gpg_key_database_info_cache;
 
+  QContainer<KeyDatabaseInfo> infos;
   auto context_index_list = Module::ListRTChildKeys("core", "gpgme.ctx.list");
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-  gpg_key_database_info_cache.resize(
-      static_cast<qsizetype>(context_index_list.size()));
-#else
-  gpg_key_database_info_cache.reserve(
-      static_cast<qsizetype>(context_index_list.size()));
-  std::fill_n(std::back_inserter(gpg_key_database_info_cache),
-              context_index_list.size(), KeyDatabaseInfo{});
-#endif
-
   for (auto& context_index : context_index_list) {
     LOG_D() << "context grt key: " << context_index;
 
@@ -212,15 +207,26 @@ auto GPGFRONTEND_CORE_EXPORT GetGpgKeyDatabaseInfos()
     i.channel = channel;
     i.name = database_name;
     i.path = database_path;
-    gpg_key_database_info_cache[channel] = i;
+    infos.push_back(i);
   }
 
-  return gpg_key_database_info_cache;
+  // key databases load concurrently, a failed one leaves its channel unused
+  std::sort(infos.begin(), infos.end(),
+            [](const auto& a, const auto& b) { return a.channel < b.channel; });
+
+  // cache the list only after all the key databases are loaded
+  if (Module::RetrieveRTValueTypedOrDefault<>("core", "env.state.key_dbs", 0) !=
+      0) {
+    gpg_key_database_info_cache = infos;
+  }
+  return infos;
 }
+
 auto GPGFRONTEND_CORE_EXPORT GetGpgKeyDatabaseName(int channel) -> QString {
-  auto info = GetGpgKeyDatabaseInfos();
-  if (channel >= info.size()) return {};
-  return info[channel].name;
+  for (const auto& info : GetGpgKeyDatabaseInfos()) {
+    if (info.channel == channel) return info.name;
+  }
+  return {};
 }
 
 auto GetKeyDatabasesBySettings() -> QContainer<KeyDatabaseItemSO> {
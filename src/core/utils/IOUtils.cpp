@@ -33,18 +33,15 @@
 
 namespace GpgFrontend {
 
-auto GetFileChecksum(const QString& file_name,
-                     QCryptographicHash::Algorithm hashAlgorithm)
-    -> QByteArray {
-  QFile f(file_name);
-  if (f.open(QFile::ReadOnly)) {
-    QCryptographicHash hash(hashAlgorithm);
-    if (hash.addData(&f)) {
-      return hash.result();
-    }
-  }
-  return {};
-}
+namespace {
+
+/**
+ * @brief bytes read from a file at once when calculating its digests
+ *
+ */
+constexpr qint64 kFileDigestChunkSize = 4 * 1024 * 1024;
+
+}  // namespace
 
 auto ReadFile(const QString& file_name, QByteArray& data) -> bool {
   QFile file(file_name);
@@ -79,13 +76,62 @@ auto WriteFileGFBuffer(const QString& file_name, GFBuffer data) -> bool {
   return WriteFile(file_name, data.ConvertToQByteArray());
 }
 
-auto CalculateHash(const QString& file_path) -> QString {
+auto CalculateFileDigests(
+    const QString& file_path,
+    const QContainer<QCryptographicHash::Algorithm>& algorithms,
+    const FileProgressCallback& progress) -> QContainer<QByteArray> {
+  // the chunks go straight from the file into the buffer, which is reused
+  QFile file(file_path);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+    LOG_W() << "failed to open file: " << file_path;
+    return {};
+  }
+
+  std::vector<std::unique_ptr<QCryptographicHash>> hashes;
+  for (const auto& algorithm : algorithms) {
+    hashes.push_back(std::make_unique<QCryptographicHash>(algorithm));
+  }
+
+  const auto file_size = file.size();
+  QByteArray buffer(static_cast<int>(kFileDigestChunkSize), Qt::Uninitialized);
+
+  qint64 read_bytes = 0;
+  qint64 chunk_size = 0;
+  while ((chunk_size = file.read(buffer.data(), buffer.size())) > 0) {
+    const auto chunk = QByteArray::fromRawData(buffer.constData(),
+                                               static_cast<int>(chunk_size));
+    for (auto& hash : hashes) hash->addData(chunk);
+
+    read_bytes += chunk_size;
+    if (progress) progress(read_bytes, file_size);
+  }
+
+  if (chunk_size < 0) {
+    LOG_W() << "failed to read file: " << file_path;
+    return {};
+  }
+
+  QContainer<QByteArray> digests;
+  for (auto& hash : hashes) digests.push_back(hash->result());
+  return digests;
+}
+
+auto CalculateHash(const QString& file_path,
+                   const FileProgressCallback& progress) -> QString {
   // Returns empty QByteArray() on failure.
   QFileInfo const info(file_path);
   QString buffer;
   QTextStream ss(&buffer);
 
-  if (info.isFile() && info.isReadable()) {
+  auto digests = info.isFile() && info.isReadable()
+                     ? CalculateFileDigests(file_path,
+                                            {QCryptographicHash::Md5,
+                                             QCryptographicHash::Sha1,
+                                             QCryptographicHash::Sha256},
+                                            progress)
+                     : QContainer<QByteArray>{};
+
+  if (digests.size() == 3) {
     ss << "# " << QCoreApplication::tr("File Hash Information") << Qt::endl;
     ss << "- " << QCoreApplication::tr("Filename") << QCoreApplication::tr(": ")
        << info.fileName() << Qt::endl;
@@ -100,19 +146,16 @@ auto CalculateHash(const QString& file_path) -> QString {
        << Qt::endl;
 
     // md5
-    ss << "- " << "MD5" << QCoreApplication::tr(": ")
-       << GetFileChecksum(file_path, QCryptographicHash::Md5).toHex()
+    ss << "- " << "MD5" << QCoreApplication::tr(": ") << digests[0].toHex()
        << Qt::endl;
 
     // sha1
-    ss << "- " << "SHA1" << QCoreApplication::tr(": ")
-       << GetFileChecksum(file_path, QCryptographicHash::Sha1).toHex()
+    ss << "- " << "SHA1" << QCoreApplication::tr(": ") << digests[1].toHex()
        << Qt::endl;
 
-    // sha1
+    // sha256
     ss << "- " << "SHA256" << QCoreApplication::tr(": ")
-       << GetFileChecksum(file_path, QCryptographicHash::Sha256).toHex()
-       << Qt::endl;
+       << digests[2].toHex() << Qt::endl;
 
     ss << Qt::endl;
 
@@ -186,33 +229,12 @@ auto CalculateBinaryChacksum(const QString& path) -> QString {
     return {};
   }
 
-  // open and read file
-  QFile f(info.filePath());
-  if (!f.open(QIODevice::ReadOnly)) {
-    LOG_W() << "open " << path
-            << "to calculate checksum error: " << f.errorString();
-    return {};
-  }
-
-  QCryptographicHash hash_sha(QCryptographicHash::Sha256);
-
-  // read data by chunks
-  const qint64 buffer_size = 8192;  // Define a suitable buffer size
-  while (!f.atEnd()) {
-    QByteArray const buffer = f.read(buffer_size);
-    if (buffer.isEmpty()) {
-      LOG_W() << "error reading file: " << path
-              << " during checksum calculation";
-      return {};
-    }
-    hash_sha.addData(buffer);
-  }
-
-  // close the file
-  f.close();
+  const auto digests =
+      CalculateFileDigests(info.filePath(), {QCryptographicHash::Sha256});
+  if (digests.isEmpty()) return {};
 
   // return the SHA-256 hash of the file
-  return hash_sha.result().toHex();
+  return digests.front().toHex();
 }
 
 }  // namespace GpgFrontend
\ No newline at end of file
@@ -74,12 +74,35 @@ auto GPGFRONTEND_CORE_EXPORT ReadFile(const QString &file_name,
 auto GPGFRONTEND_CORE_EXPORT WriteFile(const QString &file_name,
                                        const QByteArray &data) -> bool;
 
+/**
+ * @brief progress of reading a file, the bytes read and the file size
+ *
+ */
+using FileProgressCallback = std::function<void(qint64, qint64)>;
+
+/**
+ * @brief read the file once and feed all the digests from the same buffer
+ *
+ * @param file_path
+ * @param algorithms
+ * @param progress
+ * @return QContainer<QByteArray> digests in the order of the algorithms,
+ * empty if the file cannot be read
+ */
+auto GPGFRONTEND_CORE_EXPORT CalculateFileDigests(
+    const QString &file_path,
+    const QContainer<QCryptographicHash::Algorithm> &algorithms,
+    const FileProgressCallback &progress = {}) -> QContainer<QByteArray>;
+
 /**
  * calculate the hash of a file
  * @param file_path
+ * @param progress
  * @return
  */
-auto GPGFRONTEND_CORE_EXPORT CalculateHash(const QString &file_path) -> QString;
+auto GPGFRONTEND_CORE_EXPORT CalculateHash(
+    const QString &file_path, const FileProgressCallback &progress = {})
+    -> QString;
 
 /**
  * @brief
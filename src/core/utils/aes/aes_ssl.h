@@ -68,4 +68,43 @@ uint8_t *aes_256_cbc_encrypt(EVP_CIPHER_CTX *e, uint8_t *plaintext, int *len);
  */
 uint8_t *aes_256_cbc_decrypt(EVP_CIPHER_CTX *e, uint8_t *ciphertext, int *len);
 
+/**
+ * @brief Encrypt len bytes of plaintext with AES-256-GCM, the ciphertext has
+ * the same length as the plaintext
+ *
+ * @param key 32 bytes
+ * @param iv
+ * @param iv_len
+ * @param aad data authenticated along, may be null
+ * @param aad_len
+ * @param plaintext
+ * @param len
+ * @param ciphertext
+ * @param tag 16 bytes
+ * @return int 0 on success
+ */
+int aes_256_gcm_encrypt(const uint8_t *key, const uint8_t *iv, int iv_len,
+                        const uint8_t *aad, int aad_len,
+                        const uint8_t *plaintext, int len, uint8_t *ciphertext,
+                        uint8_t *tag);
+
+/**
+ * @brief Decrypt len bytes of ciphertext with AES-256-GCM
+ *
+ * @param key 32 bytes
+ * @param iv
+ * @param iv_len
+ * @param aad data authenticated along, may be null
+ * @param aad_len
+ * @param ciphertext
+ * @param len
+ * @param plaintext
+ * @param tag 16 bytes
+ * @return int 0 on success, -1 if the data or the tag don't authenticate
+ */
+int aes_256_gcm_decrypt(const uint8_t *key, const uint8_t *iv, int iv_len,
+                        const uint8_t *aad, int aad_len,
+                        const uint8_t *ciphertext, int len, uint8_t *plaintext,
+                        const uint8_t *tag);
+
 }  // namespace GpgFrontend::RawAPI
@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <memory>
+
+#include "aes_ssl.h"
+
+namespace GpgFrontend::RawAPI {
+
+namespace {
+
+using CipherCtxPtr =
+    std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+constexpr int kGcmTagSize = 16;
+
+}  // namespace
+
+int aes_256_gcm_encrypt(const uint8_t *key, const uint8_t *iv, int iv_len,
+                        const uint8_t *aad, int aad_len,
+                        const uint8_t *plaintext, int len, uint8_t *ciphertext,
+                        uint8_t *tag) {
+  CipherCtxPtr ctx(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
+  if (ctx == nullptr) return -1;
+
+  int out_len = 0;
+  int final_len = 0;
+  if (EVP_EncryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, nullptr,
+                         nullptr) != 1 ||
+      EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, iv_len,
+                          nullptr) != 1 ||
+      EVP_EncryptInit_ex(ctx.get(), nullptr, nullptr, key, iv) != 1) {
+    return -1;
+  }
+
+  if (aad != nullptr && aad_len > 0 &&
+      EVP_EncryptUpdate(ctx.get(), nullptr, &out_len, aad, aad_len) != 1) {
+    return -1;
+  }
+
+  if (EVP_EncryptUpdate(ctx.get(), ciphertext, &out_len, plaintext, len) !=
+          1 ||
+      EVP_EncryptFinal_ex(ctx.get(), ciphertext + out_len, &final_len) != 1 ||
+      EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_GET_TAG, kGcmTagSize,
+                          tag) != 1) {
+    return -1;
+  }
+
+  return 0;
+}
+
+int aes_256_gcm_decrypt(const uint8_t *key, const uint8_t *iv, int iv_len,
+                        const uint8_t *aad, int aad_len,
+                        const uint8_t *ciphertext, int len, uint8_t *plaintext,
+                        const uint8_t *tag) {
+  CipherCtxPtr ctx(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
+  if (ctx == nullptr) return -1;
+
+  int out_len = 0;
+  int final_len = 0;
+  if (EVP_DecryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, nullptr,
+                         nullptr) != 1 ||
+      EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, iv_len,
+                          nullptr) != 1 ||
+      EVP_DecryptInit_ex(ctx.get(), nullptr, nullptr, key, iv) != 1) {
+    return -1;
+  }
+
+  if (aad != nullptr && aad_len > 0 &&
+      EVP_DecryptUpdate(ctx.get(), nullptr, &out_len, aad, aad_len) != 1) {
+    return -1;
+  }
+
+  if (EVP_DecryptUpdate(ctx.get(), plaintext, &out_len, ciphertext, len) !=
+          1 ||
+      EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_TAG, kGcmTagSize,
+                          const_cast<uint8_t *>(tag)) != 1) {
+    return -1;
+  }
+
+  // fails if the tag doesn't match
+  if (EVP_DecryptFinal_ex(ctx.get(), plaintext + out_len, &final_len) != 1) {
+    return -1;
+  }
+
+  return 0;
+}
+
+}  // namespace GpgFrontend::RawAPI
@@ -35,6 +35,7 @@
 #include "core/module/ModuleInit.h"
 #include "core/module/ModuleManager.h"
 #include "core/thread/TaskRunnerGetter.h"
+#include "core/thread/TaskTracer.h"
 #include "ui/GpgFrontendUIInit.h"
 
 // main
@@ -195,6 +196,11 @@ void ShutdownGlobalBasicEnv(const GFCxtWPtr &p_ctx) {
   // then shutdown the core
   GpgFrontend::DestroyGpgFrontendCore();
 
+  // all tasks have ended by now
+  if (Thread::TaskTracer::GetInstance().IsEnabled()) {
+    Thread::TaskTracer::GetInstance().Flush();
+  }
+
   // deep restart mode
   if (ctx->rtn == GpgFrontend::kDeepRestartCode ||
       ctx->rtn == GpgFrontend::kCrashCode) {
@@ -35,6 +35,7 @@
 
 //
 #include "GpgFrontendContext.h"
+#include "core/thread/TaskTracer.h"
 #include "core/utils/MemoryUtils.h"
 
 //
@@ -80,8 +81,19 @@ auto main(int argc, char* argv[]) -> int {
   parser.addOptions({
       {{"v", "version"}, "show version information"},
       {{"t", "test"}, "run all unit test cases"},
+      {{"b", "bench"}, "run all benchmarks, write the json results to path",
+       "path"},
+      {"bench-max-size", "largest benchmark payload in bytes", "bytes"},
+      {"bench-max-keys", "largest synthetic benchmark keyring", "keys"},
+      {"bench-iterations", "measured runs of each benchmark", "runs"},
+      {"bench-digest-size", "size of the file hashed by the digest benchmark",
+       "bytes"},
+      {"bench-gpg-data-size", "largest file of the gpg data mode benchmark",
+       "bytes"},
       {{"e", "environment"}, "show environment information"},
       {{"l", "log-level"}, "set log level (debug, info, warn, error)", "none"},
+      {"trace", "record the tasks and write a chrome trace file to path",
+       "path"},
   });
 
   parser.process(*ctx->GetApp());
@@ -98,6 +110,11 @@ auto main(int argc, char* argv[]) -> int {
     return GpgFrontend::PrintEnvInfo();
   }
 
+  if (parser.isSet("trace")) {
+    GpgFrontend::Thread::TaskTracer::GetInstance().Start(
+        parser.value("trace"));
+  }
+
   if (parser.isSet("t")) {
     ctx->gather_external_gnupg_info = false;
     ctx->unit_test_mode = true;
@@ -108,6 +125,16 @@ auto main(int argc, char* argv[]) -> int {
     return rtn;
   }
 
+  if (parser.isSet("b")) {
+    ctx->gather_external_gnupg_info = false;
+    ctx->unit_test_mode = true;
+
+    InitGlobalBasicEnvSync(ctx);
+    rtn = RunBench(ctx, parser);
+    ShutdownGlobalBasicEnv(ctx);
+    return rtn;
+  }
+
   ctx->gather_external_gnupg_info = true;
   ctx->unit_test_mode = false;
 
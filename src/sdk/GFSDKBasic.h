@@ -143,7 +143,8 @@ auto GPGFRONTEND_MODULE_SDK_EXPORT GFAppRegisterTranslatorReader(
     const char* id, GFTranslatorDataReader reader) -> int;
 
 /**
- * @brief
+ * @brief save the value to the runtime cache of the application, which is
+ * thread safe and may evict it when it is over its byte budget
  *
  * @param key
  * @param value
@@ -153,10 +154,12 @@ auto GPGFRONTEND_MODULE_SDK_EXPORT GFCacheSave(const char* key,
                                                const char* value) -> int;
 
 /**
- * @brief
+ * @brief save the value to the runtime cache of the application, it expires
+ * after ttl seconds
  *
  * @param key
  * @param value
+ * @param ttl
  * @return auto
  */
 auto GPGFRONTEND_MODULE_SDK_EXPORT GFCacheSaveWithTTL(const char* key,
@@ -164,10 +167,10 @@ auto GPGFRONTEND_MODULE_SDK_EXPORT GFCacheSaveWithTTL(const char* key,
                                                       int ttl) -> int;
 
 /**
- * @brief
+ * @brief get the value from the runtime cache of the application
  *
  * @param key
- * @return const char*
+ * @return const char* empty if it is missing, evicted or expired
  */
 auto GPGFRONTEND_MODULE_SDK_EXPORT GFCacheGet(const char* key) -> const char*;
 
@@ -94,7 +94,7 @@ auto GPGFRONTEND_MODULE_SDK_EXPORT GFGpgSignData(int channel, char** key_ids,
   auto capsule_id =
       GpgFrontend::UI::UIModuleManager::GetInstance().MakeCapsule(result);
 
-  s->signature = GFStrDup(out_buffer.ConvertToQByteArray());
+  s->signature = GFStrDup(out_buffer.ConvertToQString());
   s->hash_algo = GFStrDup(result.HashAlgo());
   s->capsule_id = GFStrDup(capsule_id);
   s->error_string = GFStrDup(GpgFrontend::DescribeGpgErrCode(err).second);
@@ -114,7 +114,7 @@ auto GPGFRONTEND_MODULE_SDK_EXPORT GFGpgPublicKey(int channel, char* key_id,
 
   if (GpgFrontend::CheckGpgError(err) != GPG_ERR_NO_ERROR) return nullptr;
 
-  return GFStrDup(buffer.ConvertToQByteArray());
+  return GFStrDup(buffer.ConvertToQString());
 }
 
 auto GPGFRONTEND_MODULE_SDK_EXPORT GFGpgKeyPrimaryUID(int channel, char* key_id,
@@ -179,7 +179,7 @@ GFGpgEncryptData(int channel, char** key_ids, int key_ids_size, char* data,
   auto capsule_id =
       GpgFrontend::UI::UIModuleManager::GetInstance().MakeCapsule(result);
 
-  s->encrypted_data = GFStrDup(out_buffer.ConvertToQByteArray());
+  s->encrypted_data = GFStrDup(out_buffer.ConvertToQString());
   s->capsule_id = GFStrDup(capsule_id);
   s->error_string = GFStrDup(GpgFrontend::DescribeGpgErrCode(err).second);
   return 0;
@@ -216,7 +216,7 @@ GFGpgDecryptData(int channel, char* data, GFGpgDecryptResult** ps) -> int {
   auto capsule_id =
       GpgFrontend::UI::UIModuleManager::GetInstance().MakeCapsule(result);
 
-  s->decrypted_data = GFStrDup(out_buffer.ConvertToQByteArray());
+  s->decrypted_data = GFStrDup(out_buffer.ConvertToQString());
   s->capsule_id = GFStrDup(capsule_id);
   s->error_string = GFStrDup(GpgFrontend::DescribeGpgErrCode(err).second);
   return 0;
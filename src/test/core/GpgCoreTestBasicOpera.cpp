@@ -26,11 +26,15 @@
  *
  */
 
+#include <thread>
+
 #include "GpgCoreTest.h"
 #include "core/GpgModel.h"
 #include "core/function/gpg/GpgBasicOperator.h"
 #include "core/function/gpg/GpgKeyGetter.h"
 #include "core/function/result_analyse/GpgDecryptResultAnalyse.h"
+#include "core/model/GFDataExchanger.h"
+#include "core/model/GpgData.h"
 #include "core/model/GpgDecryptResult.h"
 #include "core/model/GpgEncryptResult.h"
 #include "core/model/GpgSignResult.h"
@@ -71,6 +75,58 @@ TEST_F(GpgCoreTest, CoreEncryptDecrTest) {
   ASSERT_EQ(decr_out_buffer, buffer);
 }
 
+TEST_F(GpgCoreTest, CoreEncryptDecrStreamTest) {
+  auto encrypt_key = GpgKeyGetter::GetInstance().GetPubkey(
+      "E87C6A2D8D95C818DE93B3AE6A2764F8298DEB29");
+  ASSERT_TRUE(encrypt_key.IsGood());
+
+  const auto plain = QByteArray("Hello GpgFrontend!").repeated(256 * 1024);
+
+  // the producer is pipelined with gpgme through a small exchanger
+  auto in_ex = QSharedPointer<GFDataExchanger>::create(64 * 1024);
+  std::thread producer([=]() {
+    for (qsizetype offset = 0; offset < plain.size(); offset += 4096) {
+      const auto size = std::min<qsizetype>(4096, plain.size() - offset);
+      in_ex->Write(reinterpret_cast<const std::byte*>(plain.constData()) +
+                       offset,
+                   size);
+    }
+    in_ex->CloseWrite();
+  });
+
+  QBuffer cipher;
+  cipher.open(QIODevice::WriteOnly);
+  auto [err, data_object] = GpgBasicOperator::GetInstance().EncryptSync(
+      {encrypt_key}, in_ex, &cipher, false);
+  producer.join();
+
+  ASSERT_EQ(CheckGpgError(err), GPG_ERR_NO_ERROR);
+  ASSERT_TRUE((data_object->Check<GpgEncryptResult>()));
+  ASSERT_GT(cipher.size(), 0);
+  cipher.close();
+
+  auto out_ex = QSharedPointer<GFDataExchanger>::create(64 * 1024);
+  QByteArray decrypted;
+  std::thread consumer([&]() {
+    std::array<std::byte, 4096> chunk;
+    ssize_t len;
+    while ((len = out_ex->Read(chunk.data(), chunk.size())) > 0) {
+      decrypted.append(reinterpret_cast<const char*>(chunk.data()), len);
+    }
+  });
+
+  cipher.open(QIODevice::ReadOnly);
+  auto [err_0, data_object_0] =
+      GpgBasicOperator::GetInstance().DecryptSync(&cipher, out_ex);
+  consumer.join();
+
+  ASSERT_EQ(CheckGpgError(err_0), GPG_ERR_NO_ERROR);
+  ASSERT_TRUE((data_object_0->Check<GpgDecryptResult>()));
+  auto decr_result = ExtractParams<GpgDecryptResult>(data_object_0, 0);
+  ASSERT_FALSE(decr_result.Recipients().empty());
+  ASSERT_EQ(decrypted, plain);
+}
+
 TEST_F(GpgCoreTest, CoreEncryptSymmetricDecrTest) {
   auto encrypt_text = GFBuffer(QString("Hello GpgFrontend!"));
   auto [err, data_object] =
@@ -273,4 +329,35 @@ TEST_F(GpgCoreTest, CoreEncryptSignDecrVerifyTest) {
             "8933EB283A18995F45D61DAC021D89771B680FFB");
 }
 
+TEST_F(GpgCoreTest, CoreGpgDataReadBufferTest) {
+  const auto data = QByteArray("Hello GpgFrontend!").repeated(4096);
+
+  GpgData data_out;
+  ASSERT_EQ(gpgme_data_write(data_out, data.constData(), data.size()),
+            data.size());
+  auto buffer = data_out.Read2GFBuffer();
+  ASSERT_EQ(buffer.ConvertToQByteArray(), data);
+
+  // the memory is handed over only once
+  ASSERT_EQ(data_out.Read2GFBuffer(), buffer);
+
+  int released = 0;
+  auto* mem = new char[4]{'a', 'b', 'c', 'd'};
+  auto adopted = GFBuffer(mem, 4, [&](char* p) {
+    released++;
+    delete[] p;
+  });
+
+  auto copy = adopted;
+  auto array = adopted.ConvertToQByteArray();
+  copy.Append("e", 1);
+  ASSERT_EQ(copy.ConvertToQString(), QString("abcde"));
+  ASSERT_EQ(released, 0);
+
+  // released with the last buffer referring to it
+  adopted = GFBuffer();
+  ASSERT_EQ(released, 1);
+  ASSERT_EQ(array, QByteArray("abcd"));
+}
+
 }  // namespace GpgFrontend::Test
@@ -32,6 +32,9 @@
 #include "GpgCoreTest.h"
 #include "core/GpgConstants.h"
 #include "core/function/CacheManager.h"
+#include "core/function/DataObjectOperator.h"
+#include "core/model/SettingsObject.h"
+#include "core/utils/IOUtils.h"
 #include "core/utils/GpgUtils.h"
 
 namespace GpgFrontend::Test {
@@ -54,4 +57,184 @@ TEST_F(GpgCoreTest, CoreCacheTestC) {
   ASSERT_EQ(CacheManager::GetInstance().LoadCache("ABCDEF"), QString(""));
 }
 
+TEST_F(GpgCoreTest, CoreRuntimeCacheTestA) {
+  // one shard, room for about two entries
+  RuntimeCache cache(2 * (64 + 8 * 2), 1);
+
+  cache.Insert("key_a", "abc");
+  cache.Insert("key_b", "abc");
+  ASSERT_EQ(cache.Get("key_a").value_or(QString()), QString("abc"));
+
+  // key_b is the least recently used
+  cache.Insert("key_c", "abc");
+  ASSERT_FALSE(cache.Get("key_b").has_value());
+  ASSERT_TRUE(cache.Get("key_a").has_value());
+  ASSERT_TRUE(cache.Get("key_c").has_value());
+
+  auto stats = cache.GetStats();
+  ASSERT_EQ(stats.entries, 2);
+  ASSERT_EQ(stats.evictions, 1);
+  ASSERT_EQ(stats.hits, 3);
+  ASSERT_EQ(stats.misses, 1);
+
+  cache.SetByteBudget(0);
+  ASSERT_EQ(cache.GetStats().entries, 0);
+}
+
+TEST_F(GpgCoreTest, CoreRuntimeCacheTestB) {
+  RuntimeCache cache;
+  cache.Insert("key_a", "abc", 1);
+  cache.Insert("key_b", "abc");
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+
+  // dropped by the wheel without a lookup
+  cache.Expire();
+  auto stats = cache.GetStats();
+  ASSERT_EQ(stats.entries, 1);
+  ASSERT_EQ(stats.expirations, 1);
+  ASSERT_FALSE(cache.Get("key_a").has_value());
+}
+
+TEST_F(GpgCoreTest, CoreRuntimeCacheTestC) {
+  RuntimeCache cache;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&cache, i]() {
+      for (int j = 0; j < 1000; j++) {
+        const auto key = QString("key_%1_%2").arg(i).arg(j % 10);
+        cache.Insert(key, QString::number(j));
+        cache.Get(key);
+        if (j % 7 == 0) cache.Remove(key);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  auto stats = cache.GetStats();
+  ASSERT_LE(stats.entries, 80);
+  ASSERT_EQ(stats.hits + stats.misses, 8000);
+}
+
+TEST_F(GpgCoreTest, CoreCacheTestD) {
+  const auto key = QString("core_cache_test_d");
+  CacheManager::GetInstance().SetDurableCacheJournal(key);
+
+  for (int i = 0; i < 3; i++) {
+    CacheManager::GetInstance().SaveDurableCache(
+        key, QJsonDocument(QJsonArray({i})), true);
+  }
+  ASSERT_EQ(CacheManager::GetInstance().LoadDurableCache(key).array(),
+            QJsonArray({2}));
+
+  ASSERT_TRUE(CacheManager::GetInstance().ResetDurableCache(key));
+  CacheManager::GetInstance().FlushDurableCache();
+  ASSERT_TRUE(CacheManager::GetInstance().LoadDurableCache(key).isNull());
+
+  CacheManager::GetInstance().SetDurableCacheJournal(key, false);
+}
+
+TEST_F(GpgCoreTest, CoreCacheTestE) {
+  const auto key = QString("core_cache_test_e");
+  const auto fallback = QJsonDocument(QJsonArray({0}));
+
+  CacheManager::GetInstance().SaveDurableCache(
+      key, QJsonDocument(QJsonArray({1})), true);
+
+  // the data object is still on disk until the next flush
+  ASSERT_TRUE(CacheManager::GetInstance().ResetDurableCache(key));
+  ASSERT_TRUE(CacheManager::GetInstance().LoadDurableCache(key).isNull());
+  ASSERT_EQ(CacheManager::GetInstance().LoadDurableCache(key, fallback),
+            fallback);
+
+  CacheManager::GetInstance().FlushDurableCache();
+  ASSERT_TRUE(CacheManager::GetInstance().LoadDurableCache(key).isNull());
+
+  CacheManager::GetInstance().SaveDurableCache(
+      key, QJsonDocument(QJsonArray({2})), false);
+  ASSERT_EQ(CacheManager::GetInstance().LoadDurableCache(key).array(),
+            QJsonArray({2}));
+
+  ASSERT_TRUE(CacheManager::GetInstance().ResetDurableCache(key));
+  CacheManager::GetInstance().FlushDurableCache();
+}
+
+TEST_F(GpgCoreTest, CoreDataObjectJournalTest) {
+  const auto key = QString("core_data_object_test_c");
+  DataObjectOperator::GetInstance().RemoveDataObjJournal(key);
+
+  ASSERT_TRUE(DataObjectOperator::GetInstance().AppendDataObjJournal(
+      key, {QJsonDocument(QJsonArray({1}))}));
+  ASSERT_TRUE(DataObjectOperator::GetInstance().AppendDataObjJournal(
+      key, {QJsonDocument(QJsonArray({2})), QJsonDocument(QJsonArray({3}))}));
+
+  auto records = DataObjectOperator::GetInstance().GetDataObjJournal(key);
+  ASSERT_EQ(records.size(), 3);
+  ASSERT_EQ(records.back().array(), QJsonArray({3}));
+
+  ASSERT_TRUE(DataObjectOperator::GetInstance().RemoveDataObjJournal(key));
+  records = DataObjectOperator::GetInstance().GetDataObjJournal(key);
+  ASSERT_TRUE(records.isEmpty());
+}
+
+TEST_F(GpgCoreTest, CoreDataObjectTestA) {
+  QJsonObject object;
+  object["value"] = "GpgFrontend";
+  auto ref =
+      DataObjectOperator::GetInstance().SaveDataObj({}, QJsonDocument(object));
+  ASSERT_EQ(ref.size(), 64);
+
+  auto value = DataObjectOperator::GetInstance().GetDataObjectByRef(ref);
+  ASSERT_TRUE(value.has_value());
+  ASSERT_EQ(value->object()["value"].toString(), QString("GpgFrontend"));
+
+  const auto obj_path = GlobalSettingStation::GetInstance().GetAppDataPath() +
+                        "/data_objs/" + ref;
+  QByteArray data;
+  ASSERT_TRUE(ReadFile(obj_path, data));
+  ASSERT_EQ(DataObjectCipher::GetFormatVersion(data), 1);
+}
+
+TEST_F(GpgCoreTest, CoreDataObjectTestB) {
+  const auto key = QByteArray(32, 'k');
+  AesGcmDataObjectCipher cipher(key);
+
+  auto data = cipher.Encrypt("GpgFrontend", "aad");
+  ASSERT_EQ(cipher.Decrypt(data, "aad").value_or(QByteArray()),
+            QByteArray("GpgFrontend"));
+  ASSERT_FALSE(cipher.Decrypt(data, "other").has_value());
+
+  data[data.size() - 1] = static_cast<char>(data[data.size() - 1] ^ 0x01);
+  ASSERT_FALSE(cipher.Decrypt(data, "aad").has_value());
+
+  LegacyAesEcbDataObjectCipher legacy_cipher(key);
+  auto legacy_data = legacy_cipher.Encrypt("GpgFrontend", {});
+  ASSERT_EQ(DataObjectCipher::GetFormatVersion(legacy_data), 0);
+  ASSERT_EQ(legacy_cipher.Decrypt(legacy_data, {}).value_or(QByteArray()),
+            QByteArray("GpgFrontend"));
+}
+
+TEST_F(GpgCoreTest, CoreSettingsObjectTestA) {
+  const auto name = QString("core_settings_object_test_a");
+  {
+    SettingsObject so(name);
+    ASSERT_FALSE(so.IsModified());
+    so["value"] = 1;
+    ASSERT_TRUE(so.IsModified());
+  }
+
+  // visible before it is written
+  {
+    SettingsObject so(name);
+    ASSERT_EQ(so["value"].toInt(), 1);
+    ASSERT_FALSE(so.IsModified());
+  }
+
+  DataObjectOperator::GetInstance().FlushDataObjs();
+  auto value = DataObjectOperator::GetInstance().GetDataObject(name);
+  ASSERT_TRUE(value.has_value());
+  ASSERT_EQ(value->object()["value"].toInt(), 1);
+}
+
 }  // namespace GpgFrontend::Test
\ No newline at end of file
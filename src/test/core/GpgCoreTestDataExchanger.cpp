@@ -0,0 +1,141 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "GpgCoreTest.h"
+#include "core/model/GFDataExchanger.h"
+
+namespace GpgFrontend::Test {
+
+namespace {
+
+auto PatternByte(size_t offset) -> std::byte {
+  return static_cast<std::byte>((offset * 7) % 251);
+}
+
+/**
+ * @brief pipe total bytes from a writer thread to the calling thread and
+ * verify the content.
+ *
+ * @return double throughput in MiB/s, negative if the data was corrupted
+ */
+template <typename Exchanger>
+auto PipeThrough(Exchanger& ex, size_t total, size_t chunk) -> double {
+  const auto start = std::chrono::steady_clock::now();
+
+  std::thread writer([&] {
+    std::vector<std::byte> buffer(chunk);
+    for (size_t offset = 0; offset < total; offset += chunk) {
+      const auto size = std::min(chunk, total - offset);
+      for (size_t i = 0; i < size; i++) buffer[i] = PatternByte(offset + i);
+      if (ex.Write(buffer.data(), size) != static_cast<ssize_t>(size)) break;
+    }
+    ex.CloseWrite();
+  });
+
+  std::vector<std::byte> buffer(chunk);
+  size_t offset = 0;
+  bool corrupted = false;
+  ssize_t ret;
+  while ((ret = ex.Read(buffer.data(), buffer.size())) > 0) {
+    for (ssize_t i = 0; i < ret; i++) {
+      corrupted |= buffer[i] != PatternByte(offset + i);
+    }
+    offset += ret;
+  }
+  writer.join();
+
+  const auto seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+  if (corrupted || offset != total) return -1;
+  return static_cast<double>(total) / (1024 * 1024) / seconds;
+}
+
+}  // namespace
+
+TEST_F(GpgCoreTest, CoreDataExchangerTestA) {
+  GFDataExchanger ex(4096);
+
+  // chunks larger than the capacity force wrap-around and blocking
+  ASSERT_GT(PipeThrough(ex, 1024 * 1024 + 17, 10000), 0);
+}
+
+TEST_F(GpgCoreTest, CoreDataExchangerTestB) {
+  GFDataExchanger ex(16);
+
+  auto region = ex.ReserveWrite(64);
+  ASSERT_EQ(region.size, 16U);
+  std::memset(region.data, 0x5A, 10);
+  ex.CommitWrite(10);
+
+  std::array<std::byte, 32> buffer{};
+  ASSERT_EQ(ex.Read(buffer.data(), buffer.size()), 10);
+  ASSERT_EQ(buffer[9], std::byte{0x5A});
+
+  // only the tail of the ring is contiguous now
+  region = ex.ReserveWrite(64);
+  ASSERT_EQ(region.size, 6U);
+
+  ex.CloseWrite();
+  ASSERT_EQ(ex.Read(buffer.data(), buffer.size()), 0);
+  ASSERT_EQ(ex.Write(buffer.data(), buffer.size()), -1);
+  ASSERT_EQ(ex.ReserveWrite(8).size, 0U);
+}
+
+TEST_F(GpgCoreTest, CoreDataExchangerTestD) {
+  GFDataExchanger ex(16);
+
+  std::array<std::byte, 12> buffer{};
+  buffer.fill(std::byte{0x11});
+  ASSERT_EQ(ex.Write(buffer.data(), buffer.size()), 12);
+
+  auto region = ex.BorrowReadRegion(64);
+  ASSERT_EQ(region.size, 12U);
+  ASSERT_EQ(region.data[0], std::byte{0x11});
+  ex.ReleaseReadRegion(region.size);
+
+  // wraps around, the borrowed region ends at the end of the ring
+  buffer.fill(std::byte{0x22});
+  ASSERT_EQ(ex.Write(buffer.data(), buffer.size()), 12);
+  region = ex.BorrowReadRegion(64);
+  ASSERT_EQ(region.size, 4U);
+  ex.ReleaseReadRegion(region.size);
+  region = ex.BorrowReadRegion(64);
+  ASSERT_EQ(region.size, 8U);
+  ASSERT_EQ(region.data[7], std::byte{0x22});
+  ex.ReleaseReadRegion(region.size);
+
+  ex.CloseWrite();
+  ASSERT_EQ(ex.BorrowReadRegion(64).size, 0U);
+}
+
+}  // namespace GpgFrontend::Test
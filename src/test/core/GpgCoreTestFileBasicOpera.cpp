@@ -30,15 +30,58 @@
 #include "core/GpgModel.h"
 #include "core/function/gpg/GpgFileOpera.h"
 #include "core/function/gpg/GpgKeyGetter.h"
+#include "core/model/GFMappedFile.h"
+#include "core/model/GpgData.h"
 #include "core/model/GpgDecryptResult.h"
 #include "core/model/GpgEncryptResult.h"
 #include "core/model/GpgSignResult.h"
 #include "core/model/GpgVerifyResult.h"
 #include "core/utils/GpgUtils.h"
+#include "core/thread/TaskRunnerGetter.h"
 #include "core/utils/IOUtils.h"
 
 namespace GpgFrontend::Test {
 
+TEST_F(GpgCoreTest, CoreFileEncryptBatchTest) {
+  auto encrypt_key = GpgKeyGetter::GetInstance().GetPubkey(
+      "E87C6A2D8D95C818DE93B3AE6A2764F8298DEB29");
+  ASSERT_TRUE(encrypt_key.IsGood());
+
+  const int files_count = 32;
+  auto buffer = GFBuffer(QString("Hello GpgFrontend!").repeated(4096));
+
+  QStringList input_files;
+  for (int i = 0; i < files_count; i++) {
+    input_files.append(CreateTempFileAndWriteData(buffer));
+  }
+
+  // the throughput against the count of gpg workers is measured by the
+  // file_opera benchmarks
+  auto& getter = Thread::TaskRunnerGetter::GetInstance();
+  const auto restore_count = qScopeGuard(
+      [&getter, count = getter.GetGpgWorkerCount()]() {
+        getter.SetGpgWorkerCount(count);
+      });
+  getter.SetGpgWorkerCount(4);
+
+  QEventLoop looper;
+  int remaining = files_count;
+  int failed = 0;
+
+  // all operations are posted at once and spread over the gpg workers
+  for (const auto& input_file : input_files) {
+    GpgFileOpera::GetInstance().EncryptFile(
+        {encrypt_key}, input_file, true, GetTempFilePath(),
+        [&](GpgError err, const DataObjectPtr&) {
+          if (CheckGpgError(err) != GPG_ERR_NO_ERROR) failed++;
+          if (--remaining == 0) looper.quit();
+        });
+  }
+  looper.exec();
+
+  ASSERT_EQ(failed, 0);
+}
+
 TEST_F(GpgCoreTest, CoreFileEncryptDecrTest) {
   auto encrypt_key = GpgKeyGetter::GetInstance().GetPubkey(
       "E87C6A2D8D95C818DE93B3AE6A2764F8298DEB29");
@@ -104,6 +147,59 @@ TEST_F(GpgCoreTest, CoreFileEncryptDecrBinaryTest) {
   ASSERT_EQ(buffer, out_buffer);
 }
 
+TEST_F(GpgCoreTest, CoreFileEncryptDecrLargeBinaryTest) {
+  auto encrypt_key = GpgKeyGetter::GetInstance().GetPubkey(
+      "E87C6A2D8D95C818DE93B3AE6A2764F8298DEB29");
+  ASSERT_TRUE(encrypt_key.IsGood());
+
+  // large enough to be mapped and buffered
+  auto buffer = GFBuffer(QString("Hello GpgFrontend!").repeated(256 * 1024));
+  auto input_file = CreateTempFileAndWriteData(buffer);
+  auto output_file = GetTempFilePath();
+
+  auto [err, data_object] = GpgFileOpera::GetInstance().EncryptFileSync(
+      {encrypt_key}, input_file, false, output_file);
+  ASSERT_EQ(CheckGpgError(err), GPG_ERR_NO_ERROR);
+
+  auto decrpypt_output_file = GetTempFilePath();
+  auto [err_0, data_object_0] = GpgFileOpera::GetInstance().DecryptFileSync(
+      output_file, decrpypt_output_file);
+  ASSERT_EQ(CheckGpgError(err_0), GPG_ERR_NO_ERROR);
+
+  const auto [read_success, out_buffer] =
+      ReadFileGFBuffer(decrpypt_output_file);
+  ASSERT_TRUE(read_success);
+  ASSERT_EQ(buffer, out_buffer);
+}
+
+TEST_F(GpgCoreTest, CoreFileGpgDataModesTest) {
+  QByteArray data;
+  for (int i = 0; i < 4096; i++) {
+    data.append(QByteArray::number(i).repeated(128));
+  }
+
+  auto path = GetTempFilePath();
+  {
+    GpgData data_out(path, false, GpgDataFileMode::kBuffered, data.size(),
+                     64 * 1024);
+    for (qsizetype offset = 0; offset < data.size(); offset += 1000) {
+      auto size = std::min<qsizetype>(1000, data.size() - offset);
+      ASSERT_EQ(gpgme_data_write(data_out, data.constData() + offset, size),
+                size);
+    }
+    ASSERT_EQ(CheckGpgError(data_out.Flush()), GPG_ERR_NO_ERROR);
+  }
+
+  for (auto mode : {GpgDataFileMode::kStream, GpgDataFileMode::kMapped,
+                    GpgDataFileMode::kBuffered}) {
+    GpgData data_in(path, true, mode, 0, 64 * 1024);
+    ASSERT_EQ(data_in.Read2GFBuffer().ConvertToQByteArray(), data);
+
+    // read again after seeking back
+    ASSERT_EQ(data_in.Read2GFBuffer().ConvertToQByteArray(), data);
+  }
+}
+
 TEST_F(GpgCoreTest, CoreFileEncryptSymmetricDecrTest) {
   auto buffer = GFBuffer(QString("Hello GpgFrontend!"));
   auto input_file = CreateTempFileAndWriteData(buffer);
@@ -313,4 +409,114 @@ TEST_F(GpgCoreTest, CoreFileEncryptSignDecrVerifyBinaryTest) {
   ASSERT_EQ(buffer, out_buffer);
 }
 
+TEST_F(GpgCoreTest, CoreFileDigestsTest) {
+  // a few chunks and a partial one
+  QByteArray data;
+  while (data.size() < 9 * 1024 * 1024 + 17) {
+    data.append(QString("Hello GpgFrontend!").repeated(4096).toUtf8());
+  }
+  auto path = CreateTempFileAndWriteData(GFBuffer(data));
+
+  qint64 last_read_bytes = 0;
+  auto digests = CalculateFileDigests(
+      path,
+      {QCryptographicHash::Md5, QCryptographicHash::Sha1,
+       QCryptographicHash::Sha256},
+      [&](qint64 read_bytes, qint64 file_size) {
+        ASSERT_GT(read_bytes, last_read_bytes);
+        ASSERT_EQ(file_size, data.size());
+        last_read_bytes = read_bytes;
+      });
+
+  ASSERT_EQ(digests.size(), 3);
+  ASSERT_EQ(last_read_bytes, data.size());
+  ASSERT_EQ(digests[0],
+            QCryptographicHash::hash(data, QCryptographicHash::Md5));
+  ASSERT_EQ(digests[1],
+            QCryptographicHash::hash(data, QCryptographicHash::Sha1));
+  ASSERT_EQ(digests[2],
+            QCryptographicHash::hash(data, QCryptographicHash::Sha256));
+
+  ASSERT_TRUE(CalculateFileDigests(path + ".missing",
+                                   {QCryptographicHash::Md5})
+                  .isEmpty());
+}
+
+TEST_F(GpgCoreTest, CoreMappedFileTest) {
+  QByteArray data("header line\r\n");
+  for (int i = 0; i < 1000; i++) data.append("line\n");
+
+  const QByteArray message =
+      "-----BEGIN PGP MESSAGE-----\n\nhQEMA\n-----END PGP MESSAGE-----\n";
+  const auto message_begin = data.size();
+  data.append(message);
+  data.append("-----BEGIN UNTERMINATED");
+
+  auto path = CreateTempFileAndWriteData(GFBuffer(data));
+  GFMappedFile file(path);
+  ASSERT_TRUE(file.IsMapped());
+  ASSERT_EQ(file.Size(), data.size());
+  ASSERT_EQ(file.LineCount(), 0);
+
+  qint64 indexed_bytes = 0;
+  ASSERT_TRUE(file.BuildLineIndex([&](qint64 bytes) {
+    indexed_bytes = bytes;
+    return true;
+  }));
+  ASSERT_TRUE(file.IsLineIndexed());
+  ASSERT_EQ(indexed_bytes, data.size());
+  ASSERT_EQ(file.LineCount(), 1 + 1000 + 4 + 1);
+  ASSERT_EQ(file.Line(0), QByteArray("header line"));
+  ASSERT_EQ(file.Line(1000), QByteArray("line"));
+  ASSERT_EQ(file.Line(1005), QByteArray("-----BEGIN UNTERMINATED"));
+  ASSERT_TRUE(file.Line(1006).isEmpty());
+
+  auto blocks = file.FindArmorBlocks();
+  ASSERT_EQ(blocks.size(), 1);
+  ASSERT_EQ(blocks.front().type, QByteArray("PGP MESSAGE"));
+  ASSERT_EQ(blocks.front().begin, message_begin);
+  ASSERT_EQ(blocks.front().end, message_begin + message.size());
+  ASSERT_EQ(GFMappedFile::GetBuffer(std::make_shared<GFMappedFile>(path),
+                                    blocks.front().begin, blocks.front().end)
+                .ConvertToQByteArray(),
+            message);
+
+  ASSERT_FALSE(GFMappedFile(path + ".missing").IsMapped());
+}
+
+TEST_F(GpgCoreTest, CoreMappedFileBufferTest) {
+  const auto data = GFBuffer(QByteArray(64 * 1024, 'a') + "tail");
+  auto path = CreateTempFileAndWriteData(data);
+
+  auto file = std::make_shared<GFMappedFile>(path);
+  ASSERT_TRUE(file->IsMapped());
+
+  // the buffer keeps the file mapped after the last other owner is gone
+  auto buffer = GFMappedFile::GetBuffer(file, 64 * 1024, file->Size());
+  auto whole = GFMappedFile::GetBuffer(file, 0, file->Size());
+  file.reset();
+  ASSERT_EQ(buffer.ConvertToQByteArray(), QByteArray("tail"));
+  ASSERT_EQ(whole, data);
+  ASSERT_TRUE(GFMappedFile::GetBuffer(nullptr, 0, 1).Empty());
+}
+
+TEST_F(GpgCoreTest, CoreMappedFileCopyTest) {
+  const auto data = GFBuffer(QByteArray(64 * 1024, 'b'));
+  auto path = CreateTempFileAndWriteData(data);
+  GFMappedFile file(path);
+  ASSERT_TRUE(file.IsMapped());
+
+  // saving onto the mapped file must not truncate it
+  ASSERT_TRUE(file.CopyTo(path));
+  QByteArray content;
+  ASSERT_TRUE(ReadFile(path, content));
+  ASSERT_EQ(GFBuffer(content), data);
+
+  const auto copy_path = path + ".copy";
+  ASSERT_TRUE(file.CopyTo(copy_path));
+  ASSERT_TRUE(ReadFile(copy_path, content));
+  ASSERT_EQ(GFBuffer(content), data);
+  QFile::remove(copy_path);
+}
+
 }  // namespace GpgFrontend::Test
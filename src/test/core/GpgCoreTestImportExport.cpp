@@ -28,8 +28,15 @@
 
 #include "GpgCoreTest.h"
 #include "core/GpgConstants.h"
+#include "core/function/KeyPackageOperator.h"
+#include "core/function/PassphraseGenerator.h"
+#include "core/function/gpg/GpgContext.h"
+#include "core/function/gpg/GpgKeyGetter.h"
 #include "core/function/gpg/GpgKeyImportExporter.h"
+#include "core/function/gpg/GpgKeyOpera.h"
+#include "core/model/GpgImportInformation.h"
 #include "core/utils/GpgUtils.h"
+#include "core/utils/IOUtils.h"
 
 namespace GpgFrontend::Test {
 
@@ -93,4 +100,89 @@ TEST_F(GpgCoreTest, CoreExportSubkeyTestD) {
           "6e3375060aa889d9eb61e2966eabb31eb6b5359a7742ee7adeedec09e6afa36a"));
 }
 
+TEST_F(GpgCoreTest, CoreKeyPackageTestA) {
+  auto key = GpgKeyGetter::GetInstance().GetKey("F89C95A05088CC93");
+  ASSERT_TRUE(key.IsGood());
+
+  const auto phrase = PassphraseGenerator::GetInstance().Generate(256);
+  const auto path = GetTempFilePath();
+  auto err = KeyPackageOperator::WriteKeyPackage(
+      path, kGpgFrontendDefaultChannel, {key}, phrase, false);
+  ASSERT_EQ(CheckGpgError(err), GPG_ERR_NO_ERROR);
+
+  QByteArray data;
+  ASSERT_TRUE(ReadFile(path, data));
+  ASSERT_TRUE(data.startsWith("GFKP"));
+
+  auto info = KeyPackageOperator::ReadKeyPackage(path, phrase.toUtf8(),
+                                                 kGpgFrontendDefaultChannel);
+  ASSERT_TRUE(info != nullptr);
+  ASSERT_EQ(info->considered, 1);
+  ASSERT_EQ(info->not_imported, 0);
+
+  // a package cut before its final chunk is refused
+  ASSERT_TRUE(WriteFile(path, data.left(data.size() - 1)));
+  ASSERT_TRUE(KeyPackageOperator::ReadKeyPackage(
+                  path, phrase.toUtf8(), kGpgFrontendDefaultChannel) ==
+              nullptr);
+
+  // enough small keys for a package of more than one 64 KiB chunk
+  QString params = "<GnupgKeyParms format=\"internal\">\n";
+  for (int i = 0; i < 400; i++) {
+    params += QString(
+                  "Key-Type: EdDSA\n"
+                  "Key-Curve: ed25519\n"
+                  "Key-Usage: sign\n"
+                  "Name-Real: Key Package Test %1\n"
+                  "Name-Email: key-package-%1@gpgfrontend.bktus.com\n"
+                  "Expire-Date: 0\n"
+                  "%no-protection\n"
+                  "%commit\n")
+                  .arg(i);
+  }
+  params += "</GnupgKeyParms>\n";
+  ASSERT_EQ(CheckGpgError(gpgme_op_genkey(
+                GpgContext::GetInstance().DefaultContext(),
+                params.toUtf8().constData(), nullptr, nullptr)),
+            GPG_ERR_NO_ERROR);
+
+  auto& getter = GpgKeyGetter::GetInstance();
+  ASSERT_TRUE(getter.FlushKeyCache());
+
+  KeyArgsList keys;
+  KeyIdArgsList key_ids;
+  for (const auto& k : getter.FetchKey()) {
+    if (!k.GetEmail().startsWith("key-package-")) continue;
+    keys.push_back(k);
+    key_ids.push_back(k.GetId());
+  }
+  ASSERT_EQ(keys.size(), 400);
+
+  err = KeyPackageOperator::WriteKeyPackage(path, kGpgFrontendDefaultChannel,
+                                            keys, phrase, false);
+  ASSERT_EQ(CheckGpgError(err), GPG_ERR_NO_ERROR);
+  GpgKeyOpera::GetInstance().DeleteKeys(key_ids);
+
+  ASSERT_TRUE(ReadFile(path, data));
+  const qsizetype header_size = 4 + 1 + 8;
+  const qsizetype sealed_chunk_size = 1 + 4 + (64 * 1024) + 16;
+  ASSERT_GT(data.size(), header_size + sealed_chunk_size);
+
+  // cut right after a whole chunk, the keys in it must not be imported
+  ASSERT_TRUE(WriteFile(path, data.left(header_size + sealed_chunk_size)));
+  ASSERT_TRUE(KeyPackageOperator::ReadKeyPackage(
+                  path, phrase.toUtf8(), kGpgFrontendDefaultChannel) ==
+              nullptr);
+  for (const auto& key_id : key_ids) {
+    ASSERT_FALSE(getter.GetKey(key_id, false).IsGood());
+  }
+
+  ASSERT_TRUE(WriteFile(path, data));
+  info = KeyPackageOperator::ReadKeyPackage(path, phrase.toUtf8(),
+                                            kGpgFrontendDefaultChannel);
+  ASSERT_TRUE(info != nullptr);
+  ASSERT_EQ(info->considered, 400);
+  GpgKeyOpera::GetInstance().DeleteKeys(key_ids);
+}
+
 }  // namespace GpgFrontend::Test
\ No newline at end of file
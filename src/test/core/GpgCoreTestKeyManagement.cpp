@@ -141,6 +141,36 @@ TEST_F(GpgCoreTest, CoreDeleteSubkeyTestA) {
   GpgKeyOpera::GetInstance().DeleteKey(key.GetId());
 }
 
+TEST_F(GpgCoreTest, CoreKeyCacheUpdateTestA) {
+  auto& key_getter = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel);
+  key_getter.FlushKeyCache();
+
+  auto info = GpgKeyImportExporter::GetInstance().ImportKey(
+      GFBuffer(QString::fromLatin1(test_private_key_data)));
+  ASSERT_EQ(info->imported, 1);
+
+  // looked up by subkey id and email without flushing the whole cache
+  auto key = key_getter.GetKey("2D1F9FC59B568A8C");
+  ASSERT_TRUE(key.IsGood());
+  ASSERT_EQ(key.GetId(), "822D7E13F5B85D7D");
+
+  auto keys = key_getter.GetKeysByEmail("AAAAAA@aaa.aaaa");
+  ASSERT_EQ(keys.size(), 1);
+  ASSERT_EQ(keys.front().GetId(), "822D7E13F5B85D7D");
+
+  ASSERT_TRUE(GpgKeyManager::GetInstance().DeleteSubkey(key, 2));
+  key = key_getter.GetKey("822D7E13F5B85D7D");
+  ASSERT_EQ(key.GetSubKeys()->size(), 4);
+  ASSERT_FALSE(key_getter.GetKey("2D1F9FC59B568A8C").IsGood());
+
+  GpgKeyOpera::GetInstance().DeleteKey(key.GetId());
+  ASSERT_TRUE(key_getter.GetKeysByEmail("aaaaaa@aaa.aaaa").empty());
+
+  for (const auto& fetched_key : key_getter.FetchKey()) {
+    ASSERT_NE(fetched_key.GetId(), "822D7E13F5B85D7D");
+  }
+}
+
 TEST_F(GpgCoreTest, CoreSetOwnerTrustA) {
   auto info = GpgKeyImportExporter::GetInstance().ImportKey(
       GFBuffer(QString::fromLatin1(test_private_key_data)));
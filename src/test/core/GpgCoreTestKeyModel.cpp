@@ -29,8 +29,11 @@
 #include <gtest/gtest.h>
 
 #include "GpgCoreTest.h"
+#include "core/function/DataObjectCipher.h"
+#include "core/function/GlobalSettingStation.h"
 #include "core/function/gpg/GpgContext.h"
 #include "core/function/gpg/GpgKeyGetter.h"
+#include "core/function/gpg/GpgKeyTableSnapshot.h"
 #include "core/model/GpgData.h"
 #include "core/model/GpgKey.h"
 #include "core/utils/GpgUtils.h"
@@ -193,4 +196,83 @@ TEST_F(GpgCoreTest, GpgKeyGetterTest) {
   ASSERT_TRUE(std::find(keys.begin(), keys.end(), key) != keys.end());
 }
 
+TEST_F(GpgCoreTest, GpgKeyTableModelTest) {
+  auto keys = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel).FetchKey();
+  auto model = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
+                   .GetGpgKeyTableModel();
+
+  ASSERT_EQ(model->rowCount({}), keys.size());
+  for (int i = 0; i < keys.size(); i++) {
+    const GpgKeyTableRow row(keys[i]);
+
+    ASSERT_EQ(model->data(model->index(i, 2), Qt::DisplayRole), row.name);
+    ASSERT_EQ(model->data(model->index(i, 4), Qt::DisplayRole), row.usage);
+    ASSERT_EQ(model->data(model->index(i, 6), Qt::DisplayRole), row.id);
+    ASSERT_EQ(model->data(model->index(i, 9), Qt::DisplayRole),
+              row.subkeys_count);
+    ASSERT_EQ(model->GetKeyIDByRow(i), keys[i].GetId());
+    ASSERT_EQ(model->IsPrivateKeyByRow(i), keys[i].IsPrivateKey());
+  }
+
+  ASSERT_FALSE(keys.empty());
+  const auto fpr = keys.front().GetFingerprint();
+  ASSERT_TRUE(model->SearchRows(fpr.toLower()).contains(0));
+  ASSERT_TRUE(model->SearchRows(fpr.right(8)).contains(0));
+  ASSERT_TRUE(model->SearchRows("no key has this user id").isEmpty());
+
+  // narrowing the keywords gives the same rows as a new search
+  const auto uid = keys.front().GetUIDs()->front().GetUID();
+  for (qsizetype i = 1; i <= uid.size(); i++) {
+    GpgKeyTableModel fresh_model(kGpgFrontendDefaultChannel, keys);
+    const auto rows = model->SearchRows(uid.left(i));
+
+    ASSERT_TRUE(rows.contains(0));
+    ASSERT_EQ(rows, fresh_model.SearchRows(uid.left(i)));
+  }
+}
+
+TEST_F(GpgCoreTest, GpgKeyTableSnapshotTest) {
+  auto& key_getter = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel);
+  ASSERT_TRUE(key_getter.FlushKeyCache());
+  auto keys = key_getter.FetchKey();
+
+  auto& snapshot =
+      GpgKeyTableSnapshot::GetInstance(kGpgFrontendDefaultChannel);
+  ASSERT_TRUE(snapshot.Load());
+  auto rows = snapshot.GetRows();
+  snapshot.Release();
+  ASSERT_FALSE(snapshot.IsLoaded());
+
+  ASSERT_EQ(rows.size(), keys.size());
+  for (int i = 0; i < rows.size(); i++) {
+    ASSERT_EQ(rows[i].fpr, keys[i].GetFingerprint());
+    ASSERT_EQ(rows[i].id, keys[i].GetId());
+    ASSERT_EQ(rows[i].name, keys[i].GetName());
+    ASSERT_EQ(rows[i].email, keys[i].GetEmail());
+    ASSERT_EQ(rows[i].create_time.toSecsSinceEpoch(),
+              keys[i].GetCreateTime().toSecsSinceEpoch());
+    ASSERT_EQ(rows[i].subkeys_count,
+              static_cast<int>(keys[i].GetSubKeys()->size()));
+    ASSERT_EQ(rows[i].is_private, keys[i].IsPrivateKey());
+  }
+
+  // the snapshots are sealed and only accessible by the owner
+  QDirIterator it(GlobalSettingStation::GetInstance().GetAppDataPath() +
+                      "/key_table_snapshots",
+                  QDir::Files);
+  while (it.hasNext()) {
+    QFile file(it.next());
+    ASSERT_EQ(file.permissions() & (QFileDevice::ReadGroup |
+                                    QFileDevice::ReadOther),
+              QFileDevice::Permissions{});
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    ASSERT_NE(DataObjectCipher::GetFormatVersion(file.readAll()), 0);
+  }
+
+  // a snapshot of another keyring state is not loaded
+  ASSERT_TRUE(snapshot.Save("outdated", rows));
+  ASSERT_FALSE(snapshot.Load());
+  ASSERT_TRUE(key_getter.FlushKeyCache());
+}
+
 }  // namespace GpgFrontend::Test
\ No newline at end of file
@@ -0,0 +1,125 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "GpgCoreTest.h"
+#include "core/module/GlobalRegisterTable.h"
+#include "core/module/ModuleManager.h"
+
+namespace GpgFrontend::Test {
+
+TEST_F(GpgCoreTest, CoreRegisterTableKeyTest) {
+  Module::GlobalRegisterTable grt;
+
+  ASSERT_FALSE(grt.LookupKV("test", "a.b.c").has_value());
+  ASSERT_TRUE(grt.PublishKV("test", "a.b.c", 1));
+  ASSERT_TRUE(grt.PublishKV("test", "a.b.d", QString("d")));
+
+  auto value = grt.LookupKV("test", "a.b.c");
+  ASSERT_TRUE(value.has_value());
+  ASSERT_EQ(std::any_cast<int>(*value), 1);
+  ASSERT_FALSE(grt.LookupKV("test", "a.b.e").has_value());
+  ASSERT_FALSE(grt.LookupKV("test.a", "c").has_value());
+  ASSERT_EQ(grt.ListChildKeys("test", "a.b"),
+            QContainer<Module::Key>({"c", "d"}));
+
+  auto key = grt.ResolveKey("test.a", "b.c");
+  ASSERT_TRUE(key.IsValid());
+  ASSERT_EQ(std::any_cast<int>(*grt.LookupKV(key)), 1);
+
+  ASSERT_TRUE(grt.PublishKV(key, 2));
+  ASSERT_EQ(std::any_cast<int>(*grt.LookupKV("test", "a.b.c")), 2);
+
+  ASSERT_FALSE(grt.PublishKV(Module::RTKey{}, 3));
+  ASSERT_FALSE(grt.LookupKV(Module::RTKey{}).has_value());
+}
+
+TEST_F(GpgCoreTest, CoreRegisterTableListenTest) {
+  Module::GlobalRegisterTable grt;
+
+  QContainer<int> versions;
+  auto receiver = std::make_unique<QObject>();
+  ASSERT_TRUE(grt.ListenPublish(
+      receiver.get(), "test", "a.b",
+      [&](const Module::Namespace& n, const Module::Key& k, int version,
+          const std::any&) {
+        ASSERT_EQ(n, "test");
+        ASSERT_EQ(k, "a.b");
+        versions.push_back(version);
+      }));
+
+  // listening creates no visible node
+  ASSERT_TRUE(grt.ListChildKeys("test", "a").empty());
+
+  grt.PublishKV("test", "a.b", 1);
+  grt.PublishKV("test", "a.c", 1);
+  grt.PublishKV("test", "a", 1);
+  grt.PublishKV(grt.ResolveKey("test", "a.b"), 2);
+
+  // the same path split otherwise, the listener still gets its own n and k
+  grt.PublishKV("test.a", "b", 3);
+  ASSERT_EQ(versions, QContainer<int>({1, 2, 3}));
+
+  ASSERT_TRUE(grt.ListenPublish(receiver.get(), "test", "a.hidden",
+                                [](const Module::Namespace&, const Module::Key&,
+                                   int, const std::any&) {}));
+  grt.ResolveKey("test", "a.resolved");
+  ASSERT_EQ(grt.ListChildKeys("test", "a"),
+            QContainer<Module::Key>({"b", "c"}));
+
+  grt.PublishKV("test", "a.hidden", 1);
+  ASSERT_EQ(grt.ListChildKeys("test", "a"),
+            QContainer<Module::Key>({"b", "c", "hidden"}));
+
+  receiver.reset();
+  grt.PublishKV("test", "a.b", 4);
+  ASSERT_EQ(versions.size(), 3);
+}
+
+TEST_F(GpgCoreTest, CoreRegisterTableHandleTest) {
+  int parsed = 0;
+  Module::RTHandle<QString, int> handle(
+      "test_rt_handle", "a.b", QString{"1"}, [&](const QString& v) -> int {
+        parsed++;
+        return v.toInt();
+      });
+
+  ASSERT_EQ(handle.Get(), 1);
+  ASSERT_EQ(handle.Get(), 1);
+  ASSERT_EQ(parsed, 1);
+
+  Module::UpsertRTValue("test_rt_handle", "a.b", QString{"2"});
+  ASSERT_EQ(handle.Get(), 2);
+  ASSERT_EQ(handle.Get(), 2);
+  ASSERT_EQ(parsed, 2);
+
+  Module::UpsertRTValue("test_rt_handle", "a.b", 3);
+  ASSERT_EQ(handle.Get(), 1);
+  ASSERT_EQ(parsed, 3);
+}
+
+}  // namespace GpgFrontend::Test
@@ -0,0 +1,210 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "GpgCoreTest.h"
+#include "core/thread/TaskRunnerGetter.h"
+#include "core/thread/TaskTracer.h"
+#include "core/utils/AsyncUtils.h"
+
+namespace GpgFrontend::Test {
+
+TEST_F(GpgCoreTest, CoreTaskRunnerScheduleTestA) {
+  auto runner = Thread::TaskRunnerGetter::GetInstance().GetTaskRunner();
+
+  std::promise<qint64> promise;
+  auto future = promise.get_future();
+
+  QElapsedTimer timer;
+  timer.start();
+  auto id = runner->PostScheduleTask(
+      new Thread::Task(
+          [&](const DataObjectPtr&) -> int {
+            promise.set_value(timer.elapsed());
+            return 0;
+          },
+          "delayed_task"),
+      std::chrono::milliseconds(200));
+  ASSERT_GT(id, 0);
+
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  ASSERT_GE(future.get(), 200);
+
+  // already fired
+  ASSERT_FALSE(runner->CancelScheduleTask(id));
+}
+
+TEST_F(GpgCoreTest, CoreTaskRunnerScheduleTestB) {
+  auto runner = Thread::TaskRunnerGetter::GetInstance().GetTaskRunner();
+
+  std::atomic_int runs = 0;
+  auto id = runner->PostPeriodicTask(
+      "periodic_task",
+      [&](const DataObjectPtr&) -> int {
+        runs++;
+        return 0;
+      },
+      std::chrono::milliseconds(20));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_TRUE(runner->CancelScheduleTask(id));
+  ASSERT_GE(runs, 3);
+
+  // let the posted runs finish
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const int runs_after_cancel = runs;
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_EQ(runs, runs_after_cancel);
+}
+
+TEST_F(GpgCoreTest, CoreTaskRunnerScheduleTestC) {
+  auto runner = Thread::TaskRunnerGetter::GetInstance().GetTaskRunner();
+
+  std::atomic_bool ran = false;
+  auto id = runner->PostScheduleTask(
+      new Thread::Task(
+          [&](const DataObjectPtr&) -> int {
+            ran = true;
+            return 0;
+          },
+          "cancelled_task"),
+      std::chrono::milliseconds(300));
+
+  ASSERT_TRUE(runner->CancelScheduleTask(id));
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_FALSE(ran);
+}
+
+TEST_F(GpgCoreTest, CoreTaskTracerTest) {
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+  const auto path = dir.filePath("trace.json");
+
+  auto& tracer = Thread::TaskTracer::GetInstance();
+  tracer.Start(path);
+  ASSERT_TRUE(tracer.IsEnabled());
+
+  std::promise<void> promise;
+  auto future = promise.get_future();
+  Thread::TaskRunnerGetter::GetInstance().GetTaskRunner()->PostTask(
+      new Thread::Task(
+          [&](const DataObjectPtr&) -> int {
+            Thread::TraceSpan span("traced_span", "test");
+            promise.set_value();
+            return 0;
+          },
+          "traced_task"));
+
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+
+  // the run is recorded right after the runnable returns
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_TRUE(tracer.Flush());
+  ASSERT_FALSE(tracer.IsEnabled());
+
+  QFile file(path);
+  ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+  const auto events =
+      QJsonDocument::fromJson(file.readAll()).object()["traceEvents"].toArray();
+
+  auto find = [&](const QString& ph, const QString& name) -> QJsonObject {
+    for (const auto& event : events) {
+      const auto object = event.toObject();
+      if (object["ph"] == ph && object["name"] == name) return object;
+    }
+    return {};
+  };
+
+  const auto run = find("X", "traced_task");
+  const auto span = find("X", "traced_span");
+  ASSERT_EQ(run["cat"].toString(), "task.run");
+  ASSERT_EQ(span["cat"].toString(), "test");
+  ASSERT_FALSE(find("e", "queue").isEmpty());
+
+  // the wait in the queue begins on the posting thread, not on the worker
+  const auto queued = find("b", "queue");
+  ASSERT_FALSE(queued.isEmpty());
+  ASSERT_NE(queued["tid"].toInt(), run["tid"].toInt());
+  ASSERT_LE(queued["ts"].toDouble(), run["ts"].toDouble());
+
+  // the span is nested in the run of the task
+  ASSERT_EQ(span["tid"].toInt(), run["tid"].toInt());
+  ASSERT_GE(span["ts"].toDouble(), run["ts"].toDouble());
+  ASSERT_LE(span["ts"].toDouble() + span["dur"].toDouble(),
+            run["ts"].toDouble() + run["dur"].toDouble());
+}
+
+TEST_F(GpgCoreTest, CoreTaskRunnerGpgLaneSlotTest) {
+  auto& getter = Thread::TaskRunnerGetter::GetInstance();
+  const auto pool_size = getter.GetGpgWorkerCount();
+  const int size = 2;
+  getter.SetGpgWorkerCount(size);
+
+  // a thread running no gpg task holds no slot
+  ASSERT_EQ(getter.GetGpgLaneSlot(), -1);
+
+  std::atomic_int running = 0;
+  std::atomic_int max_running = 0;
+  std::atomic_int bad_slots = 0;
+
+  QEventLoop looper;
+  int remaining = 8;
+  for (int i = 0; i < 8; i++) {
+    RunGpgOperaAsync(
+        [&](const DataObjectPtr&) -> GpgError {
+          const auto now = ++running;
+          auto max = max_running.load();
+          while (now > max && !max_running.compare_exchange_weak(max, now)) {
+          }
+
+          const auto slot = getter.GetGpgLaneSlot();
+          if (slot < 0 || slot >= size) bad_slots++;
+
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          running--;
+          return GPG_ERR_NO_ERROR;
+        },
+        [&](GpgError, const DataObjectPtr&) {
+          if (--remaining == 0) looper.quit();
+        },
+        "gpg_lane_slot_test", "0.0.0");
+  }
+  looper.exec();
+  getter.SetGpgWorkerCount(pool_size);
+
+  ASSERT_EQ(bad_slots.load(), 0);
+  ASSERT_LE(max_running.load(), size);
+}
+
+}  // namespace GpgFrontend::Test
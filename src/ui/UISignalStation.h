@@ -59,6 +59,13 @@ class UISignalStation : public QObject {
    */
   void SignalKeyDatabaseRefresh();
 
+  /**
+   * @brief list the whole keyring again, e.g. to pick up changes made by
+   * other programs
+   *
+   */
+  void SignalKeyDatabaseReload();
+
   /**
    * @brief
    *
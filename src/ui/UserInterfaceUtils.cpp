@@ -97,6 +97,11 @@ CommonUtils::CommonUtils() : QWidget(nullptr) {
           UISignalStation::GetInstance(),
           &UISignalStation::SignalKeyDatabaseRefreshDone);
 
+  // replace the key lists shown from the key table snapshot
+  connect(CoreSignalStation::GetInstance(),
+          &CoreSignalStation::SignalKeyCacheReconciled, this,
+          &CommonUtils::SignalKeyDatabaseRefreshDone);
+
   // directly connect to SignalKeyStatusUpdated
   // to avoid the delay of signal emitting
   // when the key database is refreshed
@@ -104,6 +109,10 @@ CommonUtils::CommonUtils() : QWidget(nullptr) {
           &UISignalStation::SignalKeyDatabaseRefresh, this,
           &CommonUtils::slot_update_key_status);
 
+  connect(UISignalStation::GetInstance(),
+          &UISignalStation::SignalKeyDatabaseReload, this,
+          &CommonUtils::slot_reload_key_database);
+
   connect(this, &CommonUtils::SignalRestartApplication,
           UISignalStation::GetInstance(),
           &UISignalStation::SignalRestartApplication);
@@ -445,12 +454,12 @@ void CommonUtils::SlotImportKeyFromKeyServer(
 }
 
 void CommonUtils::slot_update_key_status() {
+  // the operations changing keys already updated the key cache, the keyring
+  // is only listed again if something else changed it
   auto *refresh_task = new Thread::Task(
       [](DataObjectPtr) -> int {
-        // flush key cache for all GpgKeyGetter Intances.
         for (const auto &channel_id : GpgContext::GetAllChannelId()) {
-          LOG_D() << "refreshing key database at channel: " << channel_id;
-          GpgKeyGetter::GetInstance(channel_id).FlushKeyCache();
+          GpgKeyGetter::GetInstance(channel_id).SyncKeyCache();
         }
         LOG_D() << "refreshing key database at all channel done";
         return 0;
@@ -467,6 +476,27 @@ void CommonUtils::slot_update_key_status() {
       ->PostTask(refresh_task);
 }
 
+void CommonUtils::slot_reload_key_database() {
+  auto *reload_task = new Thread::Task(
+      [](DataObjectPtr) -> int {
+        // flush key cache for all GpgKeyGetter Intances.
+        for (const auto &channel_id : GpgContext::GetAllChannelId()) {
+          LOG_D() << "reloading key database at channel: " << channel_id;
+          GpgKeyGetter::GetInstance(channel_id).FlushKeyCache();
+        }
+        LOG_D() << "reloading key database at all channel done";
+        return 0;
+      },
+      "reload_key_database_task");
+
+  connect(reload_task, &Thread::Task::SignalTaskEnd, this,
+          &CommonUtils::SignalKeyDatabaseRefreshDone);
+
+  Thread::TaskRunnerGetter::GetInstance()
+      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_GPG)
+      ->PostTask(reload_task);
+}
+
 void CommonUtils::slot_update_key_from_server_finished(
     int channel, bool success, QString err_msg, QByteArray buffer,
     std::shared_ptr<GpgImportInformation> info) {
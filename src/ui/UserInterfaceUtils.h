@@ -262,6 +262,12 @@ class CommonUtils : public QWidget {
    */
   void slot_update_key_status();
 
+  /**
+   * @brief reload the whole key database when signal is emitted
+   *
+   */
+  void slot_reload_key_database();
+
   /**
    * @brief
    *
@@ -32,7 +32,6 @@
 #include "core/function/GlobalSettingStation.h"
 #include "core/function/gpg/GpgKeyOpera.h"
 #include "core/typedef/GpgTypedef.h"
-#include "core/utils/CacheUtils.h"
 #include "core/utils/CommonUtils.h"
 #include "core/utils/GpgUtils.h"
 #include "ui/UISignalStation.h"
@@ -599,14 +598,6 @@ void KeyGenerateDialog::slot_easy_combination_changed(const QString& mode) {
 }
 
 void KeyGenerateDialog::do_generate() {
-  if (!GetSettings()
-           .value("gnupg/use_pinentry_as_password_input_dialog",
-                  !IsFlatpakENV())
-           .toBool() &&
-      !ui_->noPassphraseCheckBox->isChecked()) {
-    SetCacheValue("PinentryContext", "NEW_PASSPHRASE");
-  }
-
   auto f = [this,
             gen_key_info = this->gen_key_info_](const OperaWaitingHd& hd) {
     GpgKeyOpera::GetInstance(channel_).GenerateKeyWithSubkey(
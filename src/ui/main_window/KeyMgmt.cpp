@@ -62,17 +62,11 @@ KeyMgmt::KeyMgmt(QWidget* parent)
 
   key_list_->AddListGroupTab(
       tr("Only Public Key"), "only_public_key",
-      GpgKeyTableDisplayMode::kPUBLIC_KEY, [](const GpgKey& key) -> bool {
-        return !key.IsPrivateKey() &&
-               !(key.IsRevoked() || key.IsDisabled() || key.IsExpired());
-      });
+      GpgKeyTableDisplayMode::kPUBLIC_KEY | GpgKeyTableDisplayMode::kUSABLE);
 
   key_list_->AddListGroupTab(
       tr("Has Private Key"), "has_private_key",
-      GpgKeyTableDisplayMode::kPRIVATE_KEY, [](const GpgKey& key) -> bool {
-        return key.IsPrivateKey() &&
-               !(key.IsRevoked() || key.IsDisabled() || key.IsExpired());
-      });
+      GpgKeyTableDisplayMode::kPRIVATE_KEY | GpgKeyTableDisplayMode::kUSABLE);
 
   key_list_->AddListGroupTab(
       tr("No Primary Key"), "no_primary_key",
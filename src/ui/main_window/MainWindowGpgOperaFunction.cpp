@@ -188,7 +188,7 @@ void MainWindow::SlotEncrypt() {
 
   if (!encrypt_operation_key_validate(contexts)) return;
 
-  contexts->GetContextBuffer(0).append(GFBuffer(edit_->CurPlainText()));
+  contexts->GetContextBuffer(0).append(edit_->CurBuffer());
   GpgOperaHelper::BuildOperas(contexts, 0,
                               m_key_list_->GetCurrentGpgContextChannel(),
                               GpgOperaHelper::BuildOperasEncrypt);
@@ -209,7 +209,7 @@ void MainWindow::SlotSign() {
          "sign usage."));
   if (contexts->keys.empty()) return;
 
-  contexts->GetContextBuffer(0).append(GFBuffer(edit_->CurPlainText()));
+  contexts->GetContextBuffer(0).append(edit_->CurBuffer());
   GpgOperaHelper::BuildOperas(contexts, 0,
                               m_key_list_->GetCurrentGpgContextChannel(),
                               GpgOperaHelper::BuildOperasSign);
@@ -223,7 +223,7 @@ void MainWindow::SlotDecrypt() {
   auto contexts = QSharedPointer<GpgOperaContextBasement>::create();
   contexts->ascii = true;
 
-  contexts->GetContextBuffer(0).append(GFBuffer(edit_->CurPlainText()));
+  contexts->GetContextBuffer(0).append(edit_->CurArmorBuffer());
   GpgOperaHelper::BuildOperas(contexts, 0,
                               m_key_list_->GetCurrentGpgContextChannel(),
                               GpgOperaHelper::BuildOperasDecrypt);
@@ -237,7 +237,7 @@ void MainWindow::SlotVerify() {
   auto contexts = QSharedPointer<GpgOperaContextBasement>::create();
   contexts->ascii = true;
 
-  contexts->GetContextBuffer(0).append(GFBuffer(edit_->CurPlainText()));
+  contexts->GetContextBuffer(0).append(edit_->CurArmorBuffer());
   GpgOperaHelper::BuildOperas(contexts, 0,
                               m_key_list_->GetCurrentGpgContextChannel(),
                               GpgOperaHelper::BuildOperasVerify);
@@ -263,7 +263,7 @@ void MainWindow::SlotEncryptSign() {
 
   if (!sign_operation_key_validate(contexts)) return;
 
-  contexts->GetContextBuffer(0).append(GFBuffer(edit_->CurPlainText()));
+  contexts->GetContextBuffer(0).append(edit_->CurBuffer());
   GpgOperaHelper::BuildOperas(contexts, 0,
                               m_key_list_->GetCurrentGpgContextChannel(),
                               GpgOperaHelper::BuildOperasEncryptSign);
@@ -277,7 +277,7 @@ void MainWindow::SlotDecryptVerify() {
   auto contexts = QSharedPointer<GpgOperaContextBasement>::create();
   contexts->ascii = true;
 
-  contexts->GetContextBuffer(0).append(GFBuffer(edit_->CurPlainText()));
+  contexts->GetContextBuffer(0).append(edit_->CurArmorBuffer());
   GpgOperaHelper::BuildOperas(contexts, 0,
                               m_key_list_->GetCurrentGpgContextChannel(),
                               GpgOperaHelper::BuildOperasDecryptVerify);
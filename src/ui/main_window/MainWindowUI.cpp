@@ -558,33 +558,23 @@ void MainWindow::create_dock_windows() {
   // key_list_dock_->setMinimumWidth(460);
   addDockWidget(Qt::RightDockWidgetArea, key_list_dock_);
 
-  m_key_list_->AddListGroupTab(
-      tr("Default"), "default",
-      GpgKeyTableDisplayMode::kPUBLIC_KEY |
-          GpgKeyTableDisplayMode::kPRIVATE_KEY,
-      [](const GpgKey& key) -> bool {
-        return !(key.IsRevoked() || key.IsDisabled() || key.IsExpired());
-      });
+  m_key_list_->AddListGroupTab(tr("Default"), "default",
+                               GpgKeyTableDisplayMode::kPUBLIC_KEY |
+                                   GpgKeyTableDisplayMode::kPRIVATE_KEY |
+                                   GpgKeyTableDisplayMode::kUSABLE);
 
   m_key_list_->AddListGroupTab(tr("Favourite"), "favourite",
                                GpgKeyTableDisplayMode::kPUBLIC_KEY |
                                    GpgKeyTableDisplayMode::kPRIVATE_KEY |
-                                   GpgKeyTableDisplayMode::kFAVORITES,
-                               [](const GpgKey&) -> bool { return true; });
+                                   GpgKeyTableDisplayMode::kFAVORITES);
 
   m_key_list_->AddListGroupTab(
       tr("Only Public Key"), "only_public_key",
-      GpgKeyTableDisplayMode::kPUBLIC_KEY, [](const GpgKey& key) -> bool {
-        return !key.IsPrivateKey() &&
-               !(key.IsRevoked() || key.IsDisabled() || key.IsExpired());
-      });
+      GpgKeyTableDisplayMode::kPUBLIC_KEY | GpgKeyTableDisplayMode::kUSABLE);
 
   m_key_list_->AddListGroupTab(
       tr("Has Private Key"), "has_private_key",
-      GpgKeyTableDisplayMode::kPRIVATE_KEY, [](const GpgKey& key) -> bool {
-        return key.IsPrivateKey() &&
-               !(key.IsRevoked() || key.IsDisabled() || key.IsExpired());
-      });
+      GpgKeyTableDisplayMode::kPRIVATE_KEY | GpgKeyTableDisplayMode::kUSABLE);
 
   m_key_list_->SlotRefresh();
 
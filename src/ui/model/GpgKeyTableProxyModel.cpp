@@ -57,55 +57,35 @@ GpgKeyTableProxyModel::GpgKeyTableProxyModel(
 }
 
 auto GpgKeyTableProxyModel::filterAcceptsRow(
-    int source_row, const QModelIndex &sourceParent) const -> bool {
-  auto index = sourceModel()->index(source_row, 6, sourceParent);
-  auto key_id = sourceModel()->data(index).toString();
-
-  auto key =
-      GpgKeyGetter::GetInstance(model_->GetGpgContextChannel()).GetKey(key_id);
-  LOG_D() << "get key: " << key_id
-          << "from channel: " << model_->GetGpgContextChannel();
-  assert(key.IsGood());
+    int source_row, const QModelIndex & /*sourceParent*/) const -> bool {
+  const auto is_private_key = model_->IsPrivateKeyByRow(source_row);
 
   if (!(display_mode_ & GpgKeyTableDisplayMode::kPRIVATE_KEY) &&
-      key.IsPrivateKey()) {
+      is_private_key) {
     return false;
   }
 
   if (!(display_mode_ & GpgKeyTableDisplayMode::kPUBLIC_KEY) &&
-      !key.IsPrivateKey()) {
+      !is_private_key) {
     return false;
   }
 
-  if (!custom_filter_(key)) return false;
-
-  if (display_mode_ & GpgKeyTableDisplayMode::kFAVORITES) {
-    LOG_D() << "kFAVORITES Mode" << "key id" << key_id << "favorite_key_ids_"
-            << favorite_key_ids_;
+  if (!filter_keywords_.isEmpty() &&
+      !search_matches_.value(source_row, false)) {
+    return false;
   }
+
   if (display_mode_ & GpgKeyTableDisplayMode::kFAVORITES &&
-      !favorite_key_ids_.contains(key_id)) {
+      !favorite_key_ids_.contains(model_->GetKeyIDByRow(source_row))) {
     return false;
   }
 
-  if (filter_keywords_.isEmpty()) return true;
-
-  QStringList infos;
-  for (int column = 0; column < sourceModel()->columnCount(); ++column) {
-    auto index = sourceModel()->index(source_row, column, sourceParent);
-    infos << sourceModel()->data(index).toString();
-
-    const auto uids = key.GetUIDs();
-    for (const auto &uid : *uids) {
-      infos << uid.GetUID();
-    }
+  if (display_mode_ & GpgKeyTableDisplayMode::kUSABLE &&
+      !model_->IsUsableKeyByRow(source_row)) {
+    return false;
   }
 
-  return std::any_of(infos.cbegin(), infos.cend(), [&](const QString &info) {
-    return info.contains(filter_keywords_, Qt::CaseInsensitive);
-  });
-
-  return false;
+  return custom_filter_accepts(source_row);
 }
 
 auto GpgKeyTableProxyModel::filterAcceptsColumn(
@@ -161,6 +141,7 @@ auto GpgKeyTableProxyModel::filterAcceptsColumn(
 
 void GpgKeyTableProxyModel::SetSearchKeywords(const QString &keywords) {
   this->filter_keywords_ = keywords;
+  update_search_matches();
   invalidateFilter();
 }
 
@@ -183,10 +164,46 @@ void GpgKeyTableProxyModel::slot_update_column_type(
 void GpgKeyTableProxyModel::ResetGpgKeyTableModel(
     QSharedPointer<GpgKeyTableModel> model) {
   model_ = std::move(model);
+  custom_filter_results_.clear();
+  update_search_matches();
   slot_update_favorites_cache();
   setSourceModel(model_.get());
 }
 
+void GpgKeyTableProxyModel::update_search_matches() {
+  search_matches_.clear();
+  if (filter_keywords_.isEmpty()) return;
+
+  search_matches_.fill(false, model_->rowCount({}));
+  for (const auto row : model_->SearchRows(filter_keywords_)) {
+    search_matches_[row] = true;
+  }
+}
+
+auto GpgKeyTableProxyModel::custom_filter_accepts(int source_row) const
+    -> bool {
+  if (!custom_filter_) return true;
+
+  // the filter needs the keys, which a snapshot doesn't have, so the list
+  // stays empty until the model of the listed keys replaces it
+  if (model_->IsSnapshot()) return false;
+
+  // the keys don't change within a model, neither do the results
+  const auto row_count = model_->rowCount({});
+  if (custom_filter_results_.size() != row_count) {
+    custom_filter_results_.fill(-1, row_count);
+  }
+
+  auto &result = custom_filter_results_[source_row];
+  if (result < 0) {
+    auto key = GpgKeyGetter::GetInstance(model_->GetGpgContextChannel())
+                   .GetKey(model_->GetKeyIDByRow(source_row));
+    assert(key.IsGood());
+    result = key.IsGood() && custom_filter_(key) ? 1 : 0;
+  }
+  return result == 1;
+}
+
 void GpgKeyTableProxyModel::slot_update_favorites_cache() {
   auto json_data = CacheObject("all_favorite_key_pairs");
   auto cache_obj = AllFavoriteKeyPairsCO(json_data.object());
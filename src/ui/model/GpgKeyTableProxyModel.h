@@ -38,6 +38,12 @@ namespace GpgFrontend::UI {
 class GpgKeyTableProxyModel : public QSortFilterProxyModel {
   Q_OBJECT
  public:
+  /**
+   * @brief decides on the key of a row, an empty one accepts all. While the
+   * model is a key table snapshot no row passes a non-empty filter, the
+   * display mode is decided by the rows only.
+   *
+   */
   using KeyFilter = std::function<bool(const GpgKey &)>;
 
   explicit GpgKeyTableProxyModel(QSharedPointer<GpgKeyTableModel> model,
@@ -97,9 +103,26 @@ class GpgKeyTableProxyModel : public QSortFilterProxyModel {
   QString filter_keywords_;
   QStringList favorite_key_ids_;
   KeyFilter custom_filter_;
+  QContainer<bool> search_matches_;                  ///< by source row
+  mutable QContainer<qint8> custom_filter_results_;  ///< -1 if not known yet
 
   QFont default_font_;
   QFontMetrics default_metrics_;
+
+  /**
+   * @brief look up the rows matching the search keywords in the model
+   *
+   */
+  void update_search_matches();
+
+  /**
+   * @brief run the custom filter on the key of the row once per model
+   *
+   * @param source_row
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto custom_filter_accepts(int source_row) const -> bool;
 };
 
 }  // namespace GpgFrontend::UI
\ No newline at end of file
@@ -31,6 +31,7 @@
 #include "core/utils/AsyncUtils.h"
 #include "core/utils/IOUtils.h"
 #include "ui/UISignalStation.h"
+#include "ui/dialog/WaitingDialog.h"
 #include "ui/function/GpgOperaHelper.h"
 
 namespace GpgFrontend::UI {
@@ -395,28 +396,66 @@ void FileTreeView::slot_show_custom_context_menu(const QPoint& point) {
 }
 
 void FileTreeView::slot_calculate_hash() {
-  if (GetSelectedPaths().empty()) return;
-  auto selected_path = GetSelectedPaths().front();
-
-  GpgOperaHelper::WaitForOpera(
-      this->parentWidget(), tr("Calculating"), [=](const OperaWaitingHd& hd) {
-        RunOperaAsync(
-            [=](const DataObjectPtr& data_object) {
-              data_object->Swap({CalculateHash(selected_path)});
-              return 0;
-            },
-            [hd](int rtn, const DataObjectPtr& data_object) {
-              hd();
-              if (rtn < 0 || !data_object->Check<QString>()) {
-                return;
-              }
-              auto result = ExtractParams<QString>(data_object, 0);
-              emit UISignalStation::GetInstance()
-                  -> SignalRefreshInfoBoard(result,
-                                            InfoBoardStatus::INFO_ERROR_OK);
-            },
-            "calculate_file_hash");
-      });
+  const auto selected_paths = GetSelectedPaths();
+  if (selected_paths.empty()) return;
+
+  qint64 total_size = 0;
+  for (const auto& path : selected_paths) {
+    const QFileInfo info(path);
+    if (info.isFile()) total_size += info.size();
+  }
+
+  QEventLoop looper;
+  QPointer<WaitingDialog> const dialog =
+      new WaitingDialog(tr("Calculating"), total_size > 0, parentWidget());
+  connect(dialog, &QDialog::finished, &looper, &QEventLoop::quit);
+  connect(dialog, &QDialog::finished, dialog, &QDialog::deleteLater);
+
+  // the workers only count the bytes, the dialog polls them
+  auto hashed_bytes = SecureCreateSharedObject<std::atomic<qint64>>(0);
+  QTimer progress_timer;
+  connect(&progress_timer, &QTimer::timeout, dialog, [=]() {
+    if (dialog == nullptr || total_size <= 0) return;
+    emit dialog->SignalUpdateValue(
+        static_cast<int>(hashed_bytes->load() * 100 / total_size));
+  });
+  progress_timer.start(100);
+
+  // every file is hashed on a worker of its own
+  auto results = SecureCreateSharedObject<QStringList>(selected_paths);
+  auto remaining = SecureCreateSharedObject<int>(selected_paths.size());
+  for (int i = 0; i < selected_paths.size(); i++) {
+    const auto path = selected_paths[i];
+
+    RunIOOperaAsync(
+        [=](const DataObjectPtr& data_object) -> GFError {
+          qint64 last_read_bytes = 0;
+          data_object->Swap(
+              {CalculateHash(path, [&](qint64 read_bytes, qint64) {
+                *hashed_bytes += read_bytes - last_read_bytes;
+                last_read_bytes = read_bytes;
+              })});
+          return 0;
+        },
+        [=](GFError err, const DataObjectPtr& data_object) {
+          (*results)[i] = err >= 0 && data_object->Check<QString>()
+                              ? ExtractParams<QString>(data_object, 0)
+                              : QString{};
+
+          if (--(*remaining) == 0 && dialog != nullptr) {
+            dialog->close();
+            dialog->accept();
+          }
+        },
+        "calculate_file_hash");
+  }
+
+  looper.exec();
+  progress_timer.stop();
+
+  if (*remaining != 0) return;
+  emit UISignalStation::GetInstance() -> SignalRefreshInfoBoard(
+      results->join(QString{}), InfoBoardStatus::INFO_ERROR_OK);
 }
 
 void FileTreeView::slot_compress_files() {}
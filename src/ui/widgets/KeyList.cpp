@@ -30,6 +30,7 @@
 
 #include <cstddef>
 
+#include "core/function/CoreSignalStation.h"
 #include "core/function/GlobalSettingStation.h"
 #include "core/function/gpg/GpgKeyGetter.h"
 #include "core/utils/GpgUtils.h"
@@ -71,34 +72,13 @@ void KeyList::init() {
   ui_->switchContextButton->setHidden(~menu_ability_ &
                                       KeyMenuAbility::kKEY_DATABASE);
 
-  auto* gpg_context_menu = new QMenu(this);
-  auto* gpg_context_groups = new QActionGroup(this);
-  gpg_context_groups->setExclusive(true);
-  auto key_db_infos = GetGpgKeyDatabaseInfos();
+  ui_->switchContextButton->setMenu(new QMenu(this));
+  slot_refresh_key_database_menu();
 
-  for (auto& key_db_info : key_db_infos) {
-    auto channel = key_db_info.channel;
-    auto key_db_name = key_db_info.name;
-
-    LOG_D() << "context grt channel: " << channel
-            << "database name: " << key_db_name;
-
-    auto* switch_context_action =
-        new QAction(QString("%1: %2").arg(channel).arg(key_db_name), this);
-    switch_context_action->setCheckable(true);
-    switch_context_action->setChecked(channel == current_gpg_context_channel_);
-    connect(switch_context_action, &QAction::toggled, this,
-            [this, channel](bool checked) {
-              if (checked) {
-                current_gpg_context_channel_ = channel;
-                ui_->channelLcdNumber->display(channel);
-                emit SignalRefreshDatabase();
-              }
-            });
-    gpg_context_groups->addAction(switch_context_action);
-    gpg_context_menu->addAction(switch_context_action);
-  }
-  ui_->switchContextButton->setMenu(gpg_context_menu);
+  // secondary key databases may still be loading
+  connect(CoreSignalStation::GetInstance(),
+          &CoreSignalStation::SignalKeyDatabasesLoaded, this,
+          &KeyList::slot_refresh_key_database_menu);
 
   auto* column_type_menu = new QMenu(this);
 
@@ -225,8 +205,9 @@ void KeyList::init() {
           this, &KeyList::SlotRefreshUI);
 
   // register key database sync signal for refresh button
-  connect(ui_->refreshKeyListButton, &QPushButton::clicked, this,
-          &KeyList::SignalRefreshDatabase);
+  connect(ui_->refreshKeyListButton, &QPushButton::clicked,
+          UISignalStation::GetInstance(),
+          &UISignalStation::SignalKeyDatabaseReload);
 
   connect(ui_->uncheckButton, &QPushButton::clicked, this,
           &KeyList::uncheck_all);
@@ -647,4 +628,37 @@ auto KeyList::GetSelectedGpgKey() -> std::tuple<bool, GpgKey> {
 
   return {true, key};
 }
+void KeyList::slot_refresh_key_database_menu() {
+  auto* gpg_context_menu = ui_->switchContextButton->menu();
+  qDeleteAll(gpg_context_menu->findChildren<QActionGroup*>());
+  gpg_context_menu->clear();
+
+  auto* gpg_context_groups = new QActionGroup(gpg_context_menu);
+  gpg_context_groups->setExclusive(true);
+  auto key_db_infos = GetGpgKeyDatabaseInfos();
+
+  for (auto& key_db_info : key_db_infos) {
+    auto channel = key_db_info.channel;
+    auto key_db_name = key_db_info.name;
+
+    LOG_D() << "context grt channel: " << channel
+            << "database name: " << key_db_name;
+
+    auto* switch_context_action = new QAction(
+        QString("%1: %2").arg(channel).arg(key_db_name), gpg_context_menu);
+    switch_context_action->setCheckable(true);
+    switch_context_action->setChecked(channel == current_gpg_context_channel_);
+    connect(switch_context_action, &QAction::toggled, this,
+            [this, channel](bool checked) {
+              if (checked) {
+                current_gpg_context_channel_ = channel;
+                ui_->channelLcdNumber->display(channel);
+                emit SignalRefreshDatabase();
+              }
+            });
+    gpg_context_groups->addAction(switch_context_action);
+    gpg_context_menu->addAction(switch_context_action);
+  }
+}
+
 }  // namespace GpgFrontend::UI
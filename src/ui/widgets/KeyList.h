@@ -104,8 +104,7 @@ class KeyList : public QWidget {
       const QString& name, const QString& id,
       GpgKeyTableDisplayMode display_mode =
           GpgKeyTableDisplayMode::kPRIVATE_KEY,
-      GpgKeyTableProxyModel::KeyFilter search_filter =
-          [](const GpgKey&) -> bool { return true; },
+      GpgKeyTableProxyModel::KeyFilter search_filter = nullptr,
       GpgKeyTableColumn custom_columns_filter = GpgKeyTableColumn::kALL);
 
   /**
@@ -314,6 +313,12 @@ class KeyList : public QWidget {
    */
   void slot_sync_with_key_server();
 
+  /**
+   * @brief rebuild the menu switching between the key databases
+   *
+   */
+  void slot_refresh_key_database_menu();
+
  protected:
   /**
    * @brief
@@ -54,9 +54,7 @@ struct KeyTable : public QTableView {
   KeyTable(
       QWidget* parent, QSharedPointer<GpgKeyTableModel> model,
       GpgKeyTableDisplayMode _select_type, GpgKeyTableColumn _info_type,
-      GpgKeyTableProxyModel::KeyFilter _filter = [](const GpgKey&) -> bool {
-        return true;
-      });
+      GpgKeyTableProxyModel::KeyFilter _filter = nullptr);
 
   /**
    * @brief
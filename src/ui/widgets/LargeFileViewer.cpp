@@ -0,0 +1,91 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "LargeFileViewer.h"
+
+namespace GpgFrontend::UI {
+
+namespace {
+
+// lines longer than that are clipped, a single line of a binary file may
+// otherwise be as long as the file
+constexpr qint64 kMaxPaintedLineLength = 4096;
+
+}  // namespace
+
+LargeFileViewer::LargeFileViewer(std::shared_ptr<GFMappedFile> file,
+                                 QWidget* parent)
+    : QAbstractScrollArea(parent), file_(std::move(file)) {
+  setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+  setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+  viewport()->setBackgroundRole(QPalette::Base);
+  viewport()->setAutoFillBackground(true);
+  SlotUpdateLineCount();
+}
+
+void LargeFileViewer::SlotUpdateLineCount() {
+  auto lines = file_ != nullptr ? file_->LineCount() : 0;
+  auto max = std::max<qint64>(0, lines - visible_line_count());
+
+  verticalScrollBar()->setRange(
+      0, static_cast<int>(std::min<qint64>(max, INT_MAX)));
+  verticalScrollBar()->setPageStep(visible_line_count());
+  viewport()->update();
+}
+
+void LargeFileViewer::paintEvent(QPaintEvent* /*event*/) {
+  if (file_ == nullptr) return;
+
+  QPainter painter(viewport());
+  painter.setFont(font());
+  painter.setPen(palette().color(QPalette::Text));
+
+  const auto metrics = fontMetrics();
+  const auto line_height = metrics.lineSpacing();
+  const auto first = static_cast<qint64>(verticalScrollBar()->value());
+  const auto last =
+      std::min<qint64>(file_->LineCount(), first + visible_line_count() + 1);
+
+  auto y = metrics.ascent();
+  for (auto i = first; i < last; i++) {
+    auto line = file_->Line(i).left(kMaxPaintedLineLength);
+    painter.drawText(4, y, QString::fromUtf8(line));
+    y += line_height;
+  }
+}
+
+void LargeFileViewer::resizeEvent(QResizeEvent* event) {
+  QAbstractScrollArea::resizeEvent(event);
+  SlotUpdateLineCount();
+}
+
+auto LargeFileViewer::visible_line_count() const -> int {
+  return std::max(1, viewport()->height() / fontMetrics().lineSpacing());
+}
+
+}  // namespace GpgFrontend::UI
@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include "core/model/GFMappedFile.h"
+
+namespace GpgFrontend::UI {
+
+/**
+ * @brief A read only view of a mapped file, which only lays out and paints
+ * the lines currently visible, so that its cost does not grow with the size
+ * of the file.
+ *
+ */
+class LargeFileViewer : public QAbstractScrollArea {
+  Q_OBJECT
+ public:
+  /**
+   * @brief Construct a new Large File Viewer object
+   *
+   * @param file the mapped file
+   * @param parent
+   */
+  explicit LargeFileViewer(std::shared_ptr<GFMappedFile> file,
+                           QWidget* parent = nullptr);
+
+ public slots:
+
+  /**
+   * @brief update the scroll range after more lines are indexed
+   *
+   */
+  void SlotUpdateLineCount();
+
+ protected:
+  /**
+   * @brief paint the visible lines
+   *
+   * @param event
+   */
+  void paintEvent(QPaintEvent* event) override;
+
+  /**
+   * @brief update the page step of the scroll bar
+   *
+   * @param event
+   */
+  void resizeEvent(QResizeEvent* event) override;
+
+ private:
+  std::shared_ptr<GFMappedFile> file_;  ///<
+
+  /**
+   * @brief count of the lines fitting into the viewport
+   *
+   * @return int
+   */
+  [[nodiscard]] auto visible_line_count() const -> int;
+};
+
+}  // namespace GpgFrontend::UI
@@ -31,11 +31,21 @@
 #include "core/model/SettingsObject.h"
 #include "core/thread/FileReadTask.h"
 #include "core/thread/TaskRunnerGetter.h"
+#include "core/utils/AsyncUtils.h"
 #include "ui/struct/settings_object/AppearanceSO.h"
+#include "ui/widgets/LargeFileViewer.h"
 #include "ui_PlainTextEditor.h"
 
 namespace GpgFrontend::UI {
 
+namespace {
+
+// files of at least this size are mapped and viewed read only instead of
+// being loaded into the text editor
+constexpr qint64 kLargeFileSize = 4 * 1024 * 1024;
+
+}  // namespace
+
 PlainTextEditorPage::PlainTextEditorPage(QString file_path, QWidget *parent)
     : QWidget(parent),
       ui_(GpgFrontend::SecureCreateSharedObject<Ui_PlainTextEditor>()),
@@ -62,8 +72,9 @@ PlainTextEditorPage::PlainTextEditorPage(QString file_path, QWidget *parent)
     // if file is loading
     if (!read_done_) return;
 
-    auto text = ui_->textPage->document()->toPlainText();
-    auto str = tr("%1 character(s)").arg(text.size());
+    // the document keeps a trailing paragraph separator
+    auto count = ui_->textPage->document()->characterCount() - 1;
+    auto str = tr("%1 character(s)").arg(count);
     this->ui_->characterLabel->setText(str);
   });
 
@@ -77,6 +88,10 @@ PlainTextEditorPage::PlainTextEditorPage(QString file_path, QWidget *parent)
   }
 }
 
+PlainTextEditorPage::~PlainTextEditorPage() {
+  if (cancel_indexing_ != nullptr) *cancel_indexing_ = true;
+}
+
 const QString &PlainTextEditorPage::GetFilePath() const {
   return full_file_path_;
 }
@@ -89,6 +104,29 @@ auto PlainTextEditorPage::GetPlainText() -> QString {
   return ui_->textPage->toPlainText();
 }
 
+auto PlainTextEditorPage::IsLargeFile() const -> bool {
+  return mapped_file_ != nullptr;
+}
+
+auto PlainTextEditorPage::GetMappedFile() const
+    -> std::shared_ptr<GFMappedFile> {
+  return mapped_file_;
+}
+
+auto PlainTextEditorPage::GetBuffer() -> GFBuffer {
+  if (!IsLargeFile()) return GFBuffer(GetPlainText());
+  return GFMappedFile::GetBuffer(mapped_file_, 0, mapped_file_->Size());
+}
+
+auto PlainTextEditorPage::GetArmorBuffer() -> GFBuffer {
+  if (!IsLargeFile()) return GFBuffer(GetPlainText());
+
+  auto blocks = mapped_file_->FindArmorBlocks();
+  if (blocks.isEmpty()) return GetBuffer();
+  return GFMappedFile::GetBuffer(mapped_file_, blocks.front().begin,
+                                blocks.front().end);
+}
+
 void PlainTextEditorPage::NotifyFileSaved() {
   this->is_crlf_ = false;
 
@@ -151,6 +189,11 @@ void PlainTextEditorPage::ReadFile() {
   read_done_ = false;
   read_bytes_ = 0;
 
+  if (QFileInfo(full_file_path_).size() >= kLargeFileSize &&
+      read_large_file()) {
+    return;
+  }
+
   auto *text_page = this->GetTextPage();
   text_page->setEnabled(false);
   text_page->setReadOnly(true);
@@ -186,6 +229,56 @@ void PlainTextEditorPage::ReadFile() {
   task_runner->PostTask(read_task);
 }
 
+auto PlainTextEditorPage::read_large_file() -> bool {
+  auto mapped_file = SecureCreateSharedObject<GFMappedFile>(full_file_path_);
+  if (!mapped_file->IsMapped()) return false;
+
+  mapped_file_ = mapped_file;
+  large_file_viewer_ = new LargeFileViewer(mapped_file_, this);
+  large_file_viewer_->setFont(ui_->textPage->font());
+  ui_->textPage->setHidden(true);
+  ui_->verticalLayout->insertWidget(0, large_file_viewer_);
+
+  ui_->characterLabel->setText(tr("%1 byte(s)").arg(mapped_file_->Size()));
+  ui_->loadingLabel->setText(tr("Indexing lines..."));
+  ui_->loadingLabel->setHidden(false);
+
+  // show the lines indexed so far while the indexing goes on
+  auto *timer = new QTimer(this);
+  connect(timer, &QTimer::timeout, large_file_viewer_,
+          &LargeFileViewer::SlotUpdateLineCount);
+  timer->start(100);
+
+  cancel_indexing_ = SecureCreateSharedObject<std::atomic<bool>>(false);
+  auto cancel = cancel_indexing_;
+  QPointer<PlainTextEditorPage> self(this);
+
+  RunIOOperaAsync(
+      [=](const DataObjectPtr &) -> GFError {
+        return mapped_file->BuildLineIndex(
+                   [=](qint64) { return !cancel->load(); })
+                   ? 0
+                   : -1;
+      },
+      [=](GFError err, const DataObjectPtr &) {
+        if (self == nullptr) return;
+
+        timer->stop();
+        timer->deleteLater();
+        large_file_viewer_->SlotUpdateLineCount();
+
+        read_done_ = true;
+        ui_->loadingLabel->setHidden(true);
+        if (err >= 0) {
+          ui_->characterLabel->setText(
+              tr("%1 line(s)").arg(mapped_file->LineCount()));
+        }
+      },
+      "index_large_file_lines");
+
+  return true;
+}
+
 auto BinaryToString(const QByteArray &source) -> QString {
   static const char kSyms[] = "0123456789ABCDEF";
   QString buffer;
@@ -219,10 +312,10 @@ void PlainTextEditorPage::slot_insert_text(QByteArray bytes_data) {
 
   // insert the text to the text page
   this->ui_->textPage->insertPlainText(bytes_data);
-  this->ui_->characterLabel->setText(
-      tr("%1 character(s)").arg(this->GetTextPage()->toPlainText().size()));
+  this->ui_->characterLabel->setText(tr("%1 character(s)").arg(
+      this->GetTextPage()->document()->characterCount() - 1));
 
-  QTimer::singleShot(25, this, &PlainTextEditorPage::SignalUIBytesDisplayed);
+  QTimer::singleShot(0, this, &PlainTextEditorPage::SignalUIBytesDisplayed);
 }
 
 }  // namespace GpgFrontend::UI
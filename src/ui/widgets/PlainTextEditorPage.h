@@ -28,10 +28,15 @@
 
 #pragma once
 
+#include "core/model/GFBuffer.h"
+#include "core/model/GFMappedFile.h"
+
 class Ui_PlainTextEditor;
 
 namespace GpgFrontend::UI {
 
+class LargeFileViewer;
+
 /**
  * @brief Class for handling a single tab of the tabwidget
  *
@@ -48,6 +53,13 @@ class PlainTextEditorPage : public QWidget {
   explicit PlainTextEditorPage(QString file_path = {},
                                QWidget* parent = nullptr);
 
+  /**
+   * @brief Destroy the Plain Text Editor Page object, stops the indexing of
+   * a large file
+   *
+   */
+  ~PlainTextEditorPage() override;
+
   /**
    * @details Get the filepath of the currently activated tab.
    */
@@ -72,6 +84,37 @@ class PlainTextEditorPage : public QWidget {
    */
   auto GetPlainText() -> QString;
 
+  /**
+   * @brief whether the file is too large for the text editor and is shown
+   * read only from a mapping of it
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto IsLargeFile() const -> bool;
+
+  /**
+   * @brief the mapped file, if it is a large one
+   *
+   * @return std::shared_ptr<GFMappedFile>
+   */
+  [[nodiscard]] auto GetMappedFile() const -> std::shared_ptr<GFMappedFile>;
+
+  /**
+   * @brief the content of this page, not copied if it is a large file
+   *
+   * @return GFBuffer
+   */
+  auto GetBuffer() -> GFBuffer;
+
+  /**
+   * @brief the content of this page, or the first ascii armored block of a
+   * large file
+   *
+   * @return GFBuffer
+   */
+  auto GetArmorBuffer() -> GFBuffer;
+
   /**
    * @details Show additional widget at buttom of currently active tab
    *
@@ -125,6 +168,17 @@ class PlainTextEditorPage : public QWidget {
   size_t read_bytes_ = 0;   ///<
   bool is_crlf_ = false;    ///<
   bool last_insert_has_partial_cr_ = false;
+  std::shared_ptr<GFMappedFile> mapped_file_;  ///< set for large files
+  LargeFileViewer* large_file_viewer_ = nullptr;         ///<
+  std::shared_ptr<std::atomic<bool>> cancel_indexing_;  ///<
+
+  /**
+   * @brief map the file and index its lines in the background instead of
+   * loading it into the text editor
+   *
+   * @return true if the file is mapped
+   */
+  auto read_large_file() -> bool;
 
  private slots:
 
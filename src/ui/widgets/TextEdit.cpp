@@ -160,6 +160,16 @@ auto TextEdit::saveFile(const QString& file_name) -> bool {
   PlainTextEditorPage* page = CurPageTextEdit();
   if (page == nullptr) return false;
 
+  // a large file is viewed read only and its text page is empty, so only
+  // the mapped bytes may be written, never over the mapped file itself
+  if (page->IsLargeFile()) {
+    if (page->GetMappedFile()->CopyTo(file_name)) return true;
+
+    QMessageBox::warning(this, tr("Warning"),
+                         tr("Cannot write file %1.").arg(file_name));
+    return false;
+  }
+
   QFile file(file_name);
   if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
     QTextStream output_stream(&file);
@@ -434,6 +444,11 @@ void TextEdit::SlotQuote() const {
 }
 
 void TextEdit::SlotFillTextEditWithText(const QString& text) const {
+  // a large file is shown read only, the text goes to a tab of its own
+  if (CurTextPage() == nullptr || CurTextPage()->IsLargeFile()) {
+    tab_widget_->SlotNewTab();
+  }
+
   QTextCursor cursor(CurTextPage()->GetTextPage()->document());
   cursor.beginEditBlock();
   this->CurTextPage()->GetTextPage()->selectAll();
@@ -620,6 +635,18 @@ auto TextEdit::CurPlainText() const -> QString {
   return plain_text_tab->GetPlainText();
 }
 
+auto TextEdit::CurBuffer() const -> GFBuffer {
+  auto* plain_text_tab = CurTextPage();
+  if (plain_text_tab == nullptr) return {};
+  return plain_text_tab->GetBuffer();
+}
+
+auto TextEdit::CurArmorBuffer() const -> GFBuffer {
+  auto* plain_text_tab = CurTextPage();
+  if (plain_text_tab == nullptr) return {};
+  return plain_text_tab->GetArmorBuffer();
+}
+
 auto TextEdit::TabWidget() const -> QTabWidget* { return tab_widget_; }
 
 auto TextEdit::CurEMailPage() const -> EMailEditorPage* {
@@ -102,6 +102,20 @@ class TextEdit : public QWidget {
    */
   [[nodiscard]] auto CurPlainText() const -> QString;
 
+  /**
+   * @details content of the currently activated tab, which is not copied if
+   * it is a large file
+   * @return GFBuffer
+   */
+  [[nodiscard]] auto CurBuffer() const -> GFBuffer;
+
+  /**
+   * @details content of the currently activated tab, or the first ascii
+   * armored block if it is a large file
+   * @return GFBuffer
+   */
+  [[nodiscard]] auto CurArmorBuffer() const -> GFBuffer;
+
   /**
    * @brief
    *
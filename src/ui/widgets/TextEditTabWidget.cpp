@@ -28,6 +28,7 @@
 
 #include "TextEditTabWidget.h"
 
+#include "core/function/CacheManager.h"
 #include "core/function/GlobalSettingStation.h"
 #include "core/model/CacheObject.h"
 #include "ui/UISignalStation.h"
@@ -39,6 +40,9 @@ namespace GpgFrontend::UI {
 
 TextEditTabWidget::TextEditTabWidget(QWidget* parent) : QTabWidget(parent) {
   setAcceptDrops(true);
+
+  // updated at every change of the pages
+  CacheManager::GetInstance().SetDurableCacheJournal("editor_unsaved_pages");
 }
 
 void TextEditTabWidget::dragEnterEvent(QDragEnterEvent* event) {